@@ -56,7 +56,8 @@ typedef struct OVVCHdl
 
 static int dmx_attach_file(OVVCHdl *const vvc_hdl, const char *const input_file_name);
 
-static int init_openvvc_hdl(OVVCHdl *const ovvc_hdl, const char *output_file_name, int nb_frame_th, int nb_entry_th, int upscale_flag);
+static int init_openvvc_hdl(OVVCHdl *const ovvc_hdl, const char *output_file_name, int nb_frame_th, int nb_entry_th, int upscale_flag, int affinity,
+                            int luma_only);
 
 static int close_openvvc_hdl(OVVCHdl *const ovvc_hdl);
 
@@ -81,6 +82,8 @@ main(int argc, char** argv)
     int nb_frame_th = 0;
     int nb_entry_th = 0;
     int upscale_flag = 0;
+    int affinity = 0;
+    int luma_only = 0;
 
     uint8_t options_flag=0;
 
@@ -99,11 +102,13 @@ main(int argc, char** argv)
             {"framethr",  required_argument, 0, 't'},
             {"entrythr",  required_argument, 0, 'e'},
             {"upscale",   required_argument, 0, 'u'},
+            {"affinity",  no_argument,       0, 'a'},
+            {"luma-only", no_argument,       0, 'y'},
         };
 
         int option_index = 0;
 
-        c = getopt_long(argc, argv, "vhl:i:o:t:e:u:", long_options,
+        c = getopt_long(argc, argv, "vhl:i:o:t:e:u:ay", long_options,
                         &option_index);
         if (c == -1){
             break;
@@ -137,6 +142,14 @@ main(int argc, char** argv)
                 upscale_flag = atoi(optarg);
                 break;
 
+            case 'a':
+                affinity = 1;
+                break;
+
+            case 'y':
+                luma_only = 1;
+                break;
+
             case 't':
                 nb_frame_th = atoi(optarg);
                 break;
@@ -187,7 +200,8 @@ main(int argc, char** argv)
         ov_log(NULL, OVLOG_INFO, "Decoded stream will be written to '%s'.\n", output_file_name);
     }
 
-    ret = init_openvvc_hdl(&ovvc_hdl, output_file_name, nb_frame_th, nb_entry_th, upscale_flag);
+    ret = init_openvvc_hdl(&ovvc_hdl, output_file_name, nb_frame_th, nb_entry_th, upscale_flag, affinity,
+                           luma_only);
 
     if (ret < 0) goto failinit;
 
@@ -227,7 +241,8 @@ dmx_attach_file(OVVCHdl *const vvc_hdl, const char *const input_file_name)
 }
 
 static int
-init_openvvc_hdl(OVVCHdl *const ovvc_hdl, const char *output_file_name, int nb_frame_th, int nb_entry_th, int upscale_flag)
+init_openvvc_hdl(OVVCHdl *const ovvc_hdl, const char *output_file_name, int nb_frame_th, int nb_entry_th, int upscale_flag, int affinity,
+                 int luma_only)
 {
     OVVCDec **vvcdec = &ovvc_hdl->dec;
     OVVCDmx **vvcdmx = &ovvc_hdl->dmx;
@@ -241,6 +256,10 @@ init_openvvc_hdl(OVVCHdl *const ovvc_hdl, const char *output_file_name, int nb_f
 
     ovdec_set_option(*vvcdec, OVDEC_RPR_UPSCALE, upscale_flag);
 
+    ovdec_set_option(*vvcdec, OVDEC_THREAD_AFFINITY, affinity);
+
+    ovdec_set_option(*vvcdec, OVDEC_LUMA_ONLY, luma_only);
+
     ret = ovdec_start(*vvcdec);
 
     if (ret < 0) goto failstart;
@@ -374,13 +393,16 @@ write_decoded_frame_to_file(OVFrame *const frame, FILE *out_file)
     uint8_t component = 0;
     int ret = 0;
     struct Window output_window = frame->output_window;
-    int bd_shift = (frame->frame_info.chroma_format == OV_YUV_420_P8) ? 0: 1;
+    int bd_shift = (frame->frame_info.chroma_format == OV_YUV_420_P8 ||
+                    frame->frame_info.chroma_format == OV_YUV_400_P8) ? 0: 1;
+    /* Luma only frames have no chroma planes */
+    uint8_t nb_comp = frame->data[1] ? 3 : 1;
 
     uint16_t add_w = (output_window.offset_lft + output_window.offset_rgt);
     uint16_t add_h = (output_window.offset_abv + output_window.offset_blw);
 
     if (add_w || add_h || frame->width < (frame->linesize[0] >> bd_shift)) {
-        for (component = 0; component < 3; component++) {
+        for (component = 0; component < nb_comp; component++) {
             uint16_t comp_w = component ? add_w : add_w << 1;
             uint16_t comp_h = component ? add_h : add_h << 1;
             uint16_t win_left  =  component ? output_window.offset_lft : output_window.offset_lft << 1;
@@ -402,8 +424,10 @@ write_decoded_frame_to_file(OVFrame *const frame, FILE *out_file)
         const uint8_t *data_cb = (uint8_t*)frame->data[1];
         const uint8_t *data_cr = (uint8_t*)frame->data[2];
         ret += fwrite(data, frame->size[0], sizeof(uint8_t), out_file);
-        ret += fwrite(data_cb, frame->size[1], sizeof(uint8_t), out_file);
-        ret += fwrite(data_cr, frame->size[2], sizeof(uint8_t), out_file);
+        if (nb_comp > 1) {
+            ret += fwrite(data_cb, frame->size[1], sizeof(uint8_t), out_file);
+            ret += fwrite(data_cr, frame->size[2], sizeof(uint8_t), out_file);
+        }
     }
 
     return ret;
@@ -424,4 +448,6 @@ static void print_usage(){
   printf("\t-o <file>, --outfile=<file>\t\tPath to the output file (Default: test.yuv).\n");
   printf("\t-t <nbthreads>, --framethr=<nbthreads>\t\tNumber of simultaneous frames decoded (Default: 0).\n");
   printf("\t-e <nbthreads>, --entrythr=<nbthreads>\t\tNumber of simultaneous entries decoded per frame (Default: 0).\n");
+  printf("\t-a, --affinity\t\t\t\tPin decoding threads on CPUs.\n");
+  printf("\t-y, --luma-only\t\t\t\tOnly decode and output the luma component.\n");
 }
@@ -36,12 +36,53 @@
 #include "ovutils.h"
 #include "vcl_cabac.h"
 
-#define NB_CABAC_BITS 16
-#define CABAC_MASK ((1 << NB_CABAC_BITS) - 1)
+/* Number of bits loaded into the 64 bits low window on refill
+ * The arithmetic decoder value is kept above those bits
+ */
+#define NB_CABAC_BITS 32
+#define CABAC_MASK ((UINT64_C(1) << NB_CABAC_BITS) - 1)
+
+/* Maximum number of bins read by a single ovcabac_bypass_read_n() call */
+#define CABAC_MAX_BYPASS_N 20
 
 extern const uint8_t lps_renorm_table[64];
 extern const uint8_t range_lps_lut[512];
 
+static inline uint32_t
+ovcabac_load_bytes(const uint8_t *bytestream)
+{
+    return ((uint32_t)bytestream[0] << 24) | ((uint32_t)bytestream[1] << 16) |
+           ((uint32_t)bytestream[2] <<  8) |  (uint32_t)bytestream[3];
+}
+
+/* Refill low window with NB_CABAC_BITS new bits once all
+ * previously loaded bits were consumed.
+ * num_bits is the number of bits consumed past the last
+ * loaded bit.
+ */
+static inline void
+ovcabac_refill(OVCABACCtx *const cabac_ctx, int num_bits)
+{
+    uint64_t tmp_fill = -CABAC_MASK;
+
+    tmp_fill += (uint64_t)ovcabac_load_bytes(cabac_ctx->bytestream) << 1;
+
+    cabac_ctx->low_b += tmp_fill << num_bits;
+
+    /* Last refill will try to read bits past the end of the entry
+     * if the last read occurs on the bit just before alignment.
+     * Position in bytestream is kept at most two bytes after the
+     * end of the entry so reads stay in the padding of the RBSP
+     * buffer. This permits to check for an error at the end
+     * of each CTU line based on the position in the entry.
+     */
+    if (cabac_ctx->bytestream + (NB_CABAC_BITS >> 3) <= cabac_ctx->bytestream_end + 2) {
+        cabac_ctx->bytestream += NB_CABAC_BITS >> 3;
+    } else {
+        cabac_ctx->bytestream = cabac_ctx->bytestream_end + 2;
+    }
+}
+
 static inline uint8_t
 ovcabac_ae_read(OVCABACCtx *const cabac_ctx, uint64_t *const cabac_state)
 {
@@ -52,7 +93,7 @@ ovcabac_ae_read(OVCABACCtx *const cabac_ctx, uint64_t *const cabac_state)
     int8_t state = (state_0 + state_1) >> 8;
     uint16_t symbol_mask;
     uint32_t range_lps;
-    int32_t lps_mask;
+    int64_t lps_mask;
     int log2_renorm;
 
     symbol_mask = (int16_t)state >> 7;
@@ -65,8 +106,8 @@ ovcabac_ae_read(OVCABACCtx *const cabac_ctx, uint64_t *const cabac_state)
     #endif
     cabac_ctx->range -= range_lps;
 
-    lps_mask   = (cabac_ctx->range << (NB_CABAC_BITS + 1)) - cabac_ctx->low_b - 1;
-    lps_mask >>= 31;
+    lps_mask   = ((uint64_t)cabac_ctx->range << (NB_CABAC_BITS + 1)) - cabac_ctx->low_b - 1;
+    lps_mask >>= 63;
 
     symbol_mask ^= lps_mask;
 
@@ -79,7 +120,7 @@ ovcabac_ae_read(OVCABACCtx *const cabac_ctx, uint64_t *const cabac_state)
     *cabac_state |= (uint64_t)state_0 << 48;
     *cabac_state |= (uint64_t)state_1 << 32;
 
-    cabac_ctx->low_b -= (cabac_ctx->range << (NB_CABAC_BITS + 1)) & (lps_mask);
+    cabac_ctx->low_b -= ((uint64_t)cabac_ctx->range << (NB_CABAC_BITS + 1)) & (lps_mask);
     cabac_ctx->range += (range_lps - cabac_ctx->range)         & (lps_mask);
 
     log2_renorm = lps_renorm_table[cabac_ctx->range >> 3];
@@ -88,73 +129,70 @@ ovcabac_ae_read(OVCABACCtx *const cabac_ctx, uint64_t *const cabac_state)
     cabac_ctx->range <<= log2_renorm;
 
     if (!(cabac_ctx->low_b & CABAC_MASK)){
-        int num_bits = ov_ctz(cabac_ctx->low_b) - NB_CABAC_BITS;
-        uint32_t tmp_fill = -CABAC_MASK;
-
-        tmp_fill += cabac_ctx->bytestream[0] << 9;
-        tmp_fill += cabac_ctx->bytestream[1] << 1;
-
-        cabac_ctx->low_b += tmp_fill << num_bits;
-
-        /* Last read will try to refill CABAC if last read occurs on
-         * the bit just before alignment we will refill the CABAC
-         * even if it was the last bit to be read in the entry
-         * This is why we use <= instead of <.
-         * Doing so permits to check for an error at the end
-         * of each CTU line based on the position in the entry
-         * Note that we can also check at the end of the entry
-         * everything has been consumed.
-         */
-        if (cabac_ctx->bytestream <= cabac_ctx->bytestream_end){
-            cabac_ctx->bytestream += NB_CABAC_BITS >> 3;
-        } else {
-            /* FIXME this permits to check if we needed to refill
-             *  after end of entry
-             */
-#if 1
-            cabac_ctx->bytestream = cabac_ctx->bytestream_end + 2;
-            //printf("CABAC_EMPTY\n");
-#endif
-        }
+        int num_bits = ov_ctz64(cabac_ctx->low_b) - NB_CABAC_BITS;
+        ovcabac_refill(cabac_ctx, num_bits);
     }
+
     return symbol_mask & 0x1;
 }
 
 static inline uint8_t
 ovcabac_bypass_read(OVCABACCtx *const cabac_ctx)
 {
-  int32_t range, lps_mask;
+  uint64_t range;
+  int64_t lps_mask;
 
   cabac_ctx->low_b <<= 1;
 
   if (!(cabac_ctx->low_b & CABAC_MASK)){
-      int num_bits = 0;
-      uint32_t tmp_fill = -CABAC_MASK;
-      tmp_fill += cabac_ctx->bytestream[0] << 9;
-      tmp_fill += cabac_ctx->bytestream[1] << 1;
-      cabac_ctx->low_b += tmp_fill << num_bits;
-      if (cabac_ctx->bytestream <= cabac_ctx->bytestream_end){
-          cabac_ctx->bytestream += NB_CABAC_BITS >> 3;
-      } else {
-          /* FIXME this permits to check if we needed to refill
-           *  after end of entry
-           */
-#if 1
-          cabac_ctx->bytestream = cabac_ctx->bytestream_end + 2;
-          //printf("CABAC_EMPTY\n");
-#endif
-      }
+      ovcabac_refill(cabac_ctx, 0);
   }
 
-  range = cabac_ctx->range << (NB_CABAC_BITS + 1);
+  range = (uint64_t)cabac_ctx->range << (NB_CABAC_BITS + 1);
 
   lps_mask = range - cabac_ctx->low_b - 1;
-  lps_mask >>= 31;
+  lps_mask >>= 63;
 
   cabac_ctx->low_b -= range & lps_mask;
 
   return lps_mask & 0x1;
 }
+
+/* Read nb_bins bypass bins at once, first bin read is returned
+ * as MSB.
+ * Low window is shifted once by nb_bins and bins are extracted
+ * by comparing it against the range scaled to each bin position.
+ * nb_bins must not exceed CABAC_MAX_BYPASS_N.
+ */
+static inline uint32_t
+ovcabac_bypass_read_n(OVCABACCtx *const cabac_ctx, int nb_bins)
+{
+    uint64_t range = (uint64_t)cabac_ctx->range << (NB_CABAC_BITS + 1 + nb_bins);
+    uint32_t bins = 0;
+    int i;
+
+    cabac_ctx->low_b <<= nb_bins;
+
+    if (!(cabac_ctx->low_b & CABAC_MASK)){
+        int num_bits = ov_ctz64(cabac_ctx->low_b) - NB_CABAC_BITS;
+        ovcabac_refill(cabac_ctx, num_bits);
+    }
+
+    for (i = 0; i < nb_bins; ++i) {
+        int64_t lps_mask;
+
+        range >>= 1;
+
+        lps_mask = range - cabac_ctx->low_b - 1;
+        lps_mask >>= 63;
+
+        cabac_ctx->low_b -= range & lps_mask;
+
+        bins = (bins << 1) | (lps_mask & 0x1);
+    }
+
+    return bins;
+}
 #endif
 
 
@@ -203,10 +241,7 @@ vvc_get_cabac_truncated(OVCABACCtx *const cabac_ctx, unsigned int max_symbol){
     int val = 1 << threshold;
     int b = max_symbol - val;
 
-    while(threshold--){
-        ruiSymbol <<= 1;
-        ruiSymbol |= ovcabac_bypass_read(cabac_ctx);
-    }
+    ruiSymbol = ovcabac_bypass_read_n(cabac_ctx, threshold);
 
     if( ruiSymbol >= val - b ){
         uint32_t uiSymbol;
@@ -100,11 +100,25 @@ ctudec_init_in_loop_filters(OVCTUDec *const ctudec, const OVPS *const prms)
     int nb_ctb_pic_w = (pic_w + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
     int nb_ctb_pic_h = (pic_h + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
 
+    /* CTU parameters are reallocated on first use if a new
+     * SPS requires more CTUs than previously allocated
+     */
+    if (nb_ctb_pic_w * nb_ctb_pic_h > ctudec->nb_ctb_ilf_params) {
+        ov_freep(&ctudec->sao_info.sao_params);
+        ov_freep(&ctudec->alf_info.ctb_alf_params);
+        ov_freep(&ctudec->alf_info.ctb_cc_alf_filter_idx[0]);
+        ov_freep(&ctudec->alf_info.ctb_cc_alf_filter_idx[1]);
+        ctudec->nb_ctb_ilf_params = nb_ctb_pic_w * nb_ctb_pic_h;
+    }
+
     //Init SAO info and ctu params
     struct SAOInfo* sao_info  = &ctudec->sao_info;
     sao_info->sao_luma_flag   =  sh->sh_sao_luma_used_flag;
     sao_info->sao_chroma_flag =  sh->sh_sao_chroma_used_flag;
-    sao_info->chroma_format_idc = sps->sps_chroma_format_idc;
+    /* Chroma SAO syntax is parsed according to sao_chroma_flag in luma
+     * only mode, a zero chroma_format_idc only skips chroma SAO filtering
+     */
+    sao_info->chroma_format_idc = ctudec->rcn_ctx.luma_only ? 0 : sps->sps_chroma_format_idc;
     if(sao_info->sao_luma_flag || sao_info->sao_chroma_flag){
         if(!sao_info->sao_params){
             sao_info->sao_params = ov_mallocz(sizeof(SAOParamsCtu) * nb_ctb_pic_w * nb_ctb_pic_h);
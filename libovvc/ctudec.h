@@ -288,6 +288,18 @@ struct OVMV
     uint8_t prec_amvr;
 };
 
+/* Collocated MV stored on 8x8 luma blocks for TMVP
+ * MV components are stored in the mantissa / exponent
+ * representation ((mantissa << 4) | exponent) so they
+ * fit on 16 bits
+ */
+struct TMVPMV
+{
+    int16_t x;
+    int16_t y;
+    int8_t ref_idx;
+};
+
 typedef struct VVCMergeInfo
 {
     OVMV mv0;
@@ -452,8 +464,8 @@ struct InterDRVCtx
         const struct MVPlane *col_plane1;
         uint16_t pln0_stride;
         uint16_t pln1_stride;
-        const OVMV *ctb_mv0;
-        const OVMV *ctb_mv1;
+        const struct TMVPMV *ctb_mv0;
+        const struct TMVPMV *ctb_mv1;
 
         uint8_t col_ref_l0;
         uint8_t ldc;
@@ -475,8 +487,8 @@ struct InterDRVCtx
         uint64_t dir_map_v0[34];
         uint64_t dir_map_v1[34];
 
-        OVMV mvs0[16*17];
-        OVMV mvs1[16*17];
+        struct TMVPMV mvs0[16*17];
+        struct TMVPMV mvs1[16*17];
 
         uint8_t ctu_w;
         uint8_t ctu_h;
@@ -634,6 +646,12 @@ struct OVCTUDec
         } filter_buffers;
 
         const struct Frame *frame_start;
+
+        /* Chroma components are neither reconstructed nor written
+         * to the frame which has no chroma planes
+         */
+        uint8_t luma_only;
+
         /* Bit fields corresponding to the decoding progress in
          * current CTU, and its borders those are used for example
          * in order to derive references samples for intra prediction
@@ -840,7 +858,20 @@ struct OVCTUDec
     uint16_t ctb_x;
     uint16_t ctb_y;
     uint16_t nb_ctb_pic_w;
+
+    /* Coding information exported with the current picture
+     * NULL if side data export is disabled
+     */
+    struct OVFrameSideData *side_data;
+
     uint16_t prev_nb_ctu_w_rect_entry;
+    uint8_t prev_log2_ctb_s;
+    uint8_t prev_bitdepth_minus8;
+
+    /* Number of CTUs in-loop filters CTU parameters were
+     * allocated for
+     */
+    int nb_ctb_ilf_params;
     
     //image height and width in luma samples
     uint16_t pic_h;
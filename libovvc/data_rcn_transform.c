@@ -434,6 +434,30 @@ DECLARE_ALIGNED(32, const int16_t, DCT_II_64_OT)
   2,	  -7,	  11,	 -15,	  20,	 -24,	  28,	 -33,	  37,	 -41,	  44,	 -48,	  52,	 -56,	  59,	 -62,
 };
 
+DECLARE_ALIGNED(32, const int16_t, DCT_II_64_O)
+/* Odd basis functions of DCT_II_64 restricted to their first 32 samples
+ * (transposed DCT_II_64_OT)
+ */
+[16 * 32] = {
+  91,	  90,	  90,	  90,	  88,	  87,	  86,	  84,	  83,	  81,	  79,	  77,	  73,	  71,	  69,	  65,	  62,	  59,	  56,	  52,	  48,	  44,	  41,	  37,	  33,	  28,	  24,	  20,	  15,	  11,	   7,	   2,
+  90,	  88,	  84,	  79,	  71,	  62,	  52,	  41,	  28,	  15,	   2,	 -11,	 -24,	 -37,	 -48,	 -59,	 -69,	 -77,	 -83,	 -87,	 -90,	 -91,	 -90,	 -86,	 -81,	 -73,	 -65,	 -56,	 -44,	 -33,	 -20,	  -7,
+  90,	  84,	  73,	  59,	  41,	  20,	  -2,	 -24,	 -44,	 -62,	 -77,	 -86,	 -90,	 -90,	 -83,	 -71,	 -56,	 -37,	 -15,	   7,	  28,	  48,	  65,	  79,	  87,	  91,	  88,	  81,	  69,	  52,	  33,	  11,
+  90,	  79,	  59,	  33,	   2,	 -28,	 -56,	 -77,	 -88,	 -90,	 -81,	 -62,	 -37,	  -7,	  24,	  52,	  73,	  87,	  90,	  83,	  65,	  41,	  11,	 -20,	 -48,	 -71,	 -86,	 -91,	 -84,	 -69,	 -44,	 -15,
+  88,	  71,	  41,	   2,	 -37,	 -69,	 -87,	 -90,	 -73,	 -44,	  -7,	  33,	  65,	  86,	  90,	  77,	  48,	  11,	 -28,	 -62,	 -84,	 -90,	 -79,	 -52,	 -15,	  24,	  59,	  83,	  91,	  81,	  56,	  20,
+  87,	  62,	  20,	 -28,	 -69,	 -90,	 -84,	 -56,	 -11,	  37,	  73,	  90,	  81,	  48,	   2,	 -44,	 -79,	 -91,	 -77,	 -41,	   7,	  52,	  83,	  90,	  71,	  33,	 -15,	 -59,	 -86,	 -88,	 -65,	 -24,
+  86,	  52,	  -2,	 -56,	 -87,	 -84,	 -48,	   7,	  59,	  88,	  83,	  44,	 -11,	 -62,	 -90,	 -81,	 -41,	  15,	  65,	  90,	  79,	  37,	 -20,	 -69,	 -90,	 -77,	 -33,	  24,	  71,	  91,	  73,	  28,
+  84,	  41,	 -24,	 -77,	 -90,	 -56,	   7,	  65,	  91,	  69,	  11,	 -52,	 -88,	 -79,	 -28,	  37,	  83,	  86,	  44,	 -20,	 -73,	 -90,	 -59,	   2,	  62,	  90,	  71,	  15,	 -48,	 -87,	 -81,	 -33,
+  83,	  28,	 -44,	 -88,	 -73,	 -11,	  59,	  91,	  62,	  -7,	 -71,	 -90,	 -48,	  24,	  81,	  84,	  33,	 -41,	 -87,	 -77,	 -15,	  56,	  90,	  65,	  -2,	 -69,	 -90,	 -52,	  20,	  79,	  86,	  37,
+  81,	  15,	 -62,	 -90,	 -44,	  37,	  88,	  69,	  -7,	 -77,	 -84,	 -24,	  56,	  91,	  52,	 -28,	 -86,	 -73,	  -2,	  71,	  87,	  33,	 -48,	 -90,	 -59,	  20,	  83,	  79,	  11,	 -65,	 -90,	 -41,
+  79,	   2,	 -77,	 -81,	  -7,	  73,	  83,	  11,	 -71,	 -84,	 -15,	  69,	  86,	  20,	 -65,	 -87,	 -24,	  62,	  88,	  28,	 -59,	 -90,	 -33,	  56,	  90,	  37,	 -52,	 -90,	 -41,	  48,	  91,	  44,
+  77,	 -11,	 -86,	 -62,	  33,	  90,	  44,	 -52,	 -90,	 -24,	  69,	  83,	   2,	 -81,	 -71,	  20,	  88,	  56,	 -41,	 -91,	 -37,	  59,	  87,	  15,	 -73,	 -79,	   7,	  84,	  65,	 -28,	 -90,	 -48,
+  73,	 -24,	 -90,	 -37,	  65,	  81,	 -11,	 -88,	 -48,	  56,	  86,	   2,	 -84,	 -59,	  44,	  90,	  15,	 -79,	 -69,	  33,	  91,	  28,	 -71,	 -77,	  20,	  90,	  41,	 -62,	 -83,	   7,	  87,	  52,
+  71,	 -37,	 -90,	  -7,	  86,	  48,	 -62,	 -79,	  24,	  91,	  20,	 -81,	 -59,	  52,	  84,	 -11,	 -90,	 -33,	  73,	  69,	 -41,	 -88,	  -2,	  87,	  44,	 -65,	 -77,	  28,	  90,	  15,	 -83,	 -56,
+  69,	 -48,	 -83,	  24,	  90,	   2,	 -90,	 -28,	  81,	  52,	 -65,	 -71,	  44,	  84,	 -20,	 -90,	  -7,	  88,	  33,	 -79,	 -56,	  62,	  73,	 -41,	 -86,	  15,	  91,	  11,	 -87,	 -37,	  77,	  59,
+  65,	 -59,	 -71,	  52,	  77,	 -44,	 -81,	  37,	  84,	 -28,	 -87,	  20,	  90,	 -11,	 -90,	   2,	  91,	   7,	 -90,	 -15,	  88,	  24,	 -86,	 -33,	  83,	  41,	 -79,	 -48,	  73,	  56,	 -69,	 -62,
+};
+
+
 
 DECLARE_ALIGNED(32, const int16_t, DCT_II_64_EOT)
 // const int16_t DCT_II_64
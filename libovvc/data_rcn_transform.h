@@ -42,6 +42,7 @@ extern const int16_t DCT_II_8[64];
 extern const int16_t DCT_II_16[256];
 extern const int16_t DCT_II_32[1024];
 extern const int16_t DCT_II_64_OT[16*32];
+extern const int16_t DCT_II_64_O[16*32];
 extern const int16_t DCT_II_64_EOT[8*16];
 extern const int16_t DCT_II_64_EEOT[4*8];
 extern const int16_t DCT_II_64_EEEOT[2*4];
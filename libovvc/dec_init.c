@@ -328,7 +328,7 @@ decinit_set_entry_points(OVPS *const prms, const OVNALUnit *nal, uint32_t nb_sh_
     /* FIXME we consider nb_entries is nb_tiles */
     /* TODO compute and keep track of nb_tiles from pps */
     int nb_entries = tinfo->nb_tile_cols * tinfo->nb_tile_rows;
-    uint32_t rbsp_offset[256];
+    uint32_t rbsp_offset[OV_MAX_NB_TILES + 1];
     const int nb_rbsp_epb = nal->nb_epb;
     const uint32_t *rbsp_epb_pos = nal->epb_pos;
     int nb_sh_epb = 0;
@@ -339,12 +339,13 @@ decinit_set_entry_points(OVPS *const prms, const OVNALUnit *nal, uint32_t nb_sh_
         nb_sh_epb += rbsp_epb_pos[j] <= nb_sh_bytes;
     }
 
-    for (i = 0; i < nb_entries; ++i) {
+    /* Last entry end is derived from RBSP size */
+    for (i = 0; i < nb_entries - 1; ++i) {
         uint32_t entry_offset = sh->sh_entry_point_offset_minus1[i] + 1;
         rbsp_offset[i + 1] = rbsp_offset[i] + entry_offset;
     }
 
-    for (i = 0; i < nb_entries; ++i) {
+    for (i = 0; i < nb_entries - 1; ++i) {
         for (j = nb_sh_epb; j < nb_rbsp_epb; ++j) {
             uint32_t entry_offset = rbsp_offset[i + 1];
             entry_offset -= (entry_offset > (rbsp_epb_pos[j] - nb_sh_bytes));
@@ -48,6 +48,8 @@
 
 #define RPR_SCALE_BITS 14
 
+#define OV_MAX_NUMA_NODES 8
+
 struct MVPool;
 // struct EntryThread;
 
@@ -171,11 +173,10 @@ struct PPSInfo
     } pic_qp_info;
 
     struct TileInfo {
-        int16_t nb_ctu_w[16];
-        int16_t nb_ctu_h[16];
-        int16_t ctu_x[16];
-        int16_t ctu_y[16];
-        /*FIXME determine properly max_num_tiles */
+        int16_t nb_ctu_w[OV_MAX_TILE_COLS];
+        int16_t nb_ctu_h[OV_MAX_TILE_ROWS];
+        int16_t ctu_x[OV_MAX_TILE_COLS];
+        int16_t ctu_y[OV_MAX_TILE_ROWS];
         uint8_t nb_tile_rows;
         uint8_t nb_tile_cols;
     } tile_info;
@@ -242,7 +243,7 @@ struct SHInfo
     } pic_qp_info;
 
     /* Entries points in  RBSP */
-    const uint8_t *rbsp_entry[256];
+    const uint8_t *rbsp_entry[OV_MAX_NB_TILES + 1];
     uint16_t nb_entries;
 };
 
@@ -283,6 +284,27 @@ typedef struct ALFParamsCtu
 } ALFParamsCtu;
 
 
+/* Placement of decoder threads on CPUs and NUMA nodes
+ */
+struct ThreadPlacement
+{
+    /* Pin entry threads on CPUs */
+    uint8_t affinity;
+
+    /* CPUs entry threads are pinned on, entry thread i is pinned
+     * on cpu_list[i % nb_cpus]
+     */
+    int *cpu_list;
+    int nb_cpus;
+
+    /* Distinct NUMA nodes of the CPUs used by entry threads
+     * Frame threads are distributed over these nodes and use
+     * a frame pool local to their node.
+     */
+    int node_list[OV_MAX_NUMA_NODES];
+    uint8_t nb_nodes;
+};
+
 struct MainThread
 {
     int kill;
@@ -297,10 +319,63 @@ struct MainThread
     struct EntryJob *entry_jobs_fifo;
     int64_t first_idx_fifo;
     int64_t last_idx_fifo;
-    uint16_t size_fifo;
+    int size_fifo;
     
     pthread_mutex_t main_mtx;
     pthread_cond_t main_cnd;
+
+    /* Number of events which might have made a picture available
+     * for output and pipe notified on those events (-1 if unused)
+     * Protected by main_mtx.
+     */
+    uint64_t nb_output_events;
+    int event_fd[2];
+
+    /* Entry threads with higher index are parked,
+     * number of pictures decoded so far and time spent
+     * by entry threads decoding entries
+     * Protected by main_mtx.
+     */
+    int nb_active_entry_th;
+    uint64_t nb_pic_decoded;
+    uint64_t busy_time_us;
+};
+
+/* Adjust the number of active threads to reach a target
+ * frame rate with as few threads as possible
+ */
+struct ThreadController
+{
+    /* Target in pictures per second (0 if disabled) */
+    int target_fps;
+
+    int nb_active_frame_th;
+
+    /* Measurement window */
+    uint64_t window_start;
+    uint64_t window_nb_pic;
+    uint64_t window_busy_time;
+};
+
+/* Picture Units waiting to be decoded by the input thread
+ */
+struct InputQueue
+{
+    pthread_t thread;
+    pthread_mutex_t queue_mtx;
+    pthread_cond_t queue_cnd;
+
+    OVPictureUnit **pu_fifo;
+    int size_fifo;
+    int first_idx;
+    int nb_pu;
+
+    /* Error returned by last Picture Unit on failure */
+    int last_ret;
+
+    uint8_t busy;
+    uint8_t kill;
+    uint8_t active;
 };
 
 struct OVVCDec
@@ -367,6 +442,49 @@ struct OVVCDec
     int nb_entry_th;
 
     struct MainThread main_thread;
+
+    struct InputQueue input_queue;
+
+    struct ThreadController thread_ctrl;
+
+    /* Protect DPB from concurrent picture decoding
+     * initialisation and output
+     */
+    pthread_mutex_t dpb_mtx;
+
+    struct ThreadPlacement placement;
+
+    /* User callback on fully decoded CTU lines of the
+     * pictures being decoded
+     */
+    struct {
+        OVRowCallback callback;
+        void *opaque;
+    } row_output;
+
+    /* Pictures to be skipped instead of decoded
+     */
+    struct {
+        /* Combination of enum OVSkipFlags */
+        uint8_t flags;
+        uint8_t max_tid;
+
+        /* Decoding (re)started and no IRAP received yet */
+        uint8_t wait_irap;
+
+        /* RASL of last CRA cannot be decoded */
+        uint8_t skip_rasl;
+
+        /* Value of enum OVSkipLoopFilter */
+        uint8_t loop_filter;
+    } skip_ctx;
+
+    /* Only reconstruct and output luma samples */
+    uint8_t luma_only;
+
+    /* Attach coding information to output frames */
+    uint8_t export_side_data;
+
     /* Informations on decoder behaviour transmitted by user
      */
     struct {
@@ -45,6 +45,7 @@
 #include "ovdpb_internal.h"
 #include "overror.h"
 #include "slicedec.h"
+#include "ovthreads.h"
 #include "ovdec_internal.h"
 
 /* FIXME More global scope for this enum
@@ -61,15 +62,34 @@ const uint8_t SIZE_INT64 = 6;
 static void tmvp_release_mv_planes(OVPicture *const pic);
 
 static int dpb_init_params(OVDPB *dpb, OVDPBParams const *prm);
+static void dpb_update_params(OVDPB *dpb, OVDPBParams const *prm);
 
 static void ovdpb_reset_decoded_ctus(OVPicture *const pic);
 
-static void ovdpb_init_decoded_ctus(OVPicture *const pic, const OVPS *const ps);
+static void ovdpb_init_decoded_ctus(OVPicture *const pic, int mask_w, int mask_h);
 
 static void ovdpb_uninit_decoded_ctus(OVPicture *const pic);
+static void ovdpb_init_row_output(OVPicture *const pic, const OVPS *const ps, const OVVCDec *ovdec);
+
+/* Derive the dimensions of the decoded CTUs maps required
+ * by pictures of a SPS
+ */
+static void
+derive_decoded_ctus_size(const OVSPS *const sps, int *mask_w, int *mask_h)
+{
+    int pic_w = sps->sps_pic_width_max_in_luma_samples;
+    int pic_h = sps->sps_pic_height_max_in_luma_samples;
+    uint8_t log2_ctb_s    = (sps->sps_log2_ctu_size_minus5 + 5) & 0x7;
+    uint16_t nb_ctb_pic_w = (pic_w + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
+    uint16_t nb_ctb_pic_h = (pic_h + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
+
+    *mask_w = (nb_ctb_pic_w >> SIZE_INT64) + 1;
+    *mask_h = nb_ctb_pic_h;
+}
 
 int
-ovdpb_init(OVDPB **dpb_p, const OVPS *ps)
+ovdpb_init(OVDPB **dpb_p, const OVPS *ps, const struct ThreadPlacement *const placement,
+           uint8_t luma_only)
 {
     #if 0
     OVDPB *dpb = *dpb_p;
@@ -82,7 +102,9 @@ ovdpb_init(OVDPB **dpb_p, const OVPS *ps)
          return OVVC_ENOMEM;
     }
 
-    ret = dpbpriv_init_framepool(&(*dpb_p)->internal, ps->sps);
+    (*dpb_p)->internal.luma_only = luma_only;
+
+    ret = dpbpriv_init_framepool(&(*dpb_p)->internal, ps->sps, placement);
     if (ret < 0) {
         goto failframepool;
     }
@@ -90,11 +112,13 @@ ovdpb_init(OVDPB **dpb_p, const OVPS *ps)
     /* FIXME handle temporal and sub layers*/
     dpb_init_params(*dpb_p, &ps->sps->dpb_parameters[ps->sps->sps_max_sublayers_minus1]);
 
+    derive_decoded_ctus_size(ps->sps, &(*dpb_p)->ctus_mask_w, &(*dpb_p)->ctus_mask_h);
+
     OVPicture *pic;
     int nb_dpb_pic = sizeof((*dpb_p)->pictures) / sizeof(*pic);
     for (int j = 0; j < nb_dpb_pic; j++) {
         pic = &(*dpb_p)->pictures[j];
-        ovdpb_init_decoded_ctus(pic, ps);
+        ovdpb_init_decoded_ctus(pic, (*dpb_p)->ctus_mask_w, (*dpb_p)->ctus_mask_h);
     }
 
 
@@ -105,6 +129,61 @@ failframepool:
     return ret;
 }
 
+/* Check if the DPB frame pools and decoded CTUs maps
+ * can hold pictures from a new SPS
+ */
+int
+ovdpb_fits_sps(const OVDPB *dpb, const OVSPS *const sps)
+{
+    int mask_w, mask_h;
+
+    derive_decoded_ctus_size(sps, &mask_w, &mask_h);
+
+    return dpbpriv_framepool_fits(&dpb->internal, sps) &&
+           dpb->ctus_mask_w >= mask_w &&
+           dpb->ctus_mask_h >= mask_h;
+}
+
+/* Resize frame pools and decoded CTUs maps so they can hold
+ * pictures from a new SPS.
+ * New frame pools are created alongside the previous ones. Frames
+ * of pictures remaining in the DPB or still in use by decoding
+ * threads or the user are returned to their former pool which is
+ * freed once all its frames are released.
+ * Decoded CTUs maps of DPB pictures are resized when the picture
+ * is reused so pictures still being decoded are not affected.
+ */
+int
+ovdpb_realloc(OVDPB *dpb, const OVPS *ps, const struct ThreadPlacement *const placement)
+{
+    int mask_w, mask_h;
+    int ret;
+
+    if (!dpbpriv_framepool_fits(&dpb->internal, ps->sps)) {
+        dpbpriv_uninit_framepool(&dpb->internal);
+        ret = dpbpriv_init_framepool(&dpb->internal, ps->sps, placement);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
+    derive_decoded_ctus_size(ps->sps, &mask_w, &mask_h);
+
+    dpb->ctus_mask_w = OVMAX(dpb->ctus_mask_w, mask_w);
+    dpb->ctus_mask_h = OVMAX(dpb->ctus_mask_h, mask_h);
+
+    return 0;
+}
+
+void
+ovdpb_update_params(OVDPB *dpb, const OVPS *ps)
+{
+    const OVSPS *const sps = ps->sps;
+
+    /* FIXME handle temporal and sub layers*/
+    dpb_update_params(dpb, &sps->dpb_parameters[sps->sps_max_sublayers_minus1]);
+}
+
 void
 ovdpb_uninit(OVDPB **dpb_p)
 {
@@ -158,6 +237,59 @@ struct Rational {
     uint32_t den;
 };
 
+static void output_fifo_push(struct OutputFIFO *fifo, OVPicture *pic);
+
+/* Queue pictures waiting for output in output order when
+ * the DPB switches to decoding order output so they are
+ * output before pictures of the new sequence
+ */
+static void
+output_fifo_queue_pending_pics(OVDPB *dpb)
+{
+    const int nb_dpb_pic = sizeof(dpb->pictures) / sizeof(*dpb->pictures);
+    uint64_t queued = 0;
+
+    do {
+        OVPicture *next_pic = NULL;
+        int max_cvs_dist = -1;
+        int i;
+
+        for (i = 0; i < nb_dpb_pic; i++) {
+            OVPicture *pic = &dpb->pictures[i];
+            int cvs_dist = (dpb->cvs_id - pic->cvs_id) & 0xFF;
+            if (!pic->frame || !(pic->flags & OV_OUTPUT_PIC_FLAG) || (queued & ((uint64_t)1 << i))) {
+                continue;
+            }
+
+            if (cvs_dist > max_cvs_dist || (cvs_dist == max_cvs_dist && pic->poc < next_pic->poc)) {
+                max_cvs_dist = cvs_dist;
+                next_pic = pic;
+            }
+        }
+
+        if (!next_pic) {
+            break;
+        }
+
+        queued |= (uint64_t)1 << (next_pic - dpb->pictures);
+        output_fifo_push(&dpb->output_fifo, next_pic);
+    } while (1);
+}
+
+static void
+dpb_update_params(OVDPB *dpb, OVDPBParams const *prm)
+{
+    uint8_t max_nb_reorder_pic = prm->dpb_max_num_reorder_pics;
+
+    if (!max_nb_reorder_pic && dpb->max_nb_reorder_pic && !dpb->output_fifo.nb_pic) {
+        output_fifo_queue_pending_pics(dpb);
+    }
+
+    dpb->max_nb_dpb_pic       = prm->dpb_max_dec_pic_buffering_minus1 + 1;
+    dpb->max_nb_reorder_pic   = max_nb_reorder_pic;
+    dpb->max_latency_increase = prm->dpb_max_latency_increase_plus1 - 1;
+}
+
 static int
 dpb_init_params(OVDPB *dpb, OVDPBParams const *prm)
 {
@@ -169,9 +301,7 @@ dpb_init_params(OVDPB *dpb, OVDPBParams const *prm)
     uint32_t time_scale         = 27000000;
     uint32_t nb_units_in_ticks  = framerate.den * time_scale / framerate.num;
 
-    dpb->max_nb_dpb_pic       = prm->dpb_max_dec_pic_buffering_minus1 + 1;
-    dpb->max_nb_reorder_pic   = prm->dpb_max_num_reorder_pics;
-    dpb->max_latency_increase = prm->dpb_max_latency_increase_plus1 - 1;
+    dpb_update_params(dpb, prm);
 
     dpb->nb_units_in_ticks = nb_units_in_ticks;
     dpb->pts = 0;
@@ -194,6 +324,34 @@ derive_poc(int poc_lsb, int log2_max_poc_lsb, int prev_poc)
     return poc_msb + poc_lsb;
 }
 
+static int
+derive_pic_poc(const OVPH *const ph, const OVSPS *const sps, uint8_t idr_flag, int prev_poc)
+{
+    uint8_t log2_max_poc_lsb = sps->sps_log2_max_pic_order_cnt_lsb_minus4 + 4;
+
+    if (idr_flag) {
+        int poc_msb = 0;
+        if (ph->ph_poc_msb_cycle_present_flag) {
+            poc_msb = ph->ph_poc_msb_cycle_val << log2_max_poc_lsb;
+        }
+        return poc_msb + ph->ph_pic_order_cnt_lsb;
+    }
+
+    return derive_poc(ph->ph_pic_order_cnt_lsb, log2_max_poc_lsb, prev_poc);
+}
+
+void
+ovdpb_update_skipped_poc(OVDPB *dpb, const OVPH *const ph, const OVSPS *const sps,
+                         uint8_t nalu_type)
+{
+    uint8_t idr_flag = nalu_type == OVNALU_IDR_W_RADL || nalu_type == OVNALU_IDR_N_LP;
+
+    /* Keep previous POC up to date so the POC MSB of following
+     * decoded pictures is derived from the skipped picture
+     */
+    dpb->poc = derive_pic_poc(ph, sps, idr_flag, dpb->poc);
+}
+
 void
 ovdpb_unref_pic(OVPicture *pic, int flags)
 {
@@ -333,6 +491,30 @@ ovdpb_clear_refs(OVDPB *dpb)
 }
 
 
+/* Remove all pictures from the DPB without output and start
+ * a new Coded Video Sequence so the DPB can be reused without
+ * reallocation.
+ * Pictures must not be in use by any decoding thread.
+ */
+void
+ovdpb_clear_dpb(OVDPB *dpb)
+{
+    int i;
+    const int nb_dpb_pic = sizeof(dpb->pictures) / sizeof(*dpb->pictures);
+
+    for (i = 0; i < nb_dpb_pic; i++) {
+        OVPicture *pic = &dpb->pictures[i];
+        pic->flags = 0;
+        atomic_init(&pic->ref_count, 0);
+        ovdpb_release_pic(dpb, pic);
+    }
+
+    dpb->output_fifo.first_idx = 0;
+    dpb->output_fifo.nb_pic    = 0;
+
+    dpb->cvs_id = (dpb->cvs_id + 1) & 0xFF;
+}
+
 /* All pictures are removed from the DPB */
 void
 ovdpb_flush_dpb(OVDPB *dpb)
@@ -349,9 +531,61 @@ ovdpb_flush_dpb(OVDPB *dpb)
     }
 }
 
+static void
+output_fifo_push(struct OutputFIFO *fifo, OVPicture *pic)
+{
+    int size = sizeof(fifo->pic) / sizeof(*fifo->pic);
+    uint8_t idx = (fifo->first_idx + fifo->nb_pic) % size;
+
+    /* Each picture of the DPB can only be waiting once for output */
+    if (fifo->nb_pic == size) {
+        ov_log(NULL, OVLOG_ERROR, "Output FIFO full\n");
+        return;
+    }
+
+    fifo->pic[idx]    = pic;
+    fifo->poc[idx]    = pic->poc;
+    fifo->cvs_id[idx] = pic->cvs_id;
+    fifo->nb_pic++;
+}
+
+/* Return the first picture waiting for output in decoding order
+ * Entries of pictures which were output or removed from the DPB
+ * by other means are discarded.
+ */
+static OVPicture *
+output_fifo_head(struct OutputFIFO *fifo)
+{
+    int size = sizeof(fifo->pic) / sizeof(*fifo->pic);
+
+    while (fifo->nb_pic) {
+        uint8_t idx = fifo->first_idx;
+        OVPicture *pic = fifo->pic[idx];
+        uint8_t is_same_pic = pic->poc == fifo->poc[idx] && pic->cvs_id == fifo->cvs_id[idx];
+
+        if (is_same_pic && pic->frame && (pic->flags & OV_OUTPUT_PIC_FLAG)) {
+            return pic;
+        }
+
+        fifo->first_idx = (idx + 1) % size;
+        fifo->nb_pic--;
+    }
+
+    return NULL;
+}
+
+static void
+output_fifo_pop(struct OutputFIFO *fifo)
+{
+    int size = sizeof(fifo->pic) / sizeof(*fifo->pic);
+
+    fifo->first_idx = (fifo->first_idx + 1) % size;
+    fifo->nb_pic--;
+}
+
 /*FIXME rename to request new picture */
 static OVPicture *
-alloc_frame(OVDPB *dpb)
+alloc_frame(OVDPB *dpb, uint8_t pool_idx)
 {
     int i, ret;
     const int nb_dpb_pic = sizeof(dpb->pictures) / sizeof(*dpb->pictures);
@@ -365,7 +599,7 @@ alloc_frame(OVDPB *dpb)
             continue;
         }
 
-        ret = dpbpriv_request_frame(&dpb->internal, &pic->frame);
+        ret = dpbpriv_request_frame(&dpb->internal, &pic->frame, pool_idx);
         
         if (ret < 0) {
             ov_log(NULL, OVLOG_ERROR, "Error while requesting picture from DPB\n");
@@ -375,6 +609,8 @@ alloc_frame(OVDPB *dpb)
         pic->flags = 0;
         atomic_init(&pic->ref_count, 0);
 
+        pic->decoded_ctus.row_cb = NULL;
+
         ov_log(NULL, OVLOG_DEBUG, "Attached frame %p to Picture with POC %d\n", pic->frame, pic->poc);
 
         return pic;
@@ -387,7 +623,8 @@ alloc_frame(OVDPB *dpb)
 
 /* Allocate the current picture buffer */
 static int
-ovdpb_init_current_pic(OVDPB *dpb, OVPicture **pic_p, int poc, uint8_t ph_pic_output_flag)
+ovdpb_init_current_pic(OVDPB *dpb, OVPicture **pic_p, int poc, uint8_t ph_pic_output_flag,
+                       uint8_t pool_idx)
 {
     OVPicture *pic;
     int i;
@@ -407,7 +644,7 @@ ovdpb_init_current_pic(OVDPB *dpb, OVPicture **pic_p, int poc, uint8_t ph_pic_ou
         }
     }
 
-    pic = alloc_frame(dpb);
+    pic = alloc_frame(dpb, pool_idx);
 
     if (!pic) {
         return OVVC_ENOMEM;
@@ -415,6 +652,15 @@ ovdpb_init_current_pic(OVDPB *dpb, OVPicture **pic_p, int poc, uint8_t ph_pic_ou
 
     *pic_p = pic;
 
+    /* Resize decoded CTUs map if the SPS changed since
+     * the picture was last used
+     */
+    if (pic->decoded_ctus.mask_w < dpb->ctus_mask_w ||
+        pic->decoded_ctus.mask_h < dpb->ctus_mask_h) {
+        ovdpb_uninit_decoded_ctus(pic);
+        ovdpb_init_decoded_ctus(pic, dpb->ctus_mask_w, dpb->ctus_mask_h);
+    }
+
     ovdpb_reset_decoded_ctus(pic);
 
     #if 0
@@ -432,6 +678,10 @@ ovdpb_init_current_pic(OVDPB *dpb, OVPicture **pic_p, int poc, uint8_t ph_pic_ou
     pic->cvs_id = dpb->cvs_id;
     pic->frame->poc = poc;
 
+    if (ph_pic_output_flag && !dpb->max_nb_reorder_pic) {
+        output_fifo_push(&dpb->output_fifo, pic);
+    }
+
     /* Copy display or conformance window properties */
 
     return 0;
@@ -520,7 +770,7 @@ vvc_mark_refs(OVDPB *dpb, const OVRPL *rpl, int32_t poc, struct RPLInfo *rpl_inf
              * Picture with requested POC ID in the DPB
              */
             ov_log(NULL, OVLOG_ERROR, "Generating missing reference %d for picture %d\n", ref_poc, dpb->poc);
-            ref_pic = alloc_frame(dpb);
+            ref_pic = alloc_frame(dpb, 0);
 
             if (ref_pic == NULL){
                 return OVVC_ENOMEM;
@@ -621,6 +871,18 @@ ovdpb_drain_frame(OVDPB *dpb, OVFrame **out, OVSEI **sei_p)
 {
     int output_cvs_id = find_min_cvs_id(dpb);
 
+    /* Pictures are output in decoding order if reordering is not allowed */
+    if (!dpb->max_nb_reorder_pic) {
+        OVPicture *pic = output_fifo_head(&dpb->output_fifo);
+        if (pic) {
+            output_fifo_pop(&dpb->output_fifo);
+            dpb->pts += dpb->nb_units_in_ticks;
+            pic->frame->pts = dpb->pts;
+            dpb_pic_to_frame_ref(pic, out, sei_p);
+            return dpb->output_fifo.nb_pic + 1;
+        }
+    }
+
     do {
         const int nb_dpb_pic = sizeof(dpb->pictures) / sizeof(*dpb->pictures);
         int nb_output = 0;
@@ -692,7 +954,28 @@ ovdpb_output_pic(OVDPB *dpb, OVFrame **out, OVSEI **sei_p)
 {
     int nb_dpb_pic = sizeof(dpb->pictures) / sizeof(*dpb->pictures);
     int i;
-    int output_cvs_id = find_min_cvs_id(dpb);
+    int output_cvs_id;
+
+    /* If reordering is not allowed pictures are output in decoding
+     * order as soon as they are decoded
+     */
+    if (!dpb->max_nb_reorder_pic) {
+        OVPicture *pic = output_fifo_head(&dpb->output_fifo);
+        if (pic) {
+            if (pic->flags & OV_IN_DECODING_PIC_FLAG) {
+                *out = NULL;
+                return 0;
+            }
+
+            output_fifo_pop(&dpb->output_fifo);
+            dpb->pts += dpb->nb_units_in_ticks;
+            pic->frame->pts = dpb->pts;
+            dpb_pic_to_frame_ref(pic, out, sei_p);
+            return dpb->output_fifo.nb_pic + 1;
+        }
+    }
+
+    output_cvs_id = find_min_cvs_id(dpb);
 
         int nb_output = 0;
         int min_poc   = INT_MAX;
@@ -1109,20 +1392,11 @@ ovdpb_init_picture(OVDPB *dpb, OVPicture **pic_p, const OVPS *const ps, uint8_t
          * a new coded video sequence
          */
         dpb->cvs_id = (dpb->cvs_id + 1) & 0xFF;
-        if (ps->ph->ph_poc_msb_cycle_present_flag) {
-            uint8_t log2_max_poc_lsb = ps->sps->sps_log2_max_pic_order_cnt_lsb_minus4 + 4;
-            poc = ps->ph->ph_poc_msb_cycle_val << log2_max_poc_lsb;
-        } else {
-            poc = 0;
-        }
-        poc += ps->ph->ph_pic_order_cnt_lsb;
-    } else {
-        /* FIXME arg should be last_poc */
-        poc = derive_poc(ps->ph->ph_pic_order_cnt_lsb,
-                         ps->sps->sps_log2_max_pic_order_cnt_lsb_minus4 + 4,
-                         poc);
     }
 
+    /* FIXME arg should be last_poc */
+    poc = derive_pic_poc(ps->ph, ps->sps, idr_flag, poc);
+
     dpb->poc = poc;
 
     /* If the NALU is an Refresh Picture all previous pictures in DPB
@@ -1140,7 +1414,8 @@ ovdpb_init_picture(OVDPB *dpb, OVPicture **pic_p, const OVPS *const ps, uint8_t
     /* Find an available place in DPB and allocate/retrieve available memory
      * for the current picture data from the Frame Pool
      */
-    ret = ovdpb_init_current_pic(dpb, pic_p, poc, ps->ph->ph_pic_output_flag);
+    /* Frame is taken from the pool local to the frame thread NUMA node */
+    ret = ovdpb_init_current_pic(dpb, pic_p, poc, ps->ph->ph_pic_output_flag, sldec->node_idx);
     if (ret < 0) {
         goto fail;
     }
@@ -1160,6 +1435,8 @@ ovdpb_init_picture(OVDPB *dpb, OVPicture **pic_p, const OVPS *const ps, uint8_t
         (*pic_p)->frame->output_window.offset_blw = ps->sps->sps_conf_win_bottom_offset;
     }
 
+    ovdpb_init_row_output(*pic_p, ps, ovdec);
+
     (*pic_p)->scale_info.scaling_win_left   = ps->pps->pps_scaling_win_left_offset;
     (*pic_p)->scale_info.scaling_win_right  = ps->pps->pps_scaling_win_right_offset;
     (*pic_p)->scale_info.scaling_win_top    = ps->pps->pps_scaling_win_top_offset;
@@ -1204,6 +1481,22 @@ ovdpb_init_picture(OVDPB *dpb, OVPicture **pic_p, const OVPS *const ps, uint8_t
         }
     }
 
+    if (ovdec->export_side_data) {
+        OVPicture *const pic = *pic_p;
+
+        /* MV planes are otherwise only requested for TMVP */
+        if (!ps->sps->sps_temporal_mvp_enabled_flag && ph->ph_inter_slice_allowed_flag) {
+            tmvp_request_mv_plane(pic, ovdec, sh->sh_slice_type);
+        }
+
+        ret = mvpool_attach_side_data(ovdec->mv_pool, pic->frame, &pic->mv_plane0,
+                                      &pic->mv_plane1, &ovdec->active_params.pic_info);
+        if (ret < 0) {
+            ov_log(NULL, OVLOG_WARNING, "Could not attach side data to picture POC %d\n", poc);
+            ret = 0;
+        }
+    }
+
     return ret;
 
 fail:
@@ -1218,20 +1511,48 @@ fail:
     return ret;
 }
 
+/* Set bits of CTUs from xmin_ctu to xmax_ctu in a line mask
+ * of mask_w 64 bits words
+ */
 static void
 xctu_to_mask(uint64_t* mask, int mask_w, int xmin_ctu, int xmax_ctu)
 {
-    int sub_xmin_ctu, sub_xmax_ctu;
-    for(int i = (xmin_ctu >> SIZE_INT64); i <= (xmax_ctu >> SIZE_INT64); i++)
-    {
-        mask[i] = 0;
-        sub_xmin_ctu = xmin_ctu > (i<<SIZE_INT64)     ? xmin_ctu % (1<<SIZE_INT64) : 0;
-        sub_xmax_ctu = xmax_ctu < ((i+1)<<SIZE_INT64) ? xmax_ctu % (1<<SIZE_INT64) : (1<<SIZE_INT64)-1;
-        for(int ii = sub_xmin_ctu; ii <= sub_xmax_ctu; ii++)
-            mask[i] |= (uint64_t)1 << ii;
+    for (int i = 0; i < mask_w; i++) {
+        int sub_xmin_ctu = xmin_ctu - (i << SIZE_INT64);
+        int sub_xmax_ctu = xmax_ctu - (i << SIZE_INT64);
+
+        sub_xmin_ctu = OVMAX(sub_xmin_ctu, 0);
+        sub_xmax_ctu = OVMIN(sub_xmax_ctu, (1 << SIZE_INT64) - 1);
+
+        if (sub_xmin_ctu > sub_xmax_ctu) {
+            mask[i] = 0;
+        } else {
+            mask[i]  = ~(uint64_t)0 >> ((1 << SIZE_INT64) - 1 - sub_xmax_ctu);
+            mask[i] &= ~(uint64_t)0 << sub_xmin_ctu;
+        }
     }
 }
 
+/* Check if CTUs in wanted_mask are decoded on CTU lines tl_ctu_y to br_ctu_y
+ * Must be called with ref_mtx locked.
+ */
+static uint8_t
+ref_ctus_available(const struct PicDecodedCtusInfo *decoded_ctus, const uint64_t *wanted_mask,
+                   int tl_ctu_y, int br_ctu_y)
+{
+    int mask_w = decoded_ctus->mask_w;
+
+    for (int ctu_y = tl_ctu_y; ctu_y <= br_ctu_y; ctu_y++ ) {
+        for (int i = 0; i < mask_w; i++) {
+            if ((decoded_ctus->mask[ctu_y][i] & wanted_mask[i]) != wanted_mask[i]) {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
 static void
 ovdpb_no_synchro(const OVPicture *const ref_pic, int tl_ctu_x, int tl_ctu_y, int br_ctu_x, int br_ctu_y)
 {
@@ -1246,20 +1567,30 @@ ovdpb_synchro_ref_decoded_ctus(const OVPicture *const ref_pic, int tl_ctu_x, int
     //TODOpar: store previous decoded_ctus of ref_pic in local memory.
     //Avoid to fetch decoded_ctus variable when not needed.
     int mask_w = decoded_ctus->mask_w;
-    uint64_t wanted_mask[4];
+    uint64_t wanted_mask[mask_w];
     xctu_to_mask(wanted_mask, mask_w, tl_ctu_x, br_ctu_x);
 
     //TODOpar: create a mutex + ref_cnd by ctu line ?
     uint8_t all_ctus_available;
+    uint8_t can_help = 1;
     do {
         pthread_mutex_lock(decoded_ctus->ref_mtx);
 
-        all_ctus_available = 1;
-        for (int ctu_y = tl_ctu_y; ctu_y <= br_ctu_y; ctu_y++ ) {
-            for (int i = 0; i < mask_w; i++)
-                all_ctus_available = all_ctus_available && ((decoded_ctus->mask[ctu_y][i] & wanted_mask[i]) == wanted_mask[i]);
+        all_ctus_available = ref_ctus_available(decoded_ctus, wanted_mask, tl_ctu_y, br_ctu_y);
+
+        if (!all_ctus_available && can_help) {
+            pthread_mutex_unlock(decoded_ctus->ref_mtx);
+
+            /* Decode pending entries of the reference picture instead
+             * of waiting for other threads to decode them
+             */
+            can_help = ovthread_decode_ref_entry(ref_pic);
+
+            pthread_mutex_lock(decoded_ctus->ref_mtx);
+            all_ctus_available = ref_ctus_available(decoded_ctus, wanted_mask, tl_ctu_y, br_ctu_y);
         }
-        if (!all_ctus_available) {
+
+        if (!all_ctus_available && !can_help) {
             // ov_log(NULL, OVLOG_DEBUG, "Wait ref POC %d lines %d,%d \n", ref_pic->poc, tl_ctu_x, tl_ctu_y);
             pthread_cond_wait(decoded_ctus->ref_cnd, decoded_ctus->ref_mtx);
         }
@@ -1269,17 +1600,11 @@ ovdpb_synchro_ref_decoded_ctus(const OVPicture *const ref_pic, int tl_ctu_x, int
 }
 
 void
-ovdpb_init_decoded_ctus(OVPicture *const pic, const OVPS *const ps)
+ovdpb_init_decoded_ctus(OVPicture *const pic, int mask_w, int mask_h)
 {   
-    int pic_w = ps->sps->sps_pic_width_max_in_luma_samples;
-    int pic_h = ps->sps->sps_pic_width_max_in_luma_samples;
-    uint8_t log2_ctb_s    = (ps->sps->sps_log2_ctu_size_minus5 + 5) & 0x7;
-    uint16_t nb_ctb_pic_w = (pic_w + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
-    uint16_t nb_ctb_pic_h = (pic_h + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
-
     struct PicDecodedCtusInfo* decoded_ctus = &pic->decoded_ctus;
-    decoded_ctus->mask_h = nb_ctb_pic_h;
-    decoded_ctus->mask_w = (nb_ctb_pic_w >> SIZE_INT64) + 1;
+    decoded_ctus->mask_h = mask_h;
+    decoded_ctus->mask_w = mask_w;
 
     if(!decoded_ctus->mask){
         decoded_ctus->mask = ov_mallocz(decoded_ctus->mask_h * sizeof(uint64_t*));
@@ -1287,6 +1612,8 @@ ovdpb_init_decoded_ctus(OVPicture *const pic, const OVPS *const ps)
             decoded_ctus->mask[i] = ov_mallocz(decoded_ctus->mask_w * sizeof(uint64_t));
     }
 
+    pthread_mutex_init(&decoded_ctus->out_mtx, NULL);
+
     atomic_init(&pic->idx_function, 1);
     pic->ovdpb_frame_synchro[0] = ovdpb_no_synchro;
     pic->ovdpb_frame_synchro[1] = ovdpb_synchro_ref_decoded_ctus;
@@ -1302,7 +1629,72 @@ ovdpb_uninit_decoded_ctus(OVPicture *const pic)
         for(int i = 0; i < decoded_ctus->mask_h; i++)
             ov_freep(&decoded_ctus->mask[i]);
         ov_freep(&decoded_ctus->mask);
+        pthread_mutex_destroy(&decoded_ctus->out_mtx);
+    }
+}
+
+static void
+ovdpb_init_row_output(OVPicture *const pic, const OVPS *const ps, const OVVCDec *ovdec)
+{
+    struct PicDecodedCtusInfo* decoded_ctus = &pic->decoded_ctus;
+    uint8_t log2_ctb_s = (ps->sps->sps_log2_ctu_size_minus5 + 5) & 0x7;
+    uint16_t pic_w = ps->pps->pps_pic_width_in_luma_samples;
+    uint16_t pic_h = ps->pps->pps_pic_height_in_luma_samples;
+
+    decoded_ctus->row_cb        = ovdec->row_output.callback;
+    decoded_ctus->row_cb_opaque = ovdec->row_output.opaque;
+    decoded_ctus->nb_ctb_w      = (pic_w + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
+    decoded_ctus->nb_ctb_h      = (pic_h + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
+    decoded_ctus->log2_ctb_s    = log2_ctb_s;
+    decoded_ctus->nb_lines_out  = 0;
+}
+
+/* Forward the range of CTU lines which were fully decoded since
+ * last output to the user callback.
+ * Lines are output in raster order so a line is only output once
+ * all CTUs of previous lines are decoded.
+ */
+static void
+ovdpb_output_decoded_lines(OVPicture *const pic)
+{
+    struct PicDecodedCtusInfo* decoded_ctus = &pic->decoded_ctus;
+    int mask_w = decoded_ctus->mask_w;
+    int nb_ctb_h = OVMIN(decoded_ctus->nb_ctb_h, decoded_ctus->mask_h);
+    uint64_t line_mask[mask_w];
+    int y_ctu;
+
+    xctu_to_mask(line_mask, mask_w, 0, decoded_ctus->nb_ctb_w - 1);
+
+    pthread_mutex_lock(&decoded_ctus->out_mtx);
+
+    y_ctu = decoded_ctus->nb_lines_out;
+
+    pthread_mutex_lock(decoded_ctus->ref_mtx);
+    while (y_ctu < nb_ctb_h) {
+        int i;
+        for (i = 0; i < mask_w; i++) {
+            if ((decoded_ctus->mask[y_ctu][i] & line_mask[i]) != line_mask[i]) {
+                break;
+            }
+        }
+
+        if (i < mask_w) {
+            break;
+        }
+        y_ctu++;
     }
+    pthread_mutex_unlock(decoded_ctus->ref_mtx);
+
+    if (y_ctu > decoded_ctus->nb_lines_out) {
+        int y_start = decoded_ctus->nb_lines_out << decoded_ctus->log2_ctb_s;
+        int y_end   = OVMIN(y_ctu << decoded_ctus->log2_ctb_s, pic->frame->height);
+
+        decoded_ctus->row_cb(decoded_ctus->row_cb_opaque, pic->frame, y_start, y_end);
+
+        decoded_ctus->nb_lines_out = y_ctu;
+    }
+
+    pthread_mutex_unlock(&decoded_ctus->out_mtx);
 }
 
 void
@@ -1318,6 +1710,10 @@ ovdpb_report_decoded_ctu_line(OVPicture *const pic, int y_ctu, int xmin_ctu, int
         decoded_ctus->mask[y_ctu][i] |= mask[i];
     pthread_cond_broadcast(decoded_ctus->ref_cnd);
     pthread_mutex_unlock(decoded_ctus->ref_mtx);
+
+    if (decoded_ctus->row_cb) {
+        ovdpb_output_decoded_lines(pic);
+    }
     // ov_log(NULL, OVLOG_TRACE, "update_decoded_ctus POC %d line %d\n", pic->poc, y_ctu);
 }
 
@@ -1332,6 +1728,11 @@ ovdpb_report_decoded_frame(OVPicture *const pic)
     pthread_cond_broadcast(decoded_ctus->ref_cnd);
     pthread_mutex_unlock(decoded_ctus->ref_mtx);
 
+    /* Output remaining lines if any */
+    if (decoded_ctus->row_cb) {
+        ovdpb_output_decoded_lines(pic);
+    }
+
     atomic_store(&pic->idx_function, 0);
 }
 
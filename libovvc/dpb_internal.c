@@ -48,31 +48,65 @@
 void
 dpbpriv_uninit_framepool(struct DPBInternal *dpb_priv)
 {
-    ovframepool_uninit(&dpb_priv->frame_pool);
+    int i;
+    for (i = 0; i < dpb_priv->nb_pools; ++i) {
+        ovframepool_uninit(&dpb_priv->frame_pool[i]);
+    }
+    dpb_priv->nb_pools = 0;
 }
 
 int
-dpbpriv_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps)
+dpbpriv_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps,
+                       const struct ThreadPlacement *const placement)
 {
+    /* Without thread placement a unique pool is used and frames
+     * are allocated wherever they are first touched
+     */
+    int nb_pools = placement->nb_nodes ? placement->nb_nodes : 1;
     int ret;
+    int i;
 
-    ret = ovframepool_init(&dpb_priv->frame_pool, sps->sps_chroma_format_idc,
-                           sps->sps_bitdepth_minus8,
-                           sps->sps_pic_width_max_in_luma_samples,
-                           sps->sps_pic_height_max_in_luma_samples);
-    if (ret < 0) {
-        goto fail_init;
+    for (i = 0; i < nb_pools; ++i) {
+        int node = placement->nb_nodes ? placement->node_list[i] : -1;
+        ret = ovframepool_init(&dpb_priv->frame_pool[i], sps->sps_chroma_format_idc,
+                               dpb_priv->luma_only, sps->sps_bitdepth_minus8,
+                               sps->sps_pic_width_max_in_luma_samples,
+                               sps->sps_pic_height_max_in_luma_samples,
+                               node);
+        if (ret < 0) {
+            goto fail_init;
+        }
+        dpb_priv->nb_pools++;
     }
 
     return 0;
 fail_init:
+    dpbpriv_uninit_framepool(dpb_priv);
     return ret;
 }
 
 int
-dpbpriv_request_frame(struct DPBInternal *dpb_priv, OVFrame **frame_p)
+dpbpriv_framepool_fits(const struct DPBInternal *dpb_priv, const OVSPS *const sps)
 {
-    *frame_p = ovframepool_request_frame(dpb_priv->frame_pool);
+    /* All pools are allocated with the same dimensions */
+    return dpb_priv->nb_pools &&
+           ovframepool_fits(dpb_priv->frame_pool[0], sps->sps_chroma_format_idc,
+                            dpb_priv->luma_only, sps->sps_bitdepth_minus8,
+                            sps->sps_pic_width_max_in_luma_samples,
+                            sps->sps_pic_height_max_in_luma_samples);
+}
+
+int
+dpbpriv_request_frame(struct DPBInternal *dpb_priv, OVFrame **frame_p, uint8_t pool_idx)
+{
+    /* Fall back on first pool for frames not associated
+     * to any frame thread
+     */
+    if (pool_idx >= dpb_priv->nb_pools) {
+        pool_idx = 0;
+    }
+
+    *frame_p = ovframepool_request_frame(dpb_priv->frame_pool[pool_idx]);
     if (!*frame_p) {
         return OVVC_ENOMEM;
     }
@@ -76,10 +76,6 @@
 
 #define TMVP_POS_MASK(y) ((uint64_t) 1 << ((y) + 1))
 
-#define MV_MANTISSA_BITCOUNT 6
-#define MV_MANTISSA_UPPER_LIMIT ((1 << (MV_MANTISSA_BITCOUNT - 1)) - 1)
-#define MV_MANTISSA_LIMIT (1 << (MV_MANTISSA_BITCOUNT - 1))
-
 
 enum AffineType
 {
@@ -349,27 +345,6 @@ derive_cand_position(struct PBInfo pb_info, enum CandName cand_name)
     return pos;
 }
 
-/* Compress and uncompress Motion vectors used by TMVP
- * FIXME there might be a more straight forward way of
- * doing this
- */
-static inline int32_t
-tmvp_compress_uncompress_mv(int32_t val)
-{
-  int sign  = val >> 31;
-
-  if ((val ^ sign) - !!sign > 31) {
-      int scale = floor_log2((val ^ sign) | MV_MANTISSA_UPPER_LIMIT) - (MV_MANTISSA_BITCOUNT - 1);
-      int round = (1 << scale) >> 1;
-      int n     = (val + round) >> scale;
-      int exponent  = scale + ((n ^ sign) >> (MV_MANTISSA_BITCOUNT - 1));
-      int mantissa  = (n & MV_MANTISSA_UPPER_LIMIT) | (sign << (MV_MANTISSA_BITCOUNT - 1));
-      return (mantissa ^ MV_MANTISSA_LIMIT) << (exponent - !!exponent);
-  } else {
-      return val;
-  }
-}
-
 static void
 load_ctb_tmvp(OVCTUDec *const ctudec, int ctb_x, int ctb_y)
 {
@@ -409,10 +384,13 @@ load_ctb_tmvp(OVCTUDec *const ctudec, int ctb_x, int ctb_y)
         int32_t nb_tmvp_unit = nb_pb_ctb_w >> 1;
         int32_t pln_stride = nb_tmvp_unit * nb_ctb_w;
         int32_t ctb_offset = ctb_x * nb_tmvp_unit + (ctb_y * nb_tmvp_unit * pln_stride);
-        OVMV *src_mv = plane0->mvs + ctb_offset;
-        OVMV *mvs = tmvp_ctx->mvs0;
+        struct TMVPMV *src_mv = plane0->mvs + ctb_offset;
+        struct TMVPMV *mvs = tmvp_ctx->mvs0;
         int i;
             tmvp_ctx->ctb_mv0 = src_mv;
+            if (!is_border_pic) {
+                tmvp_prefetch_next_ctb(src_mv, src_dirs, nb_tmvp_unit, pln_stride);
+            }
             tmvp_ctx->pln0_stride = pln_stride;
 
         memcpy(&tmvp_ctx->dir_map_v0[1], src_dirs, sizeof(uint64_t) * (nb_pb_ctb_w + !is_border_pic));
@@ -426,16 +404,19 @@ load_ctb_tmvp(OVCTUDec *const ctudec, int ctb_x, int ctb_y)
     }
 
     if (plane1 && plane1->dirs) {
-        OVMV *mvs = tmvp_ctx->mvs1;
+        struct TMVPMV *mvs = tmvp_ctx->mvs1;
         uint64_t *src_dirs = plane1->dirs + ctb_addr_rs * nb_pb_ctb_w;
         int i;
 
         int32_t nb_tmvp_unit = nb_pb_ctb_w >> 1;
         int32_t pln_stride = nb_tmvp_unit * nb_ctb_w;
         int32_t ctb_offset = ctb_x * nb_tmvp_unit + (ctb_y * nb_tmvp_unit * pln_stride);
-        OVMV *src_mv = plane1->mvs + ctb_offset;
+        struct TMVPMV *src_mv = plane1->mvs + ctb_offset;
 
             tmvp_ctx->ctb_mv1 = src_mv;
+            if (!is_border_pic) {
+                tmvp_prefetch_next_ctb(src_mv, src_dirs, nb_tmvp_unit, pln_stride);
+            }
             tmvp_ctx->pln1_stride = pln_stride;
             tmvp_ctx->pln0_stride = pln_stride;
         /*FIXME memory could be spared with smaller map size when possible */
@@ -527,9 +508,6 @@ static OVMV tmvp_rescale(OVMV mv, int16_t scale)
 {
     OVMV dst;
 
-    mv.x = tmvp_compress_uncompress_mv(mv.x);
-    mv.y = tmvp_compress_uncompress_mv(mv.y);
-
     dst = tmvp_scale_mv(scale, mv);
 
     return dst;
@@ -556,13 +534,13 @@ tmvp_from_l0(const struct InterDRVCtx *const inter_ctx, const struct VVCTMVP *co
     if (cand_c0 | cand_c01) {
         int16_t c0_pos = TMVP_POS_IN_BUF2(pos.c0_x, pos.c0_y);
 
-        const OVMV *mvs    = cand_c0 ? tmvp->ctb_mv0
+        const struct TMVPMV *mvs    = cand_c0 ? tmvp->ctb_mv0
                                      : tmvp->ctb_mv1;
 
         const int16_t *dist_cols = cand_c0 ? tmvp->dist_col_0
                                            : tmvp->dist_col_1;
 
-        mv       = mvs[c0_pos];
+        mv       = tmvp_load_mv(mvs[c0_pos]);
         dist_col = dist_cols[mv.ref_idx];
 
         goto found;
@@ -570,14 +548,14 @@ tmvp_from_l0(const struct InterDRVCtx *const inter_ctx, const struct VVCTMVP *co
     } else if (cand_c1 | cand_c11) {
         int16_t c1_pos = TMVP_POS_IN_BUF2(pos.c1_x, pos.c1_y);
 
-        const OVMV *mvs    = cand_c1 ? tmvp->ctb_mv0
+        const struct TMVPMV *mvs    = cand_c1 ? tmvp->ctb_mv0
                                      : tmvp->ctb_mv1;
 
         const int16_t *dist_cols = cand_c1 ? tmvp->dist_col_0
                                            : tmvp->dist_col_1;
 
 
-        mv       = mvs[c1_pos];
+        mv       = tmvp_load_mv(mvs[c1_pos]);
         dist_col = dist_cols[mv.ref_idx];
 
         goto found;
@@ -620,13 +598,13 @@ tmvp_from_l1(const struct InterDRVCtx *const inter_ctx, const struct VVCTMVP *co
     if (cand_c0 | cand_c01) {
         int16_t c0_pos = TMVP_POS_IN_BUF2(pos.c0_x, pos.c0_y);
 
-        const OVMV *mvs    = cand_c01 ? tmvp->ctb_mv1
+        const struct TMVPMV *mvs    = cand_c01 ? tmvp->ctb_mv1
                                       : tmvp->ctb_mv0;
 
         const int16_t *dist_cols = cand_c01 ? tmvp->dist_col_1
                                             : tmvp->dist_col_0;
 
-        mv       = mvs[c0_pos];
+        mv       = tmvp_load_mv(mvs[c0_pos]);
         dist_col = dist_cols[mv.ref_idx];
 
         goto found;
@@ -634,13 +612,13 @@ tmvp_from_l1(const struct InterDRVCtx *const inter_ctx, const struct VVCTMVP *co
     } else if (cand_c1 | cand_c11) {
         int16_t c1_pos = TMVP_POS_IN_BUF2(pos.c1_x, pos.c1_y);
 
-        const OVMV *mvs    = cand_c11 ? tmvp->ctb_mv1
+        const struct TMVPMV *mvs    = cand_c11 ? tmvp->ctb_mv1
                                       : tmvp->ctb_mv0;
 
         const int16_t *dist_cols = cand_c11 ? tmvp->dist_col_1
                                             : tmvp->dist_col_0;
 
-        mv       = mvs[c1_pos];
+        mv       = tmvp_load_mv(mvs[c1_pos]);
         dist_col = dist_cols[mv.ref_idx];
 
         goto found;
@@ -685,9 +663,9 @@ merge_tmvp_from_ldc(const struct InterDRVCtx *const inter_ctx, const struct VVCT
         uint8_t dir = 0;
 
         if (cand_c0 && cand_c01 && !tmvp->col_ref_l0) {
-            const OVMV *mvs    = tmvp->ctb_mv0;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv0;
             const int16_t *dist_cols = tmvp->dist_col_0;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
             dir |= 0x1;
 
@@ -699,7 +677,7 @@ merge_tmvp_from_ldc(const struct InterDRVCtx *const inter_ctx, const struct VVCT
 
             dst[0] = mv;
 
-            mv       = tmvp->ctb_mv1[c0_pos];
+            mv       = tmvp_load_mv(tmvp->ctb_mv1[c0_pos]);
             dist_col = tmvp->dist_col_1[mv.ref_idx];
 
             dir |= 0x2;
@@ -714,9 +692,9 @@ merge_tmvp_from_ldc(const struct InterDRVCtx *const inter_ctx, const struct VVCT
 
             dst[1] = mv;
         } else if (cand_c0 && cand_c01) {
-            const OVMV *mvs    = tmvp->ctb_mv1;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv1;
             const int16_t *dist_cols = tmvp->dist_col_1;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
             dir |= 0x1;
 
@@ -728,7 +706,7 @@ merge_tmvp_from_ldc(const struct InterDRVCtx *const inter_ctx, const struct VVCT
 
             dst[0] = mv;
 
-            mv       = tmvp->ctb_mv0[c0_pos];
+            mv       = tmvp_load_mv(tmvp->ctb_mv0[c0_pos]);
             dist_col = tmvp->dist_col_0[mv.ref_idx];
 
             dir |= 0x2;
@@ -743,9 +721,9 @@ merge_tmvp_from_ldc(const struct InterDRVCtx *const inter_ctx, const struct VVCT
 
             dst[1] = mv;
         } else if (cand_c0) {
-            const OVMV *mvs    = tmvp->ctb_mv0;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv0;
             const int16_t *dist_cols = tmvp->dist_col_0;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
             dir |= 0x1;
 
@@ -757,7 +735,7 @@ merge_tmvp_from_ldc(const struct InterDRVCtx *const inter_ctx, const struct VVCT
 
             dst[0] = mv;
 
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
 
             dir |= 0x2;
 
@@ -772,9 +750,9 @@ merge_tmvp_from_ldc(const struct InterDRVCtx *const inter_ctx, const struct VVCT
             dst[1] = mv;
 
         } else if (cand_c01) {
-            const OVMV *mvs    = tmvp->ctb_mv1;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv1;
             const int16_t *dist_cols = tmvp->dist_col_1;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
 
             dir |= 0x2;
@@ -787,7 +765,7 @@ merge_tmvp_from_ldc(const struct InterDRVCtx *const inter_ctx, const struct VVCT
 
             dst[0] = mv;
 
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
 
             dir |= 0x1;
 
@@ -831,9 +809,9 @@ merge_tmvp_from_l0(const struct InterDRVCtx *const inter_ctx, const struct VVCTM
         uint8_t dir = 0;
 
         if (cand_c0) {
-            const OVMV *mvs    = tmvp->ctb_mv0;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv0;
             const int16_t *dist_cols = tmvp->dist_col_0;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
             dir |= 0x1;
 
@@ -845,7 +823,7 @@ merge_tmvp_from_l0(const struct InterDRVCtx *const inter_ctx, const struct VVCTM
 
             dst[0] = mv;
 
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
 
             dir |= 0x2;
 
@@ -858,9 +836,9 @@ merge_tmvp_from_l0(const struct InterDRVCtx *const inter_ctx, const struct VVCTM
             dst[1] = mv;
 
         } else if (cand_c01) {
-            const OVMV *mvs    = tmvp->ctb_mv1;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv1;
             const int16_t *dist_cols = tmvp->dist_col_1;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
 
             dir |= 0x2;
@@ -873,7 +851,7 @@ merge_tmvp_from_l0(const struct InterDRVCtx *const inter_ctx, const struct VVCTM
 
             dst[0] = mv;
 
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
 
             dir |= 0x1;
 
@@ -916,9 +894,9 @@ merge_tmvp_from_l1(const struct InterDRVCtx *const inter_ctx, const struct VVCTM
         uint8_t dir = 0;
 
         if (cand_c01) {
-            const OVMV *mvs    = tmvp->ctb_mv1;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv1;
             const int16_t *dist_cols = tmvp->dist_col_1;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
             dir |= 0x1;
 
@@ -932,7 +910,7 @@ merge_tmvp_from_l1(const struct InterDRVCtx *const inter_ctx, const struct VVCTM
 
             dir |= 0x2;
 
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
 
             scale = derive_tmvp_scale(dist_ref_opp, dist_col);
 
@@ -942,9 +920,9 @@ merge_tmvp_from_l1(const struct InterDRVCtx *const inter_ctx, const struct VVCTM
 
             dst[1] = mv;
         } else if (cand_c0) {
-            const OVMV *mvs    = tmvp->ctb_mv0;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv0;
             const int16_t *dist_cols = tmvp->dist_col_0;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
 
             dir |= 0x2;
@@ -959,7 +937,7 @@ merge_tmvp_from_l1(const struct InterDRVCtx *const inter_ctx, const struct VVCTM
 
             dir |= 0x1;
 
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
 
             scale = derive_tmvp_scale(dist_ref_opp, dist_col);
 
@@ -1583,9 +1561,9 @@ sbtmvp_from_ldc(const struct InterDRVCtx *inter_ctx, const struct VVCTMVP *const
         uint8_t dir = 0;
 
         if (cand_c0 && cand_c01 && !tmvp->col_ref_l0) {
-            const OVMV *mvs    = tmvp->ctb_mv0;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv0;
             const int16_t *dist_cols = tmvp->dist_col_0;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
             dir |= 0x1;
 
@@ -1599,7 +1577,7 @@ sbtmvp_from_ldc(const struct InterDRVCtx *inter_ctx, const struct VVCTMVP *const
 
             dst[0] = mv;
 
-            mv       = tmvp->ctb_mv1[c0_pos];
+            mv       = tmvp_load_mv(tmvp->ctb_mv1[c0_pos]);
             dist_col = tmvp->dist_col_1[mv.ref_idx];
 
             dir |= 0x2;
@@ -1614,9 +1592,9 @@ sbtmvp_from_ldc(const struct InterDRVCtx *inter_ctx, const struct VVCTMVP *const
 
             dst[1] = mv;
         } else if (cand_c0 && cand_c01) {
-            const OVMV *mvs    = tmvp->ctb_mv1;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv1;
             const int16_t *dist_cols = tmvp->dist_col_1;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
             dir |= 0x1;
 
@@ -1630,7 +1608,7 @@ sbtmvp_from_ldc(const struct InterDRVCtx *inter_ctx, const struct VVCTMVP *const
 
             dst[0] = mv;
 
-            mv       = tmvp->ctb_mv0[c0_pos];
+            mv       = tmvp_load_mv(tmvp->ctb_mv0[c0_pos]);
             dist_col = tmvp->dist_col_0[mv.ref_idx];
 
             dir |= 0x2;
@@ -1645,9 +1623,9 @@ sbtmvp_from_ldc(const struct InterDRVCtx *inter_ctx, const struct VVCTMVP *const
 
             dst[1] = mv;
         } else if (cand_c0) {
-            const OVMV *mvs    = tmvp->ctb_mv0;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv0;
             const int16_t *dist_cols = tmvp->dist_col_0;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
             dir |= 0x1;
 
@@ -1661,7 +1639,7 @@ sbtmvp_from_ldc(const struct InterDRVCtx *inter_ctx, const struct VVCTMVP *const
 
             dst[0] = mv;
 
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
 
             dir |= 0x2;
 
@@ -1676,9 +1654,9 @@ sbtmvp_from_ldc(const struct InterDRVCtx *inter_ctx, const struct VVCTMVP *const
             dst[1] = mv;
 
         } else if (cand_c01) {
-            const OVMV *mvs    = tmvp->ctb_mv1;
+            const struct TMVPMV *mvs    = tmvp->ctb_mv1;
             const int16_t *dist_cols = tmvp->dist_col_1;
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
             dist_col = dist_cols[mv.ref_idx];
 
             dir |= 0x2;
@@ -1693,7 +1671,7 @@ sbtmvp_from_ldc(const struct InterDRVCtx *inter_ctx, const struct VVCTMVP *const
 
             dst[0] = mv;
 
-            mv       = mvs[c0_pos];
+            mv       = tmvp_load_mv(mvs[c0_pos]);
 
             dir |= 0x1;
 
@@ -1721,7 +1699,7 @@ sbtmvp_from_same_rpl(const struct InterDRVCtx *const inter_ctx, const struct VVC
 {
 
     int32_t dist_ref;
-    const OVMV *mvs;
+    const struct TMVPMV *mvs;
     const int16_t *dist_cols;
     uint8_t avail;
     OVMV mv;
@@ -1747,7 +1725,7 @@ sbtmvp_from_same_rpl(const struct InterDRVCtx *const inter_ctx, const struct VVC
     if (avail) {
         int16_t c0_pos = TMVP_POS_IN_BUF2((pos.x >> 2), (pos.y >> 2));
 
-        mv       = mvs[c0_pos];
+        mv       = tmvp_load_mv(mvs[c0_pos]);
         dist_col = dist_cols[mv.ref_idx];
 
         goto found;
@@ -3292,15 +3270,16 @@ rcn_affine_mcp_b_l(OVCTUDec *const ctudec,
                tmvp_mv0[((x0+4*j)>>3) + ((y0+4*i)>>3) *16] = mv0;
                tmvp_mv1[((x0+4*j)>>3) + ((y0+4*i)>>3) *16] = mv1;
             }
-
-            ctudec->rcn_funcs.rcn_mcp_b_l(ctudec, ctudec->rcn_ctx.ctu_buff, inter_ctx, ctudec->part_ctx,
-                        mv0, mv1, x0 + 4*j, y0 + 4*i,
-                        2, 2, inter_dir, ref_idx0, ref_idx1);
         }
 
         mv_buff0 += 34;
         mv_buff1 += 34;
     }
+
+    ctudec->rcn_funcs.rcn_affine_mcp_b_l(ctudec, ctudec->rcn_ctx.ctu_buff, inter_ctx,
+                                         &inter_ctx->mv_ctx0.mvs[pos], &inter_ctx->mv_ctx1.mvs[pos],
+                                         x0, y0, log2_cu_w, log2_cu_h,
+                                         inter_dir, ref_idx0, ref_idx1);
 }
 
 struct PROFInfo {
@@ -3351,16 +3330,17 @@ rcn_affine_prof_mcp_b_l(OVCTUDec *const ctudec,
                 tmvp_mv0[((x0+4*j)>>3) + ((y0+4*i)>>3) *16] = mv0;
                 tmvp_mv1[((x0+4*j)>>3) + ((y0+4*i)>>3) *16] = mv1;
             }
-
-            ctudec->rcn_funcs.rcn_prof_mcp_b_l(ctudec, ctudec->rcn_ctx.ctu_buff, inter_ctx, ctudec->part_ctx,
-                             mv0, mv1, x0 + 4*j, y0 + 4*i,
-                             2, 2, inter_dir, ref_idx0, ref_idx1,
-                             prof_dir, &prof_info);
         }
 
         mv_buff0 += 34;
         mv_buff1 += 34;
     }
+
+    ctudec->rcn_funcs.rcn_affine_prof_mcp_b_l(ctudec, ctudec->rcn_ctx.ctu_buff, inter_ctx,
+                                              &inter_ctx->mv_ctx0.mvs[pos], &inter_ctx->mv_ctx1.mvs[pos],
+                                              x0, y0, log2_cu_w, log2_cu_h,
+                                              inter_dir, ref_idx0, ref_idx1,
+                                              prof_dir, &prof_info);
 }
 
 
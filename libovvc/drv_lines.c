@@ -38,6 +38,7 @@
 #include "dec_structures.h"
 #include "drv_lines.h"
 #include "ovutils.h"
+#include "drv_utils.h"
 #include "ovmem.h"
 #include "overror.h"
 #include "ovdec_internal.h"
@@ -267,6 +268,46 @@ store_ibc_maps(const struct DRVLines *const l,
     memcpy(&ibc_ctx->abv_row[0], &lns->mv[(ctb_x + 1) * nb_units_ctb], sizeof(IBCMV) * (nb_units_ctb));
 }
 
+/* Store the 8x8 MVs of a CTU into a compressed MV plane
+ */
+static void
+tmvp_store_ctb_cmv(struct TMVPMV *dst_mv, const OVMV *src_mv,
+                   int32_t nb_tmvp_unit, int32_t pln_stride)
+{
+    int i, j;
+    for (i = 0; i < nb_tmvp_unit; ++i) {
+        for (j = 0; j < nb_tmvp_unit; ++j) {
+            dst_mv[j] = tmvp_pack_mv(src_mv[j]);
+        }
+        src_mv += 16;
+        dst_mv += pln_stride;
+    }
+}
+
+/* Export full precision 8x8 MVs of a CTU as frame side data
+ * Reference index of blocks without motion in list is set to -1
+ * so MV planes can be read without the direction maps
+ */
+static void
+tmvp_export_ctb_mv(struct OVMotionVector *dst_mv, const OVMV *src_mv,
+                   const uint64_t *dir_map, int32_t nb_tmvp_unit, int32_t pln_stride)
+{
+    int i, j;
+    for (i = 0; i < nb_tmvp_unit; ++i) {
+        for (j = 0; j < nb_tmvp_unit; ++j) {
+            uint64_t col = dir_map[j << 1];
+            struct OVMotionVector *mv = &dst_mv[j];
+
+            mv->x = src_mv[j].x;
+            mv->y = src_mv[j].y;
+            mv->ref_idx = (col >> ((i << 1) + 1)) & 1 ? src_mv[j].ref_idx : -1;
+            memset(mv->reserved, 0, sizeof(mv->reserved));
+        }
+        src_mv += 16;
+        dst_mv += pln_stride;
+    }
+}
+
 static void
 tmvp_store_mv(OVCTUDec *ctudec)
 {
@@ -298,15 +339,15 @@ tmvp_store_mv(OVCTUDec *ctudec)
             uint64_t *dst_map = plane0->dirs + ctb_addr_rs * nb_unit_ctb;
 
             const OVMV *src_mv = inter_ctx->tmvp_mv[0].mvs;
-                  OVMV *dst_mv = plane0->mvs + ctb_offset;
-            int i;
+            struct TMVPMV *dst_mv = plane0->mvs + ctb_offset;
 
             memcpy(dst_map, src_map, sizeof(uint64_t) * nb_unit_ctb);
 
-            for (i = 0; i < nb_tmvp_unit; ++i) {
-                memcpy(dst_mv, src_mv, sizeof(OVMV) * nb_tmvp_unit);
-                src_mv += 16;
-                dst_mv += pln_stride;
+            tmvp_store_ctb_cmv(dst_mv, src_mv, nb_tmvp_unit, pln_stride);
+
+            if (ctudec->side_data) {
+                struct OVMotionVector *sd_mv = ctudec->side_data->mvs[0] + ctb_offset;
+                tmvp_export_ctb_mv(sd_mv, src_mv, dst_map, nb_tmvp_unit, pln_stride);
             }
         }
 
@@ -317,15 +358,15 @@ tmvp_store_mv(OVCTUDec *ctudec)
             uint64_t *dst_map = plane1->dirs + ctb_addr_rs * nb_unit_ctb;
 
             const OVMV *src_mv = inter_ctx->tmvp_mv[1].mvs;
-                  OVMV *dst_mv = plane1->mvs + ctb_offset;
-            int i;
+            struct TMVPMV *dst_mv = plane1->mvs + ctb_offset;
 
             memcpy(dst_map, src_map, sizeof(uint64_t) * nb_unit_ctb);
 
-            for (i = 0; i < nb_tmvp_unit; ++i) {
-                memcpy(dst_mv, src_mv, sizeof(OVMV) * nb_tmvp_unit);
-                src_mv += 16;
-                dst_mv += pln_stride;
+            tmvp_store_ctb_cmv(dst_mv, src_mv, nb_tmvp_unit, pln_stride);
+
+            if (ctudec->side_data) {
+                struct OVMotionVector *sd_mv = ctudec->side_data->mvs[1] + ctb_offset;
+                tmvp_export_ctb_mv(sd_mv, src_mv, dst_map, nb_tmvp_unit, pln_stride);
             }
         }
     }
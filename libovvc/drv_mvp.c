@@ -58,10 +58,6 @@
 
 #define TMVP_POS_IN_BUF2(x,y) ((x >> 1) + (((y >> 1)) * tmvp->pln0_stride))
 
-#define MV_MANTISSA_BITCOUNT 6
-#define MV_MANTISSA_UPPER_LIMIT ((1 << (MV_MANTISSA_BITCOUNT - 1)) - 1)
-#define MV_MANTISSA_LIMIT (1 << (MV_MANTISSA_BITCOUNT - 1))
-
 #define MV_BITS  18
 #define MV_MAX   ((1 << (MV_BITS - 1)) - 1)
 #define MV_MIN  (-(1 << (MV_BITS - 1)))
@@ -112,27 +108,6 @@ mi_cmp(const VVCMergeInfo *const a, const VVCMergeInfo *const b)
     return 0;
 }
 
-/* Compress and uncompress Motion vectors used by TMVP
- * FIXME there might be a more straight forward way of
- * doing this
- */
-static int
-tmvp_round_mv(int32_t val)
-{
-  int sign  = val >> 31;
-
-  if ((val ^ sign) - !!sign > 31) {
-      int scale = floor_log2((val ^ sign) | MV_MANTISSA_UPPER_LIMIT) - (MV_MANTISSA_BITCOUNT - 1);
-      int round = (1 << scale) >> 1;
-      int n     = (val + round) >> scale;
-      int exponent  = scale + ((n ^ sign) >> (MV_MANTISSA_BITCOUNT - 1));
-      int mantissa  = (n & MV_MANTISSA_UPPER_LIMIT) | (sign << (MV_MANTISSA_BITCOUNT - 1));
-      return (mantissa ^ MV_MANTISSA_LIMIT) << (exponent - !!exponent);
-  } else {
-      return val;
-  }
-}
-
 static void
 hmvp_add_cand_1(const struct HMVPLUT *const hmvp_lut,
                 OVMV *const cand_list,
@@ -330,11 +305,14 @@ load_ctb_tmvp(OVCTUDec *const ctudec, int ctb_x, int ctb_y)
         if (plane0 && plane0->dirs) {
             const uint64_t *src_map = plane0->dirs + ctb_addr_rs * nb_unit_ctb;
                   uint64_t *dst_map = tmvp_ctx->dir_map_v0 + 1;
-            const OVMV *src_mvs = plane0->mvs + ctb_offset;
-                  OVMV *dst_mvs = tmvp_ctx->mvs0;
+            const struct TMVPMV *src_mvs = plane0->mvs + ctb_offset;
+                  struct TMVPMV *dst_mvs = tmvp_ctx->mvs0;
             int i;
 
             tmvp_ctx->ctb_mv0 = src_mvs;
+            if (!is_border_pic) {
+                tmvp_prefetch_next_ctb(src_mvs, src_map, nb_tmvp_unit, pln_stride);
+            }
             tmvp_ctx->pln0_stride = pln_stride;
             memcpy(dst_map, src_map, sizeof(uint64_t) * (nb_unit_ctb + !is_border_pic));
             #if 0
@@ -349,13 +327,16 @@ load_ctb_tmvp(OVCTUDec *const ctudec, int ctb_x, int ctb_y)
         if (plane1 && plane1->dirs) {
             const uint64_t *src_map = plane1->dirs + ctb_addr_rs * nb_unit_ctb;
                   uint64_t *dst_map = tmvp_ctx->dir_map_v1 + 1;
-            const OVMV *src_mvs = plane1->mvs + ctb_offset;
-                  OVMV *dst_mvs = tmvp_ctx->mvs1;
+            const struct TMVPMV *src_mvs = plane1->mvs + ctb_offset;
+                  struct TMVPMV *dst_mvs = tmvp_ctx->mvs1;
             int i;
 
             /*FIXME memory could be spared with smaller map size when possible */
             memcpy(dst_map, src_map, sizeof(uint64_t) * (nb_unit_ctb + !is_border_pic));
             tmvp_ctx->ctb_mv1 = src_mvs;
+            if (!is_border_pic) {
+                tmvp_prefetch_next_ctb(src_mvs, src_map, nb_tmvp_unit, pln_stride);
+            }
             tmvp_ctx->pln1_stride = pln_stride;
             tmvp_ctx->pln0_stride = pln_stride;
             #if 0
@@ -434,11 +415,9 @@ derive_tmvp_cand(const struct InterDRVCtx *const inter_ctx, const struct OVMVCtx
         if (cand_c0) {
             /* Candidate 0 in collocated picture 0 */
             int pos_in_buff = TMVP_POS_IN_BUF2(c0_x, c0_y);
-            OVMV c0 = tmvp->ctb_mv0[pos_in_buff];
+            OVMV c0 = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
             int16_t col_ref_idx = c0.ref_idx;
             int16_t scale0 = derive_tmvp_scale(mv_ctx == &inter_ctx->mv_ctx0 ? inter_ctx->dist_ref_0[ref_idx] : inter_ctx->dist_ref_1[ref_idx], tmvp->dist_col_0[col_ref_idx]);
-            c0.x = tmvp_round_mv(c0.x);
-            c0.y = tmvp_round_mv(c0.y);
             c0 = tmvp_scale_mv(scale0, c0);
             c0 = drv_round_to_precision_mv(c0, MV_PRECISION_INTERNAL, prec_amvr);
 
@@ -447,11 +426,9 @@ derive_tmvp_cand(const struct InterDRVCtx *const inter_ctx, const struct OVMVCtx
         } else if (cand_c01) {
             /* Candidate 0 in collocated picture 1 */
             int pos_in_buff = TMVP_POS_IN_BUF2(c0_x, c0_y);
-            OVMV c0 = tmvp->ctb_mv1[pos_in_buff];
+            OVMV c0 = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
             int16_t col_ref_idx = c0.ref_idx;
             int16_t scale1 = derive_tmvp_scale(mv_ctx == &inter_ctx->mv_ctx0 ? inter_ctx->dist_ref_0[ref_idx] : inter_ctx->dist_ref_1[ref_idx], tmvp->dist_col_1[col_ref_idx]);
-            c0.x = tmvp_round_mv(c0.x);
-            c0.y = tmvp_round_mv(c0.y);
             c0 = tmvp_scale_mv(scale1, c0);
             c0 = drv_round_to_precision_mv(c0, MV_PRECISION_INTERNAL, prec_amvr);
             c0.ref_idx = ref_idx;
@@ -459,11 +436,9 @@ derive_tmvp_cand(const struct InterDRVCtx *const inter_ctx, const struct OVMVCtx
         } else if (cand_c1) {
             /* Candidate 1 in collocated picture 0 */
             int pos_in_buff = TMVP_POS_IN_BUF2(c1_x, c1_y);
-            OVMV c1 = tmvp->ctb_mv0[pos_in_buff];
+            OVMV c1 = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
             int16_t col_ref_idx = c1.ref_idx;
             int16_t scale0 = derive_tmvp_scale(mv_ctx == &inter_ctx->mv_ctx0 ? inter_ctx->dist_ref_0[ref_idx] : inter_ctx->dist_ref_1[ref_idx], tmvp->dist_col_0[col_ref_idx]);
-            c1.x = tmvp_round_mv(c1.x);
-            c1.y = tmvp_round_mv(c1.y);
             c1 = tmvp_scale_mv(scale0, c1);
             c1 = drv_round_to_precision_mv(c1, MV_PRECISION_INTERNAL, prec_amvr);
             c1.ref_idx = ref_idx;
@@ -471,11 +446,9 @@ derive_tmvp_cand(const struct InterDRVCtx *const inter_ctx, const struct OVMVCtx
         } else if (cand_c11) {
             /* Candidate 1 in collocated picture 1 */
             int pos_in_buff = TMVP_POS_IN_BUF2(c1_x, c1_y);
-            OVMV c1 = tmvp->ctb_mv1[pos_in_buff];
+            OVMV c1 = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
             int16_t col_ref_idx = c1.ref_idx;
             int16_t scale1 = derive_tmvp_scale(mv_ctx == &inter_ctx->mv_ctx0 ? inter_ctx->dist_ref_0[ref_idx] : inter_ctx->dist_ref_1[ref_idx], tmvp->dist_col_1[col_ref_idx]);
-            c1.x = tmvp_round_mv(c1.x);
-            c1.y = tmvp_round_mv(c1.y);
             c1 = tmvp_scale_mv(scale1, c1);
             c1 = drv_round_to_precision_mv(c1, MV_PRECISION_INTERNAL, prec_amvr);
             c1.ref_idx = ref_idx;
@@ -487,11 +460,9 @@ derive_tmvp_cand(const struct InterDRVCtx *const inter_ctx, const struct OVMVCtx
         if (cand_c01) {
             /* Candidate 0 in collocated picture 1 */
             int pos_in_buff = TMVP_POS_IN_BUF2(c0_x, c0_y);
-            OVMV c0 = tmvp->ctb_mv1[pos_in_buff];
+            OVMV c0 = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
             int16_t col_ref_idx = c0.ref_idx;
             int16_t scale1 = derive_tmvp_scale(mv_ctx == &inter_ctx->mv_ctx0 ? inter_ctx->dist_ref_0[ref_idx] : inter_ctx->dist_ref_1[ref_idx], tmvp->dist_col_1[col_ref_idx]);
-            c0.x = tmvp_round_mv(c0.x);
-            c0.y = tmvp_round_mv(c0.y);
             c0 = tmvp_scale_mv(scale1, c0);
             c0 = drv_round_to_precision_mv(c0, MV_PRECISION_INTERNAL, prec_amvr);
             c0.ref_idx = ref_idx;
@@ -499,11 +470,9 @@ derive_tmvp_cand(const struct InterDRVCtx *const inter_ctx, const struct OVMVCtx
         } else if (cand_c0) {
             /* Candidate 0 in collocated picture 0 */
             int pos_in_buff = TMVP_POS_IN_BUF2(c0_x, c0_y);
-            OVMV c0 = tmvp->ctb_mv0[pos_in_buff];
+            OVMV c0 = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
             int16_t col_ref_idx = c0.ref_idx;
             int16_t scale0 = derive_tmvp_scale(mv_ctx == &inter_ctx->mv_ctx0 ? inter_ctx->dist_ref_0[ref_idx] : inter_ctx->dist_ref_1[ref_idx], tmvp->dist_col_0[col_ref_idx]);
-            c0.x = tmvp_round_mv(c0.x);
-            c0.y = tmvp_round_mv(c0.y);
             c0 = tmvp_scale_mv(scale0, c0);
             c0 = drv_round_to_precision_mv(c0, MV_PRECISION_INTERNAL, prec_amvr);
             c0.ref_idx = ref_idx;
@@ -511,11 +480,9 @@ derive_tmvp_cand(const struct InterDRVCtx *const inter_ctx, const struct OVMVCtx
         } else if (cand_c11) {
             /* Candidate 1 in collocated picture 1 */
             int pos_in_buff = TMVP_POS_IN_BUF2(c1_x, c1_y);
-            OVMV c1 = tmvp->ctb_mv1[pos_in_buff];
+            OVMV c1 = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
             int16_t col_ref_idx = c1.ref_idx;
             int16_t scale1 = derive_tmvp_scale(mv_ctx == &inter_ctx->mv_ctx0 ? inter_ctx->dist_ref_0[ref_idx] : inter_ctx->dist_ref_1[ref_idx], tmvp->dist_col_1[col_ref_idx]);
-            c1.x = tmvp_round_mv(c1.x);
-            c1.y = tmvp_round_mv(c1.y);
             c1 = tmvp_scale_mv(scale1, c1);
             c1 = drv_round_to_precision_mv(c1, MV_PRECISION_INTERNAL, prec_amvr);
             c1.ref_idx = ref_idx;
@@ -523,11 +490,9 @@ derive_tmvp_cand(const struct InterDRVCtx *const inter_ctx, const struct OVMVCtx
         } else if (cand_c1) {
             /* Candidate 1 in collocated picture 0 */
             int pos_in_buff = TMVP_POS_IN_BUF2(c1_x, c1_y);
-            OVMV c1 = tmvp->ctb_mv0[pos_in_buff];
+            OVMV c1 = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
             int16_t col_ref_idx = c1.ref_idx;
             int16_t scale0 = derive_tmvp_scale(mv_ctx == &inter_ctx->mv_ctx0 ? inter_ctx->dist_ref_0[ref_idx] : inter_ctx->dist_ref_1[ref_idx], tmvp->dist_col_0[col_ref_idx]);
-            c1.x = tmvp_round_mv(c1.x);
-            c1.y = tmvp_round_mv(c1.y);
             c1 = tmvp_scale_mv(scale0, c1);
             c1 = drv_round_to_precision_mv(c1, MV_PRECISION_INTERNAL, prec_amvr);
             c1.ref_idx = ref_idx;
@@ -791,11 +756,9 @@ vvc_derive_merge_mvp(const struct InterDRVCtx *const inter_ctx,
 
         if (cand_c0) {
             int pos_in_buff = TMVP_POS_IN_BUF2(c0_x, c0_y);
-            OVMV c0 = tmvp->ctb_mv0[pos_in_buff];
+            OVMV c0 = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
             uint8_t col_ref_idx = c0.ref_idx;
             int16_t scale = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_0[col_ref_idx]);
-            c0.x = tmvp_round_mv(c0.x);
-            c0.y = tmvp_round_mv(c0.y);
             c0 = tmvp_scale_mv(scale, c0);
             c0.bcw_idx_plus1 = 0;
             c0.prec_amvr = 0;
@@ -806,11 +769,9 @@ vvc_derive_merge_mvp(const struct InterDRVCtx *const inter_ctx,
 
         } else if (cand_c01) {
             int pos_in_buff = TMVP_POS_IN_BUF2(c0_x, c0_y);
-            OVMV c0 = tmvp->ctb_mv1[pos_in_buff];
+            OVMV c0 = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
             uint8_t col_ref_idx = c0.ref_idx;
             int16_t scale = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_1[col_ref_idx]);
-            c0.x = tmvp_round_mv(c0.x);
-            c0.y = tmvp_round_mv(c0.y);
             c0 = tmvp_scale_mv(scale, c0);
             c0.bcw_idx_plus1 = 0;
             c0.prec_amvr = 0;
@@ -820,11 +781,9 @@ vvc_derive_merge_mvp(const struct InterDRVCtx *const inter_ctx,
                 return c0;
         } else if (cand_c1) {
             int pos_in_buff = TMVP_POS_IN_BUF2(c1_x, c1_y);
-            OVMV c1 = tmvp->ctb_mv0[pos_in_buff];
+            OVMV c1 = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
             uint8_t col_ref_idx = c1.ref_idx;
             int16_t scale = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_0[col_ref_idx]);
-            c1.x = tmvp_round_mv(c1.x);
-            c1.y = tmvp_round_mv(c1.y);
             c1 = tmvp_scale_mv(scale , c1);
             c1.bcw_idx_plus1 = 0;
             c1.prec_amvr = 0;
@@ -834,11 +793,9 @@ vvc_derive_merge_mvp(const struct InterDRVCtx *const inter_ctx,
                 return c1;
         } else if (cand_c11) {
             int pos_in_buff = TMVP_POS_IN_BUF2(c1_x, c1_y);
-            OVMV c1 = tmvp->ctb_mv1[pos_in_buff];
+            OVMV c1 = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
             uint8_t col_ref_idx = c1.ref_idx;
             int16_t scale = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_1[col_ref_idx]);
-            c1.x = tmvp_round_mv(c1.x);
-            c1.y = tmvp_round_mv(c1.y);
             c1 = tmvp_scale_mv(scale , c1);
             c1.bcw_idx_plus1 = 0;
             c1.prec_amvr = 0;
@@ -1060,20 +1017,16 @@ vvc_derive_merge_mvp_b(const struct InterDRVCtx *const inter_ctx,
                 int pos_in_buff = TMVP_POS_IN_BUF2(c0_x, c0_y);
                 cand[nb_cand].inter_dir = 3;
                 if (cand_c0) {
-                    OVMV c0  = tmvp->ctb_mv0[pos_in_buff];
+                    OVMV c0  = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
                     uint8_t col_ref_idx = c0.ref_idx;
                     int16_t scale00 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_0[col_ref_idx]);
                     int16_t scale10 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_0[col_ref_idx]);
-                    c0.x = tmvp_round_mv(c0.x);
-                    c0.y = tmvp_round_mv(c0.y);
                     cand[nb_cand].mv0 = tmvp_scale_mv(scale00, c0);
                     cand[nb_cand].mv0.ref_idx = 0;
                     if (cand_c01 && tmvp->ldc) {
-                        OVMV c01  = tmvp->ctb_mv1[pos_in_buff];
+                        OVMV c01  = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
                         col_ref_idx = c01.ref_idx;
                         int16_t scale11 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_1[col_ref_idx]);
-                        c01.x = tmvp_round_mv(c01.x);
-                        c01.y = tmvp_round_mv(c01.y);
                         cand[nb_cand].mv1 = tmvp_scale_mv(scale11, c01);
                         cand[nb_cand].mv1.ref_idx = 0;
                     } else {
@@ -1087,12 +1040,10 @@ vvc_derive_merge_mvp_b(const struct InterDRVCtx *const inter_ctx,
                     if (nb_cand++ == merge_idx)
                         return cand[merge_idx];
                 } else {
-                    OVMV c0  = tmvp->ctb_mv1[pos_in_buff];
+                    OVMV c0  = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
                     uint8_t col_ref_idx = c0.ref_idx;
                     int16_t scale01 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_1[col_ref_idx]);
                     int16_t scale11 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_1[col_ref_idx]);
-                    c0.x = tmvp_round_mv(c0.x);
-                    c0.y = tmvp_round_mv(c0.y);
                     cand[nb_cand].mv0 = tmvp_scale_mv(scale01, c0);
                     cand[nb_cand].mv1 = tmvp_scale_mv(scale11, c0);
                     cand[nb_cand].mv0.ref_idx = 0;
@@ -1108,20 +1059,16 @@ vvc_derive_merge_mvp_b(const struct InterDRVCtx *const inter_ctx,
                 int pos_in_buff = TMVP_POS_IN_BUF2(c1_x, c1_y);
                 cand[nb_cand].inter_dir = 3;
                 if (cand_c1) {
-                    OVMV c1  = tmvp->ctb_mv0[pos_in_buff];
+                    OVMV c1  = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
                     uint8_t col_ref_idx = c1.ref_idx;
                     int16_t scale00 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_0[col_ref_idx]);
                     int16_t scale10 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_0[col_ref_idx]);
-                    c1.x = tmvp_round_mv(c1.x);
-                    c1.y = tmvp_round_mv(c1.y);
                     cand[nb_cand].mv0 = tmvp_scale_mv(scale00, c1);
                     cand[nb_cand].mv0.ref_idx = 0;
                     if (cand_c11 && tmvp->ldc) {
-                        OVMV c11  = tmvp->ctb_mv1[pos_in_buff];
+                        OVMV c11  = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
                         col_ref_idx = c11.ref_idx;
                         int16_t scale11 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_1[col_ref_idx]);
-                        c11.x = tmvp_round_mv(c11.x);
-                        c11.y = tmvp_round_mv(c11.y);
                         cand[nb_cand].mv1 = tmvp_scale_mv(scale11, c11);
                         cand[nb_cand].mv1.ref_idx = 0;
                     } else {
@@ -1135,12 +1082,10 @@ vvc_derive_merge_mvp_b(const struct InterDRVCtx *const inter_ctx,
                     if (nb_cand++ == merge_idx)
                         return cand[merge_idx];
                 } else {
-                    OVMV c1  = tmvp->ctb_mv1[pos_in_buff];
+                    OVMV c1  = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
                     uint8_t col_ref_idx = c1.ref_idx;
                     int16_t scale01 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_1[col_ref_idx]);
                     int16_t scale11 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_1[col_ref_idx]);
-                    c1.x = tmvp_round_mv(c1.x);
-                    c1.y = tmvp_round_mv(c1.y);
                     cand[nb_cand].mv0 = tmvp_scale_mv(scale01, c1);
                     cand[nb_cand].mv1 = tmvp_scale_mv(scale11, c1);
                     cand[nb_cand].mv0.ref_idx = 0;
@@ -1158,21 +1103,17 @@ vvc_derive_merge_mvp_b(const struct InterDRVCtx *const inter_ctx,
                 int pos_in_buff = TMVP_POS_IN_BUF2(c0_x, c0_y);
                 cand[nb_cand].inter_dir = 3;
                 if (cand_c01) {
-                    OVMV c0  = tmvp->ctb_mv1[pos_in_buff];
+                    OVMV c0  = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
                     uint8_t col_ref_idx = c0.ref_idx;
                     int16_t scale01 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_1[col_ref_idx]);
                     int16_t scale11 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_1[col_ref_idx]);
-                    c0.x = tmvp_round_mv(c0.x);
-                    c0.y = tmvp_round_mv(c0.y);
                     cand[nb_cand].mv1 = tmvp_scale_mv(scale11, c0);
                     cand[nb_cand].mv1.ref_idx = 0;
 
                     if (cand_c0 && tmvp->ldc) {
-                        OVMV c00  = tmvp->ctb_mv0[pos_in_buff];
+                        OVMV c00  = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
                         col_ref_idx = c00.ref_idx;
                         int16_t scale00 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_0[col_ref_idx]);
-                        c00.x = tmvp_round_mv(c00.x);
-                        c00.y = tmvp_round_mv(c00.y);
                         cand[nb_cand].mv0 = tmvp_scale_mv(scale00, c00);
                         cand[nb_cand].mv0.ref_idx = 0;
                     } else {
@@ -1186,12 +1127,10 @@ vvc_derive_merge_mvp_b(const struct InterDRVCtx *const inter_ctx,
                     if (nb_cand++ == merge_idx)
                         return cand[merge_idx];
                 } else {
-                    OVMV c0  = tmvp->ctb_mv0[pos_in_buff];
+                    OVMV c0  = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
                     uint8_t col_ref_idx = c0.ref_idx;
                     int16_t scale00 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_0[col_ref_idx]);
                     int16_t scale10 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_0[col_ref_idx]);
-                    c0.x = tmvp_round_mv(c0.x);
-                    c0.y = tmvp_round_mv(c0.y);
                     cand[nb_cand].mv0 = tmvp_scale_mv(scale00, c0);
                     cand[nb_cand].mv1 = tmvp_scale_mv(scale10, c0);
                     cand[nb_cand].mv0.ref_idx = 0;
@@ -1207,21 +1146,17 @@ vvc_derive_merge_mvp_b(const struct InterDRVCtx *const inter_ctx,
                 int pos_in_buff = TMVP_POS_IN_BUF2(c1_x, c1_y);
                 cand[nb_cand].inter_dir = 3;
                 if (cand_c11) {
-                    OVMV c1  = tmvp->ctb_mv1[pos_in_buff];
+                    OVMV c1  = tmvp_load_mv(tmvp->ctb_mv1[pos_in_buff]);
                     uint8_t col_ref_idx = c1.ref_idx;
                     int16_t scale01 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_1[col_ref_idx]);
                     int16_t scale11 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_1[col_ref_idx]);
-                    c1.x = tmvp_round_mv(c1.x);
-                    c1.y = tmvp_round_mv(c1.y);
                     cand[nb_cand].mv1 = tmvp_scale_mv(scale11, c1);
                     cand[nb_cand].mv1.ref_idx = 0;
 
                     if (cand_c1 && tmvp->ldc) {
-                        OVMV c10  = tmvp->ctb_mv0[pos_in_buff];
+                        OVMV c10  = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
                         col_ref_idx = c10.ref_idx;
                         int16_t scale00 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_0[col_ref_idx]);
-                        c10.x = tmvp_round_mv(c10.x);
-                        c10.y = tmvp_round_mv(c10.y);
                         cand[nb_cand].mv0 = tmvp_scale_mv(scale00, c10);
                         cand[nb_cand].mv0.ref_idx = 0;
                     } else {
@@ -1235,12 +1170,10 @@ vvc_derive_merge_mvp_b(const struct InterDRVCtx *const inter_ctx,
                     if (nb_cand++ == merge_idx)
                         return cand[merge_idx];
                 } else {
-                    OVMV c1  = tmvp->ctb_mv0[pos_in_buff];
+                    OVMV c1  = tmvp_load_mv(tmvp->ctb_mv0[pos_in_buff]);
                     uint8_t col_ref_idx = c1.ref_idx;
                     int16_t scale00 = derive_tmvp_scale(inter_ctx->dist_ref_0[0], tmvp->dist_col_0[col_ref_idx]);
                     int16_t scale10 = derive_tmvp_scale(inter_ctx->dist_ref_1[0], tmvp->dist_col_0[col_ref_idx]);
-                    c1.x = tmvp_round_mv(c1.x);
-                    c1.y = tmvp_round_mv(c1.y);
                     cand[nb_cand].mv0 = tmvp_scale_mv(scale00, c1);
                     cand[nb_cand].mv1 = tmvp_scale_mv(scale10, c1);
                     cand[nb_cand].mv0.ref_idx = 0;
@@ -42,6 +42,88 @@
 
 /*FIXME Must be included after ctudec*/
 
+#define MV_MANTISSA_BITCOUNT 6
+#define MV_MANTISSA_UPPER_LIMIT ((1 << (MV_MANTISSA_BITCOUNT - 1)) - 1)
+#define MV_MANTISSA_LIMIT (1 << (MV_MANTISSA_BITCOUNT - 1))
+
+/* Convert a MV component to the mantissa / exponent
+ * representation used for collocated MV storage
+ */
+static inline int16_t
+tmvp_compress_mv(int32_t val)
+{
+    int sign  = val >> 31;
+    int scale = floor_log2((val ^ sign) | MV_MANTISSA_UPPER_LIMIT) - (MV_MANTISSA_BITCOUNT - 1);
+
+    if (scale >= 0) {
+        int round    = (1 << scale) >> 1;
+        int n        = (val + round) >> scale;
+        int exponent = scale + ((n ^ sign) >> (MV_MANTISSA_BITCOUNT - 1));
+        int mantissa = (n & MV_MANTISSA_UPPER_LIMIT) | (sign << (MV_MANTISSA_BITCOUNT - 1));
+        return (mantissa << 4) | exponent;
+    }
+
+    return val << 4;
+}
+
+static inline int32_t
+tmvp_uncompress_mv(int16_t val)
+{
+    int exponent = val & 0xF;
+    int mantissa = val >> 4;
+
+    return exponent ? (mantissa ^ MV_MANTISSA_LIMIT) << (exponent - 1) : mantissa;
+}
+
+static inline struct TMVPMV
+tmvp_pack_mv(OVMV mv)
+{
+    struct TMVPMV cmv;
+
+    cmv.x = tmvp_compress_mv(mv.x);
+    cmv.y = tmvp_compress_mv(mv.y);
+    cmv.ref_idx = mv.ref_idx;
+
+    return cmv;
+}
+
+/* Collocated MV with its rounded full precision components */
+static inline OVMV
+tmvp_load_mv(struct TMVPMV cmv)
+{
+    OVMV mv;
+
+    mv.x = tmvp_uncompress_mv(cmv.x);
+    mv.y = tmvp_uncompress_mv(cmv.y);
+    mv.ref_idx = cmv.ref_idx;
+    mv.bcw_idx_plus1 = 0;
+    mv.prec_amvr = 0;
+
+    return mv;
+}
+
+/* Prefetch collocated MVs and direction maps of the CTU following
+ * the current one so they are in cache when it is decoded
+ */
+static inline void
+tmvp_prefetch_next_ctb(const struct TMVPMV *ctb_mv, const uint64_t *ctb_dirs,
+                       int32_t nb_tmvp_unit, int32_t pln_stride)
+{
+    const struct TMVPMV *next_mv = ctb_mv + nb_tmvp_unit;
+    const uint64_t *next_dirs = ctb_dirs + (nb_tmvp_unit << 1);
+    int i;
+
+    for (i = 0; i < nb_tmvp_unit; ++i) {
+        ov_prefetch(next_mv);
+        ov_prefetch(next_mv + nb_tmvp_unit - 1);
+        next_mv += pln_stride;
+    }
+
+    for (i = 0; i < (nb_tmvp_unit << 1); i += 8) {
+        ov_prefetch(next_dirs + i);
+    }
+}
+
 /* Set bit fields to 1 for a PB at coordinates x_pb y_pb
  */
 static inline void
@@ -42,6 +42,12 @@ static void ovmempool_free(MemPool *mpool);
 
 MemPool *
 ovmempool_init(size_t elem_size)
+{
+    return ovmempool_init_on_node(elem_size, -1);
+}
+
+MemPool *
+ovmempool_init_on_node(size_t elem_size, int node)
 {
     struct MemPool *mpool = ov_mallocz(sizeof(*mpool));
     if (!mpool) {
@@ -50,6 +56,10 @@ ovmempool_init(size_t elem_size)
 
     mpool->elem_size = elem_size;
 
+    /* Elements data will be allocated on this NUMA node
+       if node is positive */
+    mpool->node = node;
+
     /* The pool keeps a ref to itself so we avoid freeing it
        while some of its elements can still point to it
        the pool will be freed only when all allocated elements
@@ -78,7 +88,7 @@ ovmempool_popelem(MemPool *mpool)
            without knowledge of responsible mempool */
         elem->mempool = mpool;
 
-        elem->data = ov_mallocz(mpool->elem_size);
+        elem->data = ov_mallocz_on_node(mpool->elem_size, mpool->node);
         if (!elem->data) {
             ov_freep(&elem);
             goto ret_and_unlock;
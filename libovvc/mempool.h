@@ -42,6 +42,8 @@ typedef struct MemPool MemPool;
 
 MemPool *ovmempool_init(size_t elem_size);
 
+MemPool *ovmempool_init_on_node(size_t elem_size, int node);
+
 MemPoolElem *ovmempool_popelem(MemPool *mpool);
 
 void ovmempool_pushelem(MemPoolElem *released_elem);
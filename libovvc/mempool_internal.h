@@ -48,6 +48,7 @@ struct MemPool
     struct MemPoolElem *stack_elem;
     size_t elem_size;
     int nb_ref;
+    int node;
     pthread_mutex_t pool_mtx;
 };
 
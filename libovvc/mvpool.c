@@ -38,6 +38,7 @@
 #include "mempool.h"
 #include "mempool_internal.h"
 #include "overror.h"
+#include "ovframe.h"
 
 /*FIXME only for MV declaration which should be
  * declared somewhere else
@@ -48,17 +49,45 @@
 #define LOG2_MIN_CU_S 2
 #define LOG2_MIN_MV_STORAGE 3
 
-static int
-init_mv_pool(struct MVPool *const mv_pool, const struct PicPartInfo *const pinfo)
+static size_t
+mv_plane_size(const struct PicPartInfo *const pinfo)
 {
     size_t   nb_ctb_pic = (size_t) pinfo->nb_ctb_w * pinfo->nb_ctb_h;
     uint16_t nb_pb_ctb_w = (1 << pinfo->log2_ctu_s) >> LOG2_MIN_MV_STORAGE;
 
-    size_t elem_size = nb_ctb_pic * sizeof(OVMV) * nb_pb_ctb_w * nb_pb_ctb_w;
+    return nb_ctb_pic * sizeof(struct TMVPMV) * nb_pb_ctb_w * nb_pb_ctb_w;
+}
+
+static size_t
+dir_field_size(const struct PicPartInfo *const pinfo)
+{
+    size_t nb_ctb_pic = (size_t) pinfo->nb_ctb_w * pinfo->nb_ctb_h;
+    uint8_t nb_pb_ctb_w = (1 << pinfo->log2_ctu_s) >> LOG2_MIN_CU_S;
+
+    return nb_ctb_pic * sizeof(uint64_t) * nb_pb_ctb_w;
+}
+
+static size_t
+info_plane_size(const struct PicPartInfo *const pinfo)
+{
+    size_t   nb_ctb_pic = (size_t) pinfo->nb_ctb_w * pinfo->nb_ctb_h;
+    uint16_t nb_blk_ctb_w = (1 << pinfo->log2_ctu_s) >> LOG2_MIN_CU_S;
+    uint16_t nb_mv_ctb_w  = (1 << pinfo->log2_ctu_s) >> LOG2_MIN_MV_STORAGE;
+
+    /* Full precision MVs of both lists follow block information */
+    return sizeof(struct OVFrameSideData) +
+           nb_ctb_pic * sizeof(struct OVBlockInfo) * nb_blk_ctb_w * nb_blk_ctb_w +
+           nb_ctb_pic * sizeof(struct OVMotionVector) * nb_mv_ctb_w * nb_mv_ctb_w * 2;
+}
+
+static int
+init_mv_pool(struct MVPool *const mv_pool, const struct PicPartInfo *const pinfo)
+{
+    size_t elem_size = mv_plane_size(pinfo);
 
     mv_pool->mv_pool = ovmempool_init(elem_size);
 
-    if (!mv_pool->dir_pool) {
+    if (!mv_pool->mv_pool) {
        return OVVC_ENOMEM;
     }
 
@@ -68,9 +97,7 @@ init_mv_pool(struct MVPool *const mv_pool, const struct PicPartInfo *const pinfo
 static int
 init_dir_field_pool(struct MVPool *const mv_pool, const struct PicPartInfo *const pinfo)
 {
-    size_t nb_ctb_pic = (size_t) pinfo->nb_ctb_w * pinfo->nb_ctb_h;
-    uint8_t nb_pb_ctb_w = (1 << pinfo->log2_ctu_s) >> LOG2_MIN_CU_S;
-    size_t elem_size = nb_ctb_pic * sizeof(uint64_t) * nb_pb_ctb_w;
+    size_t elem_size = dir_field_size(pinfo);
 
     mv_pool->dir_pool = ovmempool_init(elem_size);
 
@@ -81,8 +108,23 @@ init_dir_field_pool(struct MVPool *const mv_pool, const struct PicPartInfo *cons
     return 0;
 }
 
+static int
+init_info_pool(struct MVPool *const mv_pool, const struct PicPartInfo *const pinfo)
+{
+    size_t elem_size = info_plane_size(pinfo);
+
+    mv_pool->info_pool = ovmempool_init(elem_size);
+
+    if (!mv_pool->info_pool) {
+       return OVVC_ENOMEM;
+    }
+
+    return 0;
+}
+
 int
-mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo)
+mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo,
+            uint8_t export_side_data)
 {
     struct MVPool *mv_pool;
     int ret;
@@ -104,8 +146,18 @@ mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo)
         goto fail_mv;
     }
 
+    if (export_side_data) {
+        ret = init_info_pool(mv_pool, pinfo);
+        if (ret < 0) {
+            goto fail_info;
+        }
+    }
+
     return 0;
 
+fail_info :
+    ovmempool_uninit(&mv_pool->mv_pool);
+
 fail_mv :
     ovmempool_uninit(&mv_pool->dir_pool);
 
@@ -115,6 +167,22 @@ fail_field :
     return OVVC_ENOMEM;
 }
 
+/* Check if MV planes from the pool are large enough for
+ * pictures with the given partition information
+ */
+int
+mvpool_fits(const struct MVPool *mv_pool, const struct PicPartInfo *const pinfo,
+            uint8_t export_side_data)
+{
+    if (export_side_data && (!mv_pool->info_pool ||
+        mv_pool->info_pool->elem_size < info_plane_size(pinfo))) {
+        return 0;
+    }
+
+    return mv_pool->mv_pool->elem_size  >= mv_plane_size(pinfo) &&
+           mv_pool->dir_pool->elem_size >= dir_field_size(pinfo);
+}
+
 void
 mvpool_uninit(struct MVPool **mv_pool_p)
 {
@@ -124,6 +192,10 @@ mvpool_uninit(struct MVPool **mv_pool_p)
 
     ovmempool_uninit(&mv_pool->mv_pool);
 
+    if (mv_pool->info_pool) {
+        ovmempool_uninit(&mv_pool->info_pool);
+    }
+
     ov_freep(mv_pool_p);
 }
 
@@ -164,7 +236,55 @@ mvpool_release_mv_plane(struct MVPlane *mv_plane)
 
     ovmempool_pushelem(mv_plane->dir_elem);
 
+    mv_plane->mv_elem  = NULL;
+    mv_plane->dir_elem = NULL;
+
     mv_plane->mvs  = NULL;
 
     mv_plane->dirs = NULL;
 }
+
+/* Attach a block information plane and full precision MV planes
+ * to the frame of a picture.
+ * MV planes are only set for lists the picture stores motion for.
+ */
+int
+mvpool_attach_side_data(struct MVPool *mv_pool, struct Frame *frame,
+                        struct MVPlane *mv_plane0, struct MVPlane *mv_plane1,
+                        const struct PicPartInfo *const pinfo)
+{
+    struct FrameInternal *const internal = &frame->internal;
+    struct OVFrameSideData *side_data;
+    MemPoolElem *info_elem;
+    struct OVMotionVector *mvs;
+    size_t nb_mvs;
+    uint16_t nb_blk_ctb = (1 << pinfo->log2_ctu_s) >> LOG2_MIN_CU_S;
+    uint16_t nb_mv_ctb  = (1 << pinfo->log2_ctu_s) >> LOG2_MIN_MV_STORAGE;
+
+    info_elem = ovmempool_popelem(mv_pool->info_pool);
+    if (!info_elem) {
+        return OVVC_ENOMEM;
+    }
+
+    side_data = info_elem->data;
+
+    side_data->nb_blk_w   = pinfo->nb_ctb_w * nb_blk_ctb;
+    side_data->nb_blk_h   = pinfo->nb_ctb_h * nb_blk_ctb;
+    side_data->blk_stride = side_data->nb_blk_w;
+    side_data->blk_info   = (struct OVBlockInfo *)(side_data + 1);
+
+    side_data->nb_mv_w   = pinfo->nb_ctb_w * nb_mv_ctb;
+    side_data->nb_mv_h   = pinfo->nb_ctb_h * nb_mv_ctb;
+    side_data->mv_stride = side_data->nb_mv_w;
+    mvs = (struct OVMotionVector *)(side_data->blk_info + (size_t)side_data->nb_blk_w * side_data->nb_blk_h);
+    nb_mvs = (size_t)side_data->nb_mv_w * side_data->nb_mv_h;
+
+    side_data->mvs[0] = mv_plane0->dirs ? mvs          : NULL;
+    side_data->mvs[1] = mv_plane1->dirs ? mvs + nb_mvs : NULL;
+
+    internal->sd_elem[0] = info_elem;
+
+    frame->side_data = side_data;
+
+    return 0;
+}
@@ -43,6 +43,16 @@
 #define OV_MAX_NUM_PPS 16
 #define OV_MAX_NUM_APS 16
 
+/* Maximum tile grid allowed by levels 6.x
+ */
+#define OV_MAX_TILE_COLS 20
+#define OV_MAX_TILE_ROWS 22
+#define OV_MAX_NB_TILES (OV_MAX_TILE_COLS * OV_MAX_TILE_ROWS)
+
+/* Maximum number of slices per picture allowed by levels 6.x
+ */
+#define OV_MAX_NB_SLICES 1000
+
 struct OVNVCLCtx
 {
     /* TODO use an other typedef to store more info in
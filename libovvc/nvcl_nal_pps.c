@@ -60,9 +60,22 @@ storage_in_nvcl_ctx(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
 }
 
 static int
-validate_pps(OVNVCLReader *rdr, const union HLSData *const pps)
+validate_pps(OVNVCLReader *rdr, const union HLSData *const data)
 {
     /* TODO various check on limitation and max sizes */
+    const OVPPS *const pps = (const OVPPS *)data;
+
+    if (pps->pps_num_tile_columns_minus1 >= OV_MAX_TILE_COLS ||
+        pps->pps_num_tile_rows_minus1 >= OV_MAX_TILE_ROWS) {
+        ov_log(NULL, OVLOG_ERROR, "Tile grid exceeds level limits\n");
+        return OVVC_EINDATA;
+    }
+
+    if (pps->pps_num_slices_in_pic_minus1 >= OV_MAX_NB_SLICES) {
+        ov_log(NULL, OVLOG_ERROR, "Number of slices in picture exceeds level limits\n");
+        return OVVC_EINDATA;
+    }
+
     return 1;
 }
 
@@ -101,9 +114,17 @@ pps_read_slices_in_subpic(OVNVCLReader *const rdr, OVPPS *const pps)
 {
     int i;
     int tile_id = 0;
+    uint32_t num_slices_in_pic_minus1;
 
     /* FIXME not tested */
-    pps->pps_num_slices_in_pic_minus1 = nvcl_read_u_expgolomb(rdr);
+    num_slices_in_pic_minus1 = nvcl_read_u_expgolomb(rdr);
+
+    /* Out of range values are rejected by validate_pps */
+    pps->pps_num_slices_in_pic_minus1 = OVMIN(num_slices_in_pic_minus1, OV_MAX_NB_SLICES);
+    if (pps->pps_num_slices_in_pic_minus1 >= OV_MAX_NB_SLICES) {
+        return;
+    }
+
     if (pps->pps_num_slices_in_pic_minus1 > 1){
         pps->pps_tile_idx_delta_present_flag = nvcl_read_flag(rdr);
     }
@@ -130,7 +151,7 @@ pps_read_slices_in_subpic(OVNVCLReader *const rdr, OVPPS *const pps)
                 pps->pps_num_exp_slices_in_tile[i] = nvcl_read_u_expgolomb(rdr);
                 if (pps->pps_num_exp_slices_in_tile[i]){
                     int j;
-                    for (j = 0; j < pps->pps_num_exp_slices_in_tile[i]; j++){
+                    for (j = 0; j < pps->pps_num_exp_slices_in_tile[i] && i + j < OV_MAX_NB_SLICES; j++){
                         pps->pps_exp_slice_height_in_ctus_minus1[i + j] = nvcl_read_u_expgolomb(rdr);
                     }
                     i += (j - 1);
@@ -183,14 +204,15 @@ pps_implicit_pic_partition(OVPPS *const pps)
         rem_ctu_h -= tile_nb_ctu_h;
     }
     // divide remaining picture height into uniform tile columns
-    while( rem_ctu_h > 0 )
+    while( rem_ctu_h > 0 && i < OV_MAX_TILE_ROWS )
     {
         tile_nb_ctu_h = OVMIN(rem_ctu_h, tile_nb_ctu_h);
         pps->pps_tile_row_height_minus1[i] = tile_nb_ctu_h - 1;
         rem_ctu_h -= tile_nb_ctu_h;
         i++;
     }
-    pps->pps_num_tile_rows_minus1 = i - 1;
+    /* Remaining CTUs mean the tile grid exceeds level limits */
+    pps->pps_num_tile_rows_minus1 = i - 1 + (rem_ctu_h > 0);
 
     int tile_nb_ctu_w = 0;
     for (i = 0; i < nb_cols; ++i) {
@@ -198,14 +220,14 @@ pps_implicit_pic_partition(OVPPS *const pps)
         rem_ctu_w -= tile_nb_ctu_w;
     }
     // divide remaining picture width into uniform tile columns
-    while( rem_ctu_w > 0 )
+    while( rem_ctu_w > 0 && i < OV_MAX_TILE_COLS )
     {
         tile_nb_ctu_w = OVMIN(rem_ctu_w, tile_nb_ctu_w);
         pps->pps_tile_column_width_minus1[i] = tile_nb_ctu_w - 1;
         rem_ctu_w -= tile_nb_ctu_w;
         i++;
     }
-    pps->pps_num_tile_columns_minus1 = i - 1;
+    pps->pps_num_tile_columns_minus1 = i - 1 + (rem_ctu_w > 0);
 }
 
 static void
@@ -215,8 +237,19 @@ pps_read_pic_partition(OVNVCLReader *const rdr, OVPPS *const pps)
     int row_sum = 0;
     int col_sum = 0;
 
-    pps->pps_num_exp_tile_columns_minus1 = nvcl_read_u_expgolomb(rdr);
-    pps->pps_num_exp_tile_rows_minus1    = nvcl_read_u_expgolomb(rdr);
+    uint32_t num_exp_tile_columns_minus1 = nvcl_read_u_expgolomb(rdr);
+    uint32_t num_exp_tile_rows_minus1    = nvcl_read_u_expgolomb(rdr);
+
+    /* Tile grid exceeding level limits is rejected on validation */
+    if (num_exp_tile_columns_minus1 >= OV_MAX_TILE_COLS ||
+        num_exp_tile_rows_minus1 >= OV_MAX_TILE_ROWS) {
+        pps->pps_num_tile_columns_minus1 = OV_MAX_TILE_COLS;
+        pps->pps_num_tile_rows_minus1    = OV_MAX_TILE_ROWS;
+        return;
+    }
+
+    pps->pps_num_exp_tile_columns_minus1 = num_exp_tile_columns_minus1;
+    pps->pps_num_exp_tile_rows_minus1    = num_exp_tile_rows_minus1;
 
     for (i = 0; i <=  pps->pps_num_exp_tile_columns_minus1; i++){
         pps->pps_tile_column_width_minus1[i] = nvcl_read_u_expgolomb(rdr);
@@ -35,6 +35,7 @@
 #define NVCL_STRUCTURES_H
 
 #include <stdint.h>
+#include "nvcl.h"
 #include "ovdpb.h"
 
 #define OV_MAX_NB_RP 16
@@ -431,26 +432,26 @@ struct OVPPS
     uint8_t pps_num_exp_tile_rows_minus1;
     uint8_t pps_num_tile_columns_minus1;
     uint8_t pps_num_tile_rows_minus1;
-    uint8_t pps_tile_column_width_minus1[16];
+    uint8_t pps_tile_column_width_minus1[OV_MAX_TILE_COLS];
 
-    uint8_t pps_tile_row_height_minus1[16];
+    uint8_t pps_tile_row_height_minus1[OV_MAX_TILE_ROWS];
 
     uint8_t pps_loop_filter_across_tiles_enabled_flag;
     uint8_t pps_rect_slice_flag;
 
     uint8_t pps_single_slice_per_subpic_flag;
 
-    uint8_t pps_num_slices_in_pic_minus1;
+    uint16_t pps_num_slices_in_pic_minus1;
     uint8_t pps_tile_idx_delta_present_flag;
 
-    uint8_t pps_slice_width_in_tiles_minus1[16];
+    uint8_t pps_slice_width_in_tiles_minus1[OV_MAX_NB_SLICES];
 
-    uint8_t pps_slice_height_in_tiles_minus1[16];
+    uint8_t pps_slice_height_in_tiles_minus1[OV_MAX_NB_SLICES];
 
-    uint8_t pps_num_exp_slices_in_tile[16];
-    uint8_t pps_exp_slice_height_in_ctus_minus1[16*16];
+    uint8_t pps_num_exp_slices_in_tile[OV_MAX_NB_SLICES];
+    uint8_t pps_exp_slice_height_in_ctus_minus1[OV_MAX_NB_SLICES];
 
-    int8_t pps_tile_idx_delta_val[16*16];
+    int16_t pps_tile_idx_delta_val[OV_MAX_NB_SLICES];
 
     uint8_t pps_loop_filter_across_slices_enabled_flag;
 
@@ -633,8 +634,8 @@ struct OVSH
     /* unused */
     uint8_t sh_slice_header_extension_data_byte[8];
     uint8_t sh_entry_offset_len_minus1;
-    /* FIXME find bounds on number of entry points */
-    uint32_t sh_entry_point_offset_minus1[64];
+    /* Entry points are only used for tiles since WPP is unsupported */
+    uint32_t sh_entry_point_offset_minus1[OV_MAX_NB_TILES - 1];
     /* Ref pic list info */
     struct OVHRPL hrpl;
 };
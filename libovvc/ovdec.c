@@ -34,9 +34,12 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <time.h>
 
 #if !_WIN32
 #include "sys/resource.h"
+#include <unistd.h>
+#include <fcntl.h>
 #endif
 
 #include "ovversion.h"
@@ -67,7 +70,15 @@ static const char *option_names[OVDEC_NB_OPTIONS] =
 {
     "frame threads",
     "entry threads",
-    "upscale_rpr"
+    "upscale_rpr",
+    "thread affinity",
+    "input queue depth",
+    "target frame rate",
+    "skip mode",
+    "max temporal id",
+    "skip loop filter",
+    "luma only",
+    "export side data"
 };
 
 static void ovdec_uninit_subdec_list(OVVCDec *vvcdec);
@@ -87,6 +98,51 @@ ovdec_init_subdec_list(OVVCDec *dec)
             return OVVC_ENOMEM;
         }
         dec->subdec_list[i]->slice_sync.main_thread = &dec->main_thread;
+
+        /* Distribute frame threads over NUMA nodes */
+        if (dec->placement.nb_nodes) {
+            dec->subdec_list[i]->node_idx = i % dec->placement.nb_nodes;
+        }
+    }
+
+    return 0;
+}
+
+/* Reallocate DPB and MV pools only if the active SPS requires
+ * more memory than what was allocated for previous sequences.
+ * New pools are created alongside the previous ones so pictures
+ * of the previous sequence can still be decoded or output while
+ * the new sequence starts.
+ */
+static int
+ovdec_update_capacity(OVVCDec *const dec)
+{
+    const OVPS *const ps = &dec->active_params;
+    uint8_t dpb_fits = ovdpb_fits_sps(dec->dpb, ps->sps);
+    uint8_t mv_pool_fits = !dec->mv_pool || mvpool_fits(dec->mv_pool, &ps->pic_info_max,
+                                                         dec->export_side_data);
+    int ret;
+
+    ovdpb_update_params(dec->dpb, ps);
+
+    if (dpb_fits && mv_pool_fits) {
+        return 0;
+    }
+
+    ov_log(dec, OVLOG_VERBOSE, "New SPS exceeds decoder capacity, reallocating pools.\n");
+
+    if (!dpb_fits) {
+        ret = ovdpb_realloc(dec->dpb, ps, &dec->placement);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
+    /* MV planes still in use are returned to the previous
+     * pool which is freed once all of them are released
+     */
+    if (!mv_pool_fits) {
+        mvpool_uninit(&dec->mv_pool);
     }
 
     return 0;
@@ -106,7 +162,12 @@ init_vcl_decoder(OVVCDec *const dec, OVSliceDec *sldec, const OVNVCLCtx *const n
     }
 
     if (!dec->dpb) {
-         ret = ovdpb_init(&dec->dpb, &dec->active_params);
+         ret = ovdpb_init(&dec->dpb, &dec->active_params, &dec->placement, dec->luma_only);
+         if (ret < 0) {
+             return ret;
+         }
+    } else {
+         ret = ovdec_update_capacity(dec);
          if (ret < 0) {
              return ret;
          }
@@ -114,12 +175,23 @@ init_vcl_decoder(OVVCDec *const dec, OVSliceDec *sldec, const OVNVCLCtx *const n
 
     //TODOpar: protect mv pool when more than one thread ?
     if (!dec->mv_pool) {
-        ret = mvpool_init(&dec->mv_pool, &dec->active_params.pic_info_max);
+        ret = mvpool_init(&dec->mv_pool, &dec->active_params.pic_info_max,
+                          dec->export_side_data);
+        if (ret < 0) {
+            return ret;
+        }
     }
 
     //Temporary: copy active parameters
     slicedec_copy_params(sldec, &dec->active_params);
 
+    sldec->skip_ilf = dec->skip_ctx.loop_filter == OVDEC_SKIP_LF_ALL ||
+                      (dec->skip_ctx.loop_filter == OVDEC_SKIP_LF_NON_REF &&
+                       dec->active_params.ph->ph_non_ref_pic_flag);
+
+    /* Reconstruction follows the format of DPB frames */
+    sldec->luma_only = dec->dpb->internal.luma_only;
+
     if (!dec->active_params.sh->sh_slice_address) {
         ret = ovdpb_init_picture(dec->dpb, &sldec->pic, sldec->active_params, nalu->type, sldec, dec);
         if (ret < 0) {
@@ -185,11 +257,90 @@ ovdec_wait_available_entry_thread(OVVCDec *const dec)
     #endif
 }
 
+/* Release the picture of a sub decoder which finished decoding
+ * so it can be output and its references can be released.
+ * main_mtx must be locked.
+ */
+static void
+ovdec_release_finished_subdec(OVSliceDec *const slicedec)
+{
+    struct SliceSynchro* slice_sync = &slicedec->slice_sync;
+    OVPicture *slice_pic = slicedec->pic;
+
+    pthread_mutex_lock(&slice_sync->gnrl_mtx);
+    if (slice_sync->active_state != DECODING_FINISHED) {
+        pthread_mutex_unlock(&slice_sync->gnrl_mtx);
+        return;
+    }
+    pthread_mutex_unlock(&slice_sync->gnrl_mtx);
+
+    if (slice_pic && (slice_pic->flags & OV_IN_DECODING_PIC_FLAG)) {
+        ov_log(NULL, OVLOG_TRACE, "Remove DECODING_PIC_FLAG POC: %d\n", slice_pic->poc);
+        ovdpb_unref_pic(slice_pic, OV_IN_DECODING_PIC_FLAG);
+        ovdpb_unmark_ref_pic_lists(slicedec->slice_type, slice_pic);
+
+        pthread_mutex_lock(&slice_sync->gnrl_mtx);
+        slice_sync->active_state = IDLE;
+        pthread_mutex_unlock(&slice_sync->gnrl_mtx);
+    }
+}
+
+/* main_mtx must be locked.
+ */
+static void
+ovdec_release_finished_subdecs(OVVCDec *const dec)
+{
+    int i;
+
+    if (!dec->subdec_list) {
+        return;
+    }
+
+    for (i = 0; i < dec->nb_frame_th; ++i) {
+        ovdec_release_finished_subdec(dec->subdec_list[i]);
+    }
+}
+
+/* Wait for all sub decoders to finish decoding their current
+ * picture and release their pictures.
+ */
+static void
+ovdec_wait_decoding_end(OVVCDec *const dec)
+{
+    struct MainThread* th_main = &dec->main_thread;
+    int i;
+
+    if (!dec->subdec_list) {
+        return;
+    }
+
+    pthread_mutex_lock(&th_main->main_mtx);
+    for (i = 0; i < dec->nb_frame_th; ++i) {
+        OVSliceDec *slicedec = dec->subdec_list[i];
+        struct SliceSynchro* slice_sync = &slicedec->slice_sync;
+        uint8_t is_active;
+
+        do {
+            pthread_mutex_lock(&slice_sync->gnrl_mtx);
+            is_active = slice_sync->active_state == ACTIVE;
+            pthread_mutex_unlock(&slice_sync->gnrl_mtx);
+
+            if (is_active) {
+                pthread_cond_wait(&th_main->main_cnd, &th_main->main_mtx);
+            }
+        } while (is_active);
+
+        ovdec_release_finished_subdec(slicedec);
+    }
+    pthread_mutex_unlock(&th_main->main_mtx);
+}
+
 OVSliceDec *
 ovdec_select_subdec(OVVCDec *const dec)
 {
     OVSliceDec **sldec_list = dec->subdec_list;
     int nb_threads = dec->nb_frame_th;
+    int nb_active = dec->thread_ctrl.nb_active_frame_th;
     struct MainThread* th_main = &dec->main_thread;
 
     OVSliceDec * slicedec;
@@ -204,22 +355,14 @@ ovdec_select_subdec(OVVCDec *const dec)
 
             //Unmark ref pict lists of decoded pics
             pthread_mutex_lock(&slice_sync->gnrl_mtx);
+            /* Parked sub decoders are released but not selected */
             if (slice_sync->active_state == DECODING_FINISHED) {
                 pthread_mutex_unlock(&slice_sync->gnrl_mtx);
-                min_idx_available = i;
-                OVPicture *slice_pic = slicedec->pic;
-                if (slice_pic && (slice_pic->flags & OV_IN_DECODING_PIC_FLAG)) {
-                    ov_log(NULL, OVLOG_TRACE, "Subdec %d Remove DECODING_PIC_FLAG POC: %d\n", min_idx_available, slice_pic->poc);
-                    ovdpb_unref_pic(slice_pic, OV_IN_DECODING_PIC_FLAG);
-                    ovdpb_unmark_ref_pic_lists(slicedec->slice_type, slice_pic);
-
-                    pthread_mutex_lock(&slice_sync->gnrl_mtx);
-                    slice_sync->active_state = IDLE;
-                    pthread_mutex_unlock(&slice_sync->gnrl_mtx);
-                }
+                min_idx_available = i < nb_active ? i : min_idx_available;
+                ovdec_release_finished_subdec(slicedec);
             } else if (slice_sync->active_state == IDLE) {
                 pthread_mutex_unlock(&slice_sync->gnrl_mtx);
-                min_idx_available = i;
+                min_idx_available = i < nb_active ? i : min_idx_available;
             } else {
                 pthread_mutex_unlock(&slice_sync->gnrl_mtx);
             }
@@ -251,8 +394,8 @@ void
 ovdec_init_entry_jobs(OVVCDec *vvcdec, int nb_entry_th)
 {
     struct MainThread* main_thread = &vvcdec->main_thread;
-    // main_thread->size_fifo       = nb_entry_th*nb_entry_th;
-    main_thread->size_fifo       = 512;
+    /* Grown when more jobs are pending */
+    main_thread->size_fifo       = 64;
     main_thread->entry_jobs_fifo = ov_mallocz(main_thread->size_fifo * sizeof(struct EntryJob));
     main_thread->first_idx_fifo  =  0;
     main_thread->last_idx_fifo   = -1;
@@ -310,8 +453,20 @@ ovdec_init_entry_threads(OVVCDec *vvcdec, int nb_entry_th)
     vvcdec->main_thread.entry_threads_list = ov_mallocz(nb_entry_th*sizeof(struct EntryThread));
     for (i = 0; i < nb_entry_th; ++i){
         struct EntryThread *entry_th = &vvcdec->main_thread.entry_threads_list[i];
+        const struct ThreadPlacement *placement = &vvcdec->placement;
         entry_th->main_thread = &vvcdec->main_thread;
 
+        entry_th->cpu = -1;
+        if (placement->affinity) {
+            int j;
+            entry_th->cpu = placement->cpu_list[i % placement->nb_cpus];
+            for (j = 0; j < placement->nb_nodes; ++j) {
+                if (placement->node_list[j] == get_numa_node_of_cpu(entry_th->cpu)) {
+                    entry_th->node_idx = j;
+                }
+            }
+        }
+
         ret = ovthread_init_entry_thread(entry_th);
         if (ret < 0)
             goto failthread;
@@ -333,6 +488,9 @@ ovdec_init_main_thread(OVVCDec *vvcdec)
     int nb_entry_th = vvcdec->nb_entry_th;
 
     main_thread->nb_entry_th = nb_entry_th;
+    main_thread->nb_active_entry_th = nb_entry_th;
+
+    vvcdec->thread_ctrl.nb_active_frame_th = vvcdec->nb_frame_th;
 
     pthread_mutex_init(&main_thread->entry_threads_mtx, NULL);
     pthread_cond_init(&main_thread->entry_threads_cnd,  NULL);
@@ -340,8 +498,8 @@ ovdec_init_main_thread(OVVCDec *vvcdec)
     pthread_cond_init(&main_thread->main_cnd,  NULL);
 
     ovdec_init_entry_jobs(vvcdec, nb_entry_th);
-    ovdec_init_entry_threads(vvcdec, nb_entry_th);
-    return 0;
+
+    return ovdec_init_entry_threads(vvcdec, nb_entry_th);
 
 }
 
@@ -354,6 +512,173 @@ ovdec_uninit_main_thread(OVVCDec *vvcdec)
     return 0;
 }
 
+/* Duration of measurement windows of the thread controller */
+#define THREAD_CTRL_WINDOW_US 500000
+
+/* Park or wake entry and frame threads so the measured decoding
+ * capacity matches the target frame rate with some headroom.
+ * Capacity is derived from the time entry threads spent decoding
+ * so it is also measured when input is paced by the application.
+ */
+static void
+ovdec_adjust_threads(OVVCDec *const dec)
+{
+    struct ThreadController *ctrl = &dec->thread_ctrl;
+    struct MainThread *th_main = &dec->main_thread;
+    uint64_t now, elapsed, nb_pic, busy_time;
+    int nb_active, nb_needed;
+
+    if (!ctrl->target_fps) {
+        return;
+    }
+
+    now = get_time_us();
+
+    pthread_mutex_lock(&th_main->main_mtx);
+    nb_pic    = th_main->nb_pic_decoded;
+    busy_time = th_main->busy_time_us;
+    nb_active = th_main->nb_active_entry_th;
+    pthread_mutex_unlock(&th_main->main_mtx);
+
+    if (!ctrl->window_start) {
+        goto new_window;
+    }
+
+    elapsed = now - ctrl->window_start;
+    if (elapsed < THREAD_CTRL_WINDOW_US) {
+        return;
+    }
+
+    nb_pic    -= ctrl->window_nb_pic;
+    busy_time -= ctrl->window_busy_time;
+
+    if (!nb_pic) {
+        /* No picture decoded in the whole window while threads are
+         * saturated, otherwise input was paused
+         */
+        nb_needed = nb_active + (busy_time * 10 > elapsed * nb_active * 9);
+    } else {
+        /* Threads needed to decode target_fps pictures per second
+         * with 25% headroom
+         */
+        uint64_t needed_time = busy_time * ctrl->target_fps * 5 / 4;
+        nb_needed = (needed_time + nb_pic * 1000000 - 1) / (nb_pic * 1000000);
+
+        /* Output is too slow while threads are saturated */
+        if (nb_pic * 1000000 < elapsed * ctrl->target_fps &&
+            busy_time * 10 > elapsed * nb_active * 9) {
+            nb_needed = OVMAX(nb_needed, nb_active + 1);
+        }
+
+        /* Release threads one at a time to avoid oscillations */
+        nb_needed = OVMAX(nb_needed, nb_active - 1);
+    }
+
+    nb_needed = ov_clip(nb_needed, 1, dec->nb_entry_th);
+
+    if (nb_needed != nb_active) {
+        struct EntryThread *entry_th_list = th_main->entry_threads_list;
+        int i;
+
+        ov_log(dec, OVLOG_VERBOSE, "Active entry threads %d -> %d.\n", nb_active, nb_needed);
+
+        pthread_mutex_lock(&th_main->main_mtx);
+        th_main->nb_active_entry_th = nb_needed;
+        pthread_mutex_unlock(&th_main->main_mtx);
+
+        ctrl->nb_active_frame_th = OVMIN(dec->nb_frame_th, nb_needed);
+
+        /* Wake up unparked threads so they pick pending jobs */
+        for (i = nb_active; i < nb_needed; ++i) {
+            struct EntryThread *entry_th = &entry_th_list[i];
+            pthread_mutex_lock(&entry_th->entry_mtx);
+            pthread_cond_signal(&entry_th->entry_cnd);
+            pthread_mutex_unlock(&entry_th->entry_mtx);
+        }
+    }
+
+new_window:
+    pthread_mutex_lock(&th_main->main_mtx);
+    ctrl->window_nb_pic    = th_main->nb_pic_decoded;
+    ctrl->window_busy_time = th_main->busy_time_us;
+    pthread_mutex_unlock(&th_main->main_mtx);
+    ctrl->window_start = now;
+}
+
+/* Check if the picture of a VCL NAL Unit is to be skipped
+ * according to skip mode and update the skip context.
+ */
+static uint8_t
+skip_picture(OVVCDec *const dec, const OVNALUnit *const nalu)
+{
+    const OVPH *const ph = dec->nvcl_ctx.ph;
+    uint8_t flags = dec->skip_ctx.flags;
+    uint8_t tid = (nalu->rbsp_data[1] & 0x7) - 1;
+    uint8_t irap_flag = nalu->type >= OVNALU_IDR_W_RADL && nalu->type <= OVNALU_CRA;
+
+    if (irap_flag || nalu->type == OVNALU_GDR) {
+        /* RASL pictures of a CRA starting decoding refer to
+         * pictures which were not decoded
+         */
+        dec->skip_ctx.skip_rasl = dec->skip_ctx.wait_irap && nalu->type == OVNALU_CRA;
+        dec->skip_ctx.wait_irap = 0;
+    }
+
+    if (tid > dec->skip_ctx.max_tid) {
+        return 1;
+    }
+
+    if ((flags & OVDEC_SKIP_NON_IRAP) && !irap_flag) {
+        return 1;
+    }
+
+    if ((flags & OVDEC_SKIP_NON_REF) && ph && ph->ph_non_ref_pic_flag) {
+        return 1;
+    }
+
+    if (flags & OVDEC_SKIP_RASL_AFTER_SEEK) {
+        if (dec->skip_ctx.wait_irap) {
+            return 1;
+        }
+
+        if (dec->skip_ctx.skip_rasl && nalu->type == OVNALU_RASL) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Skipped temporal ID 0 reference pictures are still the previous
+ * pictures used for POC MSB derivation of following pictures.
+ */
+static void
+update_skipped_poc(OVVCDec *const dec, const OVNALUnit *const nalu)
+{
+    const OVNVCLCtx *const nvcl_ctx = &dec->nvcl_ctx;
+    const OVPH *const ph = nvcl_ctx->ph;
+    const OVPPS *pps;
+    const OVSPS *sps;
+    uint8_t tid = (nalu->rbsp_data[1] & 0x7) - 1;
+
+    if (tid || !ph || ph->ph_non_ref_pic_flag) {
+        return;
+    }
+
+    if (nalu->type == OVNALU_RASL || nalu->type == OVNALU_RADL) {
+        return;
+    }
+
+    pps = nvcl_ctx->pps_list[ph->ph_pic_parameter_set_id];
+    sps = pps ? nvcl_ctx->sps_list[pps->pps_seq_parameter_set_id] : NULL;
+
+    pthread_mutex_lock(&dec->dpb_mtx);
+    if (dec->dpb && sps) {
+        ovdpb_update_skipped_poc(dec->dpb, ph, sps, nalu->type);
+    }
+    pthread_mutex_unlock(&dec->dpb_mtx);
+}
+
 static int
 decode_nal_unit(OVVCDec *const vvcdec, OVNALUnit * nalu)
 {
@@ -382,7 +707,13 @@ decode_nal_unit(OVVCDec *const vvcdec, OVNALUnit * nalu)
 
         if (ret < 0) {
             return ret;
+        } else if (skip_picture(vvcdec, nalu)) {
+            ov_log(vvcdec, OVLOG_TRACE, "Skipping picture with NAL Unit type %d\n", nalu_type);
+            update_skipped_poc(vvcdec, nalu);
+            return 0;
         } else {
+            ovdec_adjust_threads(vvcdec);
+
             /* Select the first available subdecoder, or wait until one is available */
             OVSliceDec *sldec = ovdec_select_subdec(vvcdec);
 
@@ -392,7 +723,9 @@ decode_nal_unit(OVVCDec *const vvcdec, OVNALUnit * nalu)
             uint32_t nb_sh_bytes = nvcl_nb_bytes_read(&rdr);
 
             /* Beyond this point unref current picture on failure */
+            pthread_mutex_lock(&vvcdec->dpb_mtx);
             ret = init_vcl_decoder(vvcdec, sldec, nvcl_ctx, nalu, nb_sh_bytes);
+            pthread_mutex_unlock(&vvcdec->dpb_mtx);
 
             if (ret < 0) {
                 slicedec_finish_decoding(sldec);
@@ -401,9 +734,17 @@ decode_nal_unit(OVVCDec *const vvcdec, OVNALUnit * nalu)
 
             /* FIXME handle non rect entries later */
             ret = slicedec_decode_rect_entries(sldec, sldec->active_params, vvcdec->main_thread.entry_threads_list);
+            if (ret < 0) {
+                slicedec_finish_decoding(sldec);
+                goto failvcl;
+            }
         }
 
         break;
+    case OVNALU_EOS:
+        /* Next CRA is handled as first picture of bitstream */
+        vvcdec->skip_ctx.wait_irap = 1;
+        /* fall through */
     case OVNALU_PREFIX_SEI:
     case OVNALU_SUFFIX_SEI:
     case OVNALU_SUFFIX_APS:
@@ -412,7 +753,6 @@ decode_nal_unit(OVVCDec *const vvcdec, OVNALUnit * nalu)
     case OVNALU_SPS:
     case OVNALU_PPS:
     case OVNALU_PH:
-    case OVNALU_EOS:
     case OVNALU_EOB:
     case OVNALU_AUD:
     default:
@@ -451,29 +791,235 @@ fail:
     return ret;
 }
 
+static void *
+input_thread_main_function(void *opaque)
+{
+    OVVCDec *dec = (OVVCDec *)opaque;
+    struct InputQueue *queue = &dec->input_queue;
+    struct MainThread *th_main = &dec->main_thread;
+
+    pthread_mutex_lock(&queue->queue_mtx);
+    while (!queue->kill) {
+        OVPictureUnit *pu;
+        int ret;
+
+        if (!queue->nb_pu) {
+            pthread_cond_wait(&queue->queue_cnd, &queue->queue_mtx);
+            continue;
+        }
+
+        pu = queue->pu_fifo[queue->first_idx];
+        queue->pu_fifo[queue->first_idx] = NULL;
+        queue->first_idx = (queue->first_idx + 1) % queue->size_fifo;
+        queue->nb_pu--;
+        queue->busy = 1;
+
+        /* Signal available space to submitting thread */
+        pthread_cond_broadcast(&queue->queue_cnd);
+        pthread_mutex_unlock(&queue->queue_mtx);
+
+        ret = vvc_decode_picture_unit(dec, pu);
+
+        ovpu_unref(&pu);
+
+        /* Starting a new picture might have bumped pictures */
+        pthread_mutex_lock(&th_main->main_mtx);
+        ovthread_notify_output(th_main);
+        pthread_mutex_unlock(&th_main->main_mtx);
+
+        pthread_mutex_lock(&queue->queue_mtx);
+        if (ret < 0) {
+            queue->last_ret = ret;
+        }
+        queue->busy = 0;
+        pthread_cond_broadcast(&queue->queue_cnd);
+    }
+    pthread_mutex_unlock(&queue->queue_mtx);
+
+    return NULL;
+}
+
+static int
+ovdec_init_input_thread(OVVCDec *dec)
+{
+    struct InputQueue *queue = &dec->input_queue;
+
+    queue->pu_fifo = ov_mallocz(sizeof(*queue->pu_fifo) * queue->size_fifo);
+    if (!queue->pu_fifo) {
+        return OVVC_ENOMEM;
+    }
+
+    pthread_mutex_init(&queue->queue_mtx, NULL);
+    pthread_cond_init(&queue->queue_cnd, NULL);
+
+    if (pthread_create(&queue->thread, NULL, input_thread_main_function, dec)) {
+        ov_log(dec, OVLOG_ERROR, "Input thread creation failed at decoder init\n");
+        pthread_mutex_destroy(&queue->queue_mtx);
+        pthread_cond_destroy(&queue->queue_cnd);
+        ov_freep(&queue->pu_fifo);
+        return OVVC_ENOMEM;
+    }
+
+    queue->active = 1;
+
+    return 0;
+}
+
+/* Remove Picture Units waiting in the input queue.
+ * queue_mtx must be locked.
+ */
+static void
+ovdec_clear_input_queue(struct InputQueue *queue)
+{
+    while (queue->nb_pu) {
+        ovpu_unref(&queue->pu_fifo[queue->first_idx]);
+        queue->first_idx = (queue->first_idx + 1) % queue->size_fifo;
+        queue->nb_pu--;
+    }
+    pthread_cond_broadcast(&queue->queue_cnd);
+}
+
+static void
+ovdec_uninit_input_thread(OVVCDec *dec)
+{
+    struct InputQueue *queue = &dec->input_queue;
+
+    if (!queue->active) {
+        return;
+    }
+
+    /* Picture Unit being decoded is finished before joining */
+    pthread_mutex_lock(&queue->queue_mtx);
+    queue->kill = 1;
+    ovdec_clear_input_queue(queue);
+    pthread_mutex_unlock(&queue->queue_mtx);
+
+    pthread_join(queue->thread, NULL);
+
+    pthread_mutex_destroy(&queue->queue_mtx);
+    pthread_cond_destroy(&queue->queue_cnd);
+    ov_freep(&queue->pu_fifo);
+
+    queue->active = 0;
+}
+
+/* Wait for the input thread to decode all queued Picture Units
+ * Return the error of the last failed Picture Unit if any.
+ */
+static int
+ovdec_wait_input_idle(OVVCDec *dec)
+{
+    struct InputQueue *queue = &dec->input_queue;
+    int ret;
+
+    if (!queue->active) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&queue->queue_mtx);
+    while (queue->nb_pu || queue->busy) {
+        pthread_cond_wait(&queue->queue_cnd, &queue->queue_mtx);
+    }
+    ret = queue->last_ret;
+    queue->last_ret = 0;
+    pthread_mutex_unlock(&queue->queue_mtx);
+
+    return ret;
+}
+
 int
 ovdec_submit_picture_unit(OVVCDec *vvcdec, const OVPictureUnit *const pu)
 {
     int ret = 0;
 
+    /* Keep decoding order with previously queued Picture Units */
+    ret = ovdec_wait_input_idle(vvcdec);
+    if (ret < 0) {
+        return ret;
+    }
+
     ret = vvc_decode_picture_unit(vvcdec, pu);
 
     return ret;
 }
 
+int
+ovdec_submit_picture_unit_async(OVVCDec *vvcdec, OVPictureUnit *pu)
+{
+    struct InputQueue *queue = &vvcdec->input_queue;
+    int idx;
+    int ret;
+
+    if (!queue->active) {
+        ov_log(vvcdec, OVLOG_ERROR, "No input queue, set input queue depth before start.\n");
+        return OVVC_EUNSUPPORTED;
+    }
+
+    pthread_mutex_lock(&queue->queue_mtx);
+
+    /* Report error of previously queued Picture Units */
+    ret = queue->last_ret;
+    if (ret < 0) {
+        queue->last_ret = 0;
+        pthread_mutex_unlock(&queue->queue_mtx);
+        return ret;
+    }
+
+    if (queue->nb_pu == queue->size_fifo) {
+        pthread_mutex_unlock(&queue->queue_mtx);
+        return OVVC_EAGAIN;
+    }
+
+    idx = (queue->first_idx + queue->nb_pu) % queue->size_fifo;
+    ret = ovpu_new_ref(&queue->pu_fifo[idx], pu);
+    if (ret < 0) {
+        pthread_mutex_unlock(&queue->queue_mtx);
+        return ret;
+    }
+
+    queue->nb_pu++;
+    pthread_cond_broadcast(&queue->queue_cnd);
+    pthread_mutex_unlock(&queue->queue_mtx);
+
+    return 0;
+}
+
 int
 ovdec_receive_picture(OVVCDec *dec, OVFrame **frame_p)
 {
+    struct MainThread *th_main = &dec->main_thread;
     struct OVSEI *sei;
-    OVDPB *dpb = dec->dpb;
+    OVDPB *dpb;
     int ret = 0;
 
+    *frame_p = NULL;
+
+#if !_WIN32
+    /* Consume notifications of events preceding this output */
+    if (th_main->event_fd[0] >= 0) {
+        uint8_t buf[64];
+        while (read(th_main->event_fd[0], buf, sizeof(buf)) > 0);
+    }
+#endif
+
+    pthread_mutex_lock(&dec->dpb_mtx);
+    dpb = dec->dpb;
     if (!dpb) {
+        pthread_mutex_unlock(&dec->dpb_mtx);
         ov_log(dec, OVLOG_TRACE, "No DPB on output request.\n");
         return 0;
     }
 
+    /* Pictures of sub decoders which finished decoding are released
+     * so they can be output without waiting for the sub decoder
+     * to be selected again
+     */
+    pthread_mutex_lock(&th_main->main_mtx);
+    ovdec_release_finished_subdecs(dec);
+
     ret = ovdpb_output_pic(dpb, frame_p, &sei);
+    pthread_mutex_unlock(&th_main->main_mtx);
+    pthread_mutex_unlock(&dec->dpb_mtx);
 
     if (*frame_p) {
         pp_process_frame(sei, frame_p);
@@ -499,25 +1045,104 @@ ovdec_receive_picture(OVVCDec *dec, OVFrame **frame_p)
     return ret;
 }
 
+int
+ovdec_receive_picture_timeout(OVVCDec *dec, OVFrame **frame_p, int timeout_ms)
+{
+    struct MainThread *th_main = &dec->main_thread;
+    struct timespec deadline;
+    uint64_t nb_events;
+    int ret;
+
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec  += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+
+    do {
+        /* Read event count before trying to output so events
+         * occurring meanwhile are not missed
+         */
+        pthread_mutex_lock(&th_main->main_mtx);
+        nb_events = th_main->nb_output_events;
+        pthread_mutex_unlock(&th_main->main_mtx);
+
+        ret = ovdec_receive_picture(dec, frame_p);
+        if (ret < 0 || *frame_p || !timeout_ms) {
+            return ret;
+        }
+
+        pthread_mutex_lock(&th_main->main_mtx);
+        while (nb_events == th_main->nb_output_events) {
+            if (timeout_ms < 0) {
+                pthread_cond_wait(&th_main->main_cnd, &th_main->main_mtx);
+            } else if (pthread_cond_timedwait(&th_main->main_cnd, &th_main->main_mtx, &deadline)) {
+                pthread_mutex_unlock(&th_main->main_mtx);
+                return ovdec_receive_picture(dec, frame_p);
+            }
+        }
+        pthread_mutex_unlock(&th_main->main_mtx);
+
+    } while (1);
+}
+
+int
+ovdec_get_event_fd(OVVCDec *dec)
+{
+#if !_WIN32
+    struct MainThread *th_main = &dec->main_thread;
+    int ret = 0;
+
+    pthread_mutex_lock(&th_main->main_mtx);
+    if (th_main->event_fd[0] < 0) {
+        if (pipe(th_main->event_fd) < 0) {
+            th_main->event_fd[0] = -1;
+            th_main->event_fd[1] = -1;
+            ret = OVVC_ENOMEM;
+        } else {
+            fcntl(th_main->event_fd[0], F_SETFL, O_NONBLOCK);
+            fcntl(th_main->event_fd[1], F_SETFL, O_NONBLOCK);
+        }
+    }
+    ret = ret < 0 ? ret : th_main->event_fd[0];
+    pthread_mutex_unlock(&th_main->main_mtx);
+
+    return ret;
+#else
+    return OVVC_EUNSUPPORTED;
+#endif
+}
+
 int
 ovdec_drain_picture(OVVCDec *dec, OVFrame **frame_p)
 {
     struct OVSEI *sei;
-    OVDPB *dpb = dec->dpb;
+    OVDPB *dpb;
     int ret;
 
-    /* FIXME this is to ensure at least one subdecoder has finished
-     * decoding its frame so we do not return no frame when some
-     * subdecoders are still running
+    /* Ensure no subdecoder is still running so we do not
+     * return no frame while some pictures are still being decoded
      */
-    ovdec_uninit_subdec_list(dec);
+    ret = ovdec_wait_input_idle(dec);
+    if (ret < 0) {
+        return ret;
+    }
+
+    ovdec_wait_decoding_end(dec);
 
+    dpb = dec->dpb;
     if (!dpb) {
         ov_log(dec, OVLOG_TRACE, "No DPB on output request.\n");
         return 0;
     }
 
+    pthread_mutex_lock(&dec->dpb_mtx);
     ret = ovdpb_drain_frame(dpb, frame_p, &sei);
+    pthread_mutex_unlock(&dec->dpb_mtx);
 
     if (*frame_p) {
         pp_process_frame(sei, frame_p);
@@ -536,6 +1161,34 @@ ovdec_drain_picture(OVVCDec *dec, OVFrame **frame_p)
     return ret;
 }
 
+int
+ovdec_flush(OVVCDec *dec)
+{
+    struct InputQueue *queue = &dec->input_queue;
+
+    /* Picture Units not yet decoded are discarded */
+    if (queue->active) {
+        pthread_mutex_lock(&queue->queue_mtx);
+        ovdec_clear_input_queue(queue);
+        pthread_mutex_unlock(&queue->queue_mtx);
+        ovdec_wait_input_idle(dec);
+    }
+
+    ovdec_wait_decoding_end(dec);
+
+    pthread_mutex_lock(&dec->dpb_mtx);
+    if (dec->dpb) {
+        ovdpb_clear_dpb(dec->dpb);
+    }
+    pthread_mutex_unlock(&dec->dpb_mtx);
+
+    dec->skip_ctx.wait_irap = 1;
+
+    ov_log(dec, OVLOG_TRACE, "Decoder flushed.\n");
+
+    return 0;
+}
+
 static int
 set_nb_entry_threads(OVVCDec *ovdec, int nb_threads)
 {
@@ -567,6 +1220,34 @@ ovdec_set_option(OVVCDec *ovdec, enum OVOptions opt_id, int value)
         case OVDEC_NB_FRAME_THREADS:
             set_nb_frame_threads(ovdec, value);
             break;
+        case OVDEC_THREAD_AFFINITY:
+            ovdec->placement.affinity = !!value;
+            break;
+        case OVDEC_INPUT_QUEUE_DEPTH:
+            ovdec->input_queue.size_fifo = OVMAX(value, 0);
+            break;
+        case OVDEC_TARGET_FPS:
+            ovdec->thread_ctrl.target_fps = OVMAX(value, 0);
+            break;
+        case OVDEC_SKIP_MODE:
+            ovdec->skip_ctx.flags = value;
+            break;
+        case OVDEC_MAX_TEMPORAL_ID:
+            ovdec->skip_ctx.max_tid = ov_clip(value, 0, 6);
+            break;
+        case OVDEC_SKIP_LOOP_FILTER:
+            ovdec->skip_ctx.loop_filter = ov_clip(value, OVDEC_SKIP_LF_NONE, OVDEC_SKIP_LF_ALL);
+            break;
+        case OVDEC_LUMA_ONLY:
+            if (ovdec->dpb) {
+                ov_log(ovdec, OVLOG_WARNING, "Luma only mode cannot be changed once decoding started.\n");
+                return OVVC_EINDATA;
+            }
+            ovdec->luma_only = !!value;
+            break;
+        case OVDEC_EXPORT_SIDE_DATA:
+            ovdec->export_side_data = !!value;
+            break;
         default :
             if (opt_id < OVDEC_NB_OPTIONS) {
                 ov_log(ovdec, OVLOG_ERROR, "Invalid option id %d.", opt_id);
@@ -601,6 +1282,53 @@ derive_thread_ctx(OVDec *ovdec)
 
 }
 
+static int
+derive_thread_placement(OVDec *ovdec)
+{
+    struct ThreadPlacement *placement = &ovdec->placement;
+    int i;
+
+    if (!placement->affinity) {
+        return 0;
+    }
+
+    if (!placement->cpu_list) {
+        int nb_cpus = OVMAX(get_number_of_cores(), ovdec->nb_entry_th);
+        placement->cpu_list = ov_malloc(sizeof(*placement->cpu_list) * nb_cpus);
+        if (!placement->cpu_list) {
+            return OVVC_ENOMEM;
+        }
+        placement->nb_cpus = get_cpu_affinity_list(placement->cpu_list, nb_cpus);
+    }
+
+    if (placement->nb_cpus < 1) {
+        ov_log(ovdec, OVLOG_WARNING, "No CPU available for thread affinity.\n");
+        placement->affinity = 0;
+        return 0;
+    }
+
+    placement->nb_nodes = 0;
+    for (i = 0; i < OVMIN(placement->nb_cpus, ovdec->nb_entry_th); ++i) {
+        int node = get_numa_node_of_cpu(placement->cpu_list[i]);
+        int j;
+
+        for (j = 0; j < placement->nb_nodes; ++j) {
+            if (placement->node_list[j] == node) {
+                break;
+            }
+        }
+
+        if (j == placement->nb_nodes && placement->nb_nodes < OV_MAX_NUMA_NODES) {
+            placement->node_list[placement->nb_nodes++] = node;
+        }
+    }
+
+    ov_log(ovdec, OVLOG_VERBOSE, "Entry threads pinned on %d CPUs over %d NUMA nodes.\n",
+           placement->nb_cpus, placement->nb_nodes);
+
+    return 0;
+}
+
 int
 ovdec_config_threads(OVDec *ovdec, int nb_entry_th, int max_nb_frame_th)
 {
@@ -611,6 +1339,37 @@ ovdec_config_threads(OVDec *ovdec, int nb_entry_th, int max_nb_frame_th)
     return 0;
 }
 
+int
+ovdec_config_affinity(OVDec *ovdec, const int *cpu_list, int nb_cpus)
+{
+    struct ThreadPlacement *placement = &ovdec->placement;
+
+    ov_freep(&placement->cpu_list);
+    placement->nb_cpus = 0;
+
+    if (nb_cpus > 0) {
+        placement->cpu_list = ov_malloc(sizeof(*cpu_list) * nb_cpus);
+        if (!placement->cpu_list) {
+            return OVVC_ENOMEM;
+        }
+        memcpy(placement->cpu_list, cpu_list, sizeof(*cpu_list) * nb_cpus);
+        placement->nb_cpus = nb_cpus;
+    }
+
+    ovdec_set_option(ovdec, OVDEC_THREAD_AFFINITY, 1);
+
+    return 0;
+}
+
+int
+ovdec_set_row_callback(OVDec *ovdec, OVRowCallback row_callback, void *opaque)
+{
+    ovdec->row_output.callback = row_callback;
+    ovdec->row_output.opaque   = opaque;
+
+    return 0;
+}
+
 int
 ovdec_start(OVDec *ovdec)
 {
@@ -618,6 +1377,11 @@ ovdec_start(OVDec *ovdec)
 
     derive_thread_ctx(ovdec);
 
+    ret = derive_thread_placement(ovdec);
+    if (ret < 0) {
+        return ret;
+    }
+
     ret = ovdec_init_subdec_list(ovdec);
     if (ret < 0) {
         return ret;
@@ -628,6 +1392,13 @@ ovdec_start(OVDec *ovdec)
         return ret;
     }
 
+    if (ovdec->input_queue.size_fifo > 0) {
+        ret = ovdec_init_input_thread(ovdec);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
     return 0;
 }
 
@@ -641,6 +1412,14 @@ ovdec_init(OVVCDec **ovdec_p)
 
     (*ovdec_p)->name = decname;
 
+    (*ovdec_p)->skip_ctx.max_tid   = 6;
+    (*ovdec_p)->skip_ctx.wait_irap = 1;
+
+    (*ovdec_p)->main_thread.event_fd[0] = -1;
+    (*ovdec_p)->main_thread.event_fd[1] = -1;
+
+    pthread_mutex_init(&(*ovdec_p)->dpb_mtx, NULL);
+
     ov_log(NULL, OVLOG_TRACE, "OpenVVC init at %p\n", *ovdec_p);
     return 0;
 
@@ -682,6 +1461,8 @@ ovdec_close(OVVCDec *vvcdec)
 
         if (not_dec) goto fail;
 
+        ovdec_uninit_input_thread(vvcdec);
+
         nvcl_free_ctx(&vvcdec->nvcl_ctx);
 
         ovdec_uninit_subdec_list(vvcdec);
@@ -692,6 +1473,17 @@ ovdec_close(OVVCDec *vvcdec)
             mvpool_uninit(&vvcdec->mv_pool);
         }
 
+        ov_freep(&vvcdec->placement.cpu_list);
+
+#if !_WIN32
+        if (vvcdec->main_thread.event_fd[0] >= 0) {
+            close(vvcdec->main_thread.event_fd[0]);
+            close(vvcdec->main_thread.event_fd[1]);
+        }
+#endif
+
+        pthread_mutex_destroy(&vvcdec->dpb_mtx);
+
         ov_free(vvcdec);
 
         return 0;
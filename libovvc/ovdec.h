@@ -59,9 +59,116 @@ enum OVOptions {
 
    OVDEC_RPR_UPSCALE = 2,
 
+   /* Pin entry threads on CPUs
+    *
+    * Note:
+    *    - Unless a CPU list is given with ovdec_config_affinity()
+    *    threads are pinned on the CPUs the process is allowed to
+    *    run on, grouped by NUMA node.
+    *    - On NUMA systems frame threads are distributed over the
+    *    nodes of the selected CPUs, pictures are allocated on the node
+    *    of their frame thread and entry threads favour entries of
+    *    pictures from their own node.
+    */
+   OVDEC_THREAD_AFFINITY = 3,
+
+   /* Set the maximum number of Picture Units waiting in the input
+    * queue of ovdec_submit_picture_unit_async()
+    *
+    * Note:
+    *    - Must be set before ovdec_start(). A value of 0 (default)
+    *    disables the input queue and its decoding thread.
+    */
+   OVDEC_INPUT_QUEUE_DEPTH = 4,
+
+   /* Set a target decoding frame rate in pictures per second
+    *
+    * The decoder measures the time spent decoding pictures and parks
+    * or wakes entry and frame threads in order to sustain the target
+    * with as few active threads as possible.
+    *
+    * Note:
+    *    - A value of 0 (default) keeps all threads active.
+    *    - The number of threads given to ovdec_config_threads() is
+    *    the maximum number of active threads.
+    */
+   OVDEC_TARGET_FPS = 5,
+
+   /* Set the pictures to be skipped by the decoder as a combination
+    * of enum OVSkipFlags
+    */
+   OVDEC_SKIP_MODE = 6,
+
+   /* Only decode pictures with TemporalId lower or equal to
+    * the option value (default 6, all sub-layers)
+    */
+   OVDEC_MAX_TEMPORAL_ID = 7,
+
+   /* Skip deblocking, SAO, ALF, CC-ALF and DMVR / BDOF refinement
+    * on some pictures as a value of enum OVSkipLoopFilter
+    *
+    * Note:
+    *    - Output is not conforming to the specification.
+    *    - Skipping on non reference pictures does not propagate
+    *    errors to other pictures while skipping on all pictures
+    *    introduces drift in inter predicted pictures.
+    */
+   OVDEC_SKIP_LOOP_FILTER = 8,
+
+   /* Only reconstruct the luma component when set to 1
+    *
+    * Chroma syntax is still parsed but chroma prediction, residuals
+    * and in-loop filters are skipped. Output frames have
+    * OV_YUV_400_P8 or OV_YUV_400_P10 format and no chroma planes.
+    *
+    * Note:
+    *    - The option is only taken into account before the
+    *    first picture is submitted to the decoder.
+    */
+   OVDEC_LUMA_ONLY = 9,
+
+   /* Attach coding information to output frames when set to 1
+    *
+    * Motion fields, QP and CU partitioning of each decoded picture
+    * are made available through the side_data field of OVFrame.
+    * Side data buffers are taken from decoder pools and are released
+    * along with the frame.
+    *
+    * Note:
+    *    - The option applies to pictures started after it is set.
+    */
+   OVDEC_EXPORT_SIDE_DATA = 10,
+
    OVDEC_NB_OPTIONS,
 };
 
+enum OVSkipFlags {
+   /* Only decode IRAP pictures */
+   OVDEC_SKIP_NON_IRAP = 1,
+
+   /* Skip pictures not used as reference by other pictures
+    * (ph_non_ref_pic_flag)
+    */
+   OVDEC_SKIP_NON_REF = 2,
+
+   /* Skip pictures which cannot be correctly decoded after
+    * decoder start, ovdec_flush() or end of sequence: pictures
+    * preceding first IRAP and RASL pictures of a first CRA.
+    */
+   OVDEC_SKIP_RASL_AFTER_SEEK = 4,
+};
+
+enum OVSkipLoopFilter {
+   /* Apply all in-loop filters (default) */
+   OVDEC_SKIP_LF_NONE = 0,
+
+   /* Skip in-loop filters on pictures with ph_non_ref_pic_flag set */
+   OVDEC_SKIP_LF_NON_REF = 1,
+
+   /* Skip in-loop filters on all pictures */
+   OVDEC_SKIP_LF_ALL = 2,
+};
+
 typedef OVVCDec OVDec;
 
 /**
@@ -81,9 +188,34 @@ typedef OVVCDec OVDec;
  *
  * Notes:
  *    - Multiple Slices in same PU are currently unsupported.
+ *    - A new SPS with a different resolution or bit depth does not
+ *    require the pictures of the previous sequence to be decoded or
+ *    output first. Their buffers are released once they are no longer
+ *    in use.
  */
 int ovdec_submit_picture_unit(OVDec *ovdec, const OVPictureUnit *pu);
 
+/**
+ * Queue a new Picture Unit to be decoded by the decoder input thread.
+ *
+ * The decoder takes a new reference to the Picture Unit and returns
+ * immediately. Parameter Sets reading, Slice Header parsing and
+ * sub decoder selection are performed by a decoder owned thread in
+ * submission order.
+ *
+ * return 0 on success,
+ *        OVVC_EAGAIN if the input queue is full, the Picture Unit
+ *        should be submitted again after some pictures were received,
+ *        a negative number on failure. Errors of previously queued
+ *        Picture Units are reported by the next call.
+ *
+ * Notes:
+ *    - Requires OVDEC_INPUT_QUEUE_DEPTH to be set before ovdec_start().
+ *    - ovdec_submit_picture_unit() waits for queued Picture Units
+ *    to be processed before decoding its own Picture Unit.
+ */
+int ovdec_submit_picture_unit_async(OVDec *ovdec, OVPictureUnit *pu);
+
 /**
  * Request a reference to a picture from the decoder
  *
@@ -93,9 +225,41 @@ int ovdec_submit_picture_unit(OVDec *ovdec, const OVPictureUnit *pu);
  * Notes:
  *     - Once the user has finished working with current frame
  *     the frame must be unreferenced by calling ovframe_unref().
+ *     - When the stream does not allow any picture reordering
+ *     (e.g. all intra or low delay streams) pictures are output
+ *     in decoding order as soon as they are decoded.
  */
 int ovdec_receive_picture(OVDec *ovdec, OVFrame **frame_p);
 
+/**
+ * Same as ovdec_receive_picture() but wait up to timeout_ms
+ * milliseconds for a picture to be available for output.
+ * A negative timeout_ms waits until a picture is output and
+ * a timeout_ms of 0 does not wait.
+ *
+ * return the number of pictures available in the decoder output
+ *         a negative number on failure
+ *
+ * Notes:
+ *    - With a negative timeout, the caller must be sure a picture
+ *    will be output. Remaining pictures at end of stream must be
+ *    retrieved with ovdec_drain_picture().
+ */
+int ovdec_receive_picture_timeout(OVDec *ovdec, OVFrame **frame_p, int timeout_ms);
+
+/**
+ * Get a file descriptor to be used with poll() or epoll().
+ *
+ * The file descriptor becomes readable when a picture might be
+ * available for output. It is reset by ovdec_receive_picture()
+ * and must not be read nor closed by the caller.
+ *
+ * return a file descriptor on success,
+ *        a negative number on failure or if unsupported
+ *        on the platform.
+ */
+int ovdec_get_event_fd(OVDec *ovdec);
+
 /**
  * Drain the last pictures from the decoder output.
  *
@@ -108,12 +272,61 @@ int ovdec_receive_picture(OVDec *ovdec, OVFrame **frame_p);
  * if no EOS or EOB are explicitly signalled.
  *
  * Notes:
- *     - At the current time the decoder needs to be closed and restarted
- *     after a call to this function before attempting to resubmit a new
- *     Picture Unit. This is expected to change in future versions.
+ *     - Call ovdec_flush() once all pictures are drained before
+ *     submitting Picture Units from a new sequence.
  */
 int ovdec_drain_picture(OVDec *ovdec, OVFrame **frame_p);
 
+/**
+ * Flush the decoder.
+ *
+ * Waits for the pictures being decoded to be finished and removes
+ * all remaining pictures from the decoder without outputting them.
+ * Threads, pools and Parameter Sets are kept so the decoder can be
+ * reused for a new sequence or after a seek without being closed.
+ * Picture and line buffers are only reallocated if a new SPS requires
+ * larger buffers than those used by previous sequences.
+ *
+ * return 0 on success,
+ *        a negative number on failure.
+ *
+ * Notes:
+ *     - Pictures still to be output should be retrieved with
+ *     ovdec_drain_picture() before calling this function.
+ *     - The next submitted Picture Unit is expected to start with an
+ *     IRAP picture.
+ */
+int ovdec_flush(OVDec *ovdec);
+
+/**
+ * Set a callback to be notified of luma rows of pictures being decoded
+ * as soon as they are fully reconstructed and filtered.
+ *
+ * The callback receives the Frame being decoded and the range
+ * [y_start, y_end[ of luma rows which became available since its
+ * previous call for this Frame. Rows of a Frame are always reported
+ * in top to bottom order, and every row of a Frame is reported before
+ * it can be retrieved by ovdec_receive_picture().
+ *
+ * This is intended for low latency applications which can start
+ * processing the top of a picture before the whole picture is decoded.
+ *
+ * return 0 on success,
+ *        a negative number on failure.
+ *
+ * Notes:
+ *    - The callback is called from decoder threads and might be called
+ *    concurrently for different Frames. It should return quickly and
+ *    must not call any decoder function.
+ *    - The Frame is only valid for the duration of the call unless
+ *    the user takes a new reference on it.
+ *    - Post processing such as RPR upscaling or film grain is not
+ *    applied to the reported rows.
+ *    - Must be called before submitting the first Picture Unit.
+ *    Passing NULL disables the notifications.
+ */
+int ovdec_set_row_callback(OVDec *ovdec, OVRowCallback row_callback, void *opaque);
+
 /**
  * Initialise the OpenVVC Decoder
  *
@@ -127,6 +340,20 @@ int ovdec_init(OVDec **ovdec_p);
 
 int ovdec_config_threads(OVDec *ovdec, int nb_entry_th, int max_nb_frame_th);
 
+/**
+ * Pin entry threads on the given list of CPUs
+ *
+ * Entry thread i is pinned on cpu_list[i % nb_cpus]. If nb_cpus is 0
+ * the CPUs the process is allowed to run on are used.
+ *
+ * return 0 on success,
+ *        a negative number on failure.
+ *
+ * Notes:
+ *    - Must be called before ovdec_start().
+ */
+int ovdec_config_affinity(OVDec *ovdec, const int *cpu_list, int nb_cpus);
+
 int ovdec_start(OVDec *ovdec);
 
 /**
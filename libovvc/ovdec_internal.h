@@ -43,8 +43,8 @@
 
 struct MVPlane
 {
-
-    OVMV *mvs;
+    /* Compressed MVs on 8x8 luma blocks */
+    struct TMVPMV *mvs;
     uint64_t *dirs;
 
     /* Pool elems */
@@ -56,17 +56,31 @@ struct MVPool
 {
     MemPool *dir_pool;
     MemPool *mv_pool;
+
+    /* Block information planes exported as frame side data
+     * NULL if side data export is disabled
+     */
+    MemPool *info_pool;
     /* FIXME dimension info ?*/
 };
 
 struct PicPartInfo;
+struct Frame;
 
-int mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo);
+int mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo,
+                uint8_t export_side_data);
 
 void mvpool_uninit(struct MVPool **mv_pool_p);
 
+int mvpool_fits(const struct MVPool *mv_pool, const struct PicPartInfo *const pinfo,
+                uint8_t export_side_data);
+
 int mvpool_request_mv_plane(struct MVPool *mv_pool, struct MVPlane *mv_plane);
 
 void mvpool_release_mv_plane(struct MVPlane *mv_plane);
 
+int mvpool_attach_side_data(struct MVPool *mv_pool, struct Frame *frame,
+                            struct MVPlane *mv_plane0, struct MVPlane *mv_plane1,
+                            const struct PicPartInfo *const pinfo);
+
 #endif
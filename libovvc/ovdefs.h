@@ -81,6 +81,9 @@ typedef struct OVPS OVPS;
 typedef struct Frame OVFrame;
 typedef struct OVPicture OVPicture;
 
+/* Callback on fully decoded luma rows [y_start, y_end[ of a Frame */
+typedef void (*OVRowCallback)(void *opaque, const OVFrame *frame, int y_start, int y_end);
+
 /* */
 typedef struct DPB OVDPB;
 
@@ -223,6 +223,10 @@ static void append_nalu_elem(struct NALUnitsList *const list, struct NALUnitList
 
 static void free_nalu_elem(struct NALUnitListElem *nalu_elem);
 
+static void empty_rbsp_cache(struct RBSPCacheData *rbsp_cache);
+
+static int read_first_chunk(OVVCDmx *const dmx);
+
 int
 ovdmx_init(OVVCDmx **vvcdmx)
 {
@@ -296,27 +300,11 @@ fail:
     return -1;
 }
 
-int
-ovdmx_attach_stream(OVVCDmx *const dmx, OVIO *io)
+static int
+read_first_chunk(OVVCDmx *const dmx)
 {
     int ret = 0;
 
-    /* FiXME is this check necessary this function should not
-       be called if stream is not allocated.
-       Maybe we should open file ourselves / and use a wrapper around
-       I/Os */
-    if (io == NULL) {
-        ov_log(dmx, OVLOG_ERROR, "No stream to attach.\n");
-        return OVVC_EINDATA;
-    }
-
-    /* TODO distinguish init and open / attach */
-    dmx->io_str = ovio_stream_open(io);
-    if (dmx->io_str == NULL) {
-        ov_log(dmx, OVLOG_ERROR, "Failed to open stream.\n");
-        return OVVC_EINDATA;
-    }
-
     /* Initialise reader cache by first read */
     if (!ovio_stream_eof(dmx->io_str)) {
         struct ReaderCache *const cache_ctx = &dmx->cache_ctx;
@@ -328,7 +316,7 @@ ovdmx_attach_stream(OVVCDmx *const dmx, OVIO *io)
 
         cache_ctx->cache_end = cache_ctx->cache_start + read_in_buf;
 
-        if (read_in_buf < io->size) {
+        if (read_in_buf < ovio_stream_buff_size(dmx->io_str)) {
             dmx->eof = 1;
         }
         else {
@@ -345,6 +333,32 @@ ovdmx_attach_stream(OVVCDmx *const dmx, OVIO *io)
     return ret;
 }
 
+int
+ovdmx_attach_stream(OVVCDmx *const dmx, OVIO *io)
+{
+    int ret = 0;
+
+    /* FiXME is this check necessary this function should not
+       be called if stream is not allocated.
+       Maybe we should open file ourselves / and use a wrapper around
+       I/Os */
+    if (io == NULL) {
+        ov_log(dmx, OVLOG_ERROR, "No stream to attach.\n");
+        return OVVC_EINDATA;
+    }
+
+    /* TODO distinguish init and open / attach */
+    dmx->io_str = ovio_stream_open(io);
+    if (dmx->io_str == NULL) {
+        ov_log(dmx, OVLOG_ERROR, "Failed to open stream.\n");
+        return OVVC_EINDATA;
+    }
+
+    ret = read_first_chunk(dmx);
+
+    return ret;
+}
+
 /*FIXME share bytestream mem with OVIOStream so we avoid copying from one to
   another*/
 void
@@ -608,6 +622,96 @@ ovdmx_extract_picture_unit(OVVCDmx *const dmx, OVPictureUnit **dst_pu_p)
     return ret;
 }
 
+/* Drop demuxer state and restart reading from byte offset */
+static int
+restart_reader(OVVCDmx *const dmx, uint64_t offset)
+{
+    int ret;
+
+    free_nalu_list(&dmx->nalu_list);
+
+    if (dmx->nalu_pending) {
+        free_nalu_elem(dmx->nalu_pending);
+        dmx->nalu_pending = NULL;
+    }
+
+    empty_rbsp_cache(&dmx->rbsp_ctx);
+    dmx->epb_info.nb_epb = 0;
+    dmx->eof = 0;
+
+    memset(&dmx->cache_ctx, 0, sizeof(dmx->cache_ctx));
+
+    /* Start one byte before the start code so the reader finds
+     * a non empty segment before it
+     */
+    ret = ovio_stream_seek(dmx->io_str, offset ? offset - 1 : offset);
+    if (ret < 0) {
+        ov_log(dmx, OVLOG_ERROR, "Could not seek input stream to offset %llu\n",
+               (unsigned long long)offset);
+        return OVVC_EINDATA;
+    }
+
+    return read_first_chunk(dmx);
+}
+
+int
+ovdmx_seek(OVVCDmx *const dmx, const OVDmxIndex *index, int entry_idx)
+{
+    struct NALUnitsList ps_list = {0};
+    const struct OVDmxIndexEntry *entry;
+    uint32_t i;
+    int ret;
+
+    if (!dmx->io_str || entry_idx < 0 || entry_idx >= (int)index->nb_entries) {
+        return OVVC_EINDATA;
+    }
+
+    entry = &index->entries[entry_idx];
+
+    /* Read Parameter Sets NAL Units one by one */
+    for (i = 0; i < entry->nb_ps; ++i) {
+        uint64_t offset = index->ps_offsets[entry->ps_start + i];
+
+        ret = restart_reader(dmx, offset);
+        if (ret < 0) {
+            goto fail;
+        }
+
+        ret = extract_nal_unit(dmx, &ps_list);
+        if (ret < 0) {
+            ov_log(dmx, OVLOG_ERROR, "Could not read Parameter Set at offset %llu\n",
+                   (unsigned long long)offset);
+            ret = OVVC_EINDATA;
+            goto fail;
+        }
+    }
+
+    ret = restart_reader(dmx, entry->offset);
+    if (ret < 0) {
+        goto fail;
+    }
+
+    /* Parameter Sets are extracted before the Access Unit */
+    if (ps_list.first_nalu) {
+        ps_list.last_nalu->next_nalu = dmx->nalu_list.first_nalu;
+        if (dmx->nalu_list.first_nalu) {
+            dmx->nalu_list.first_nalu->prev_nalu = ps_list.last_nalu;
+        } else {
+            dmx->nalu_list.last_nalu = ps_list.last_nalu;
+        }
+        dmx->nalu_list.first_nalu = ps_list.first_nalu;
+    }
+
+    ov_log(dmx, OVLOG_VERBOSE, "Seek to picture %d at offset %llu\n", entry->pic_idx,
+           (unsigned long long)entry->offset);
+
+    return 0;
+
+fail:
+    free_nalu_list(&ps_list);
+    return ret;
+}
+
 static struct NALUnitListElem *
 create_nalu_elem(OVVCDmx *const dmx)
 {
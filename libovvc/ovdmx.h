@@ -37,12 +37,49 @@
 /* Experimental raw video demuxer Annex B */
 
 #include <stdio.h>
+#include <stdint.h>
 #include "ovio.h"
 #include "ovunits.h"
 
 typedef struct OVVCDmx OVVCDmx;
 typedef struct NALUnitsList NALUnitsList;
 
+/* Random access point of an Annex B stream */
+struct OVDmxIndexEntry
+{
+    /* Byte offset of the first NAL Unit of the IRAP Access Unit */
+    uint64_t offset;
+
+    /* Decoding order index of the IRAP picture in the stream */
+    uint32_t pic_idx;
+
+    /* NAL Unit type of the IRAP picture */
+    uint8_t nalu_type;
+
+    /* Parameter Sets sent before the Access Unit which might be
+     * required to decode it. Offsets are stored in stream order
+     * in ps_offsets of the index from position ps_start.
+     */
+    uint32_t ps_start;
+    uint32_t nb_ps;
+};
+
+typedef struct OVDmxIndex
+{
+    struct OVDmxIndexEntry *entries;
+    uint32_t nb_entries;
+
+    uint64_t *ps_offsets;
+    uint32_t nb_ps_offsets;
+
+    /* Number of pictures in the stream */
+    uint32_t nb_pics;
+
+    /* Allocated sizes */
+    uint32_t entries_size;
+    uint32_t ps_offsets_size;
+} OVDmxIndex;
+
 /* Initialize demuxer
  */
 int ovdmx_init(OVVCDmx **ovdmx_p);
@@ -76,5 +113,65 @@ int ovdmx_init_pu_from_list(OVPictureUnit **ovpu_p, struct NALUnitsList *const s
  */
 int ovdmx_extract_picture_unit(OVVCDmx *const ovdmx, OVPictureUnit **ovpu_p);
 
+/* Parse a VVC decoder configuration record ('vvcC' box payload)
+ *
+ * Retrieves the size in bytes of NAL Units length prefixes used
+ * in samples and creates an OVPictureUnit containing the Parameter
+ * Sets NAL Units from the record, to be submitted to the decoder
+ * before the first sample. ps_pu_p is set to NULL if the record
+ * does not contain any NAL Unit.
+ */
+int ovdmx_parse_vvcc(const uint8_t *data, size_t size, uint8_t *length_size,
+                     OVPictureUnit **ps_pu_p);
+
+/* Create an OVPictureUnit from a sample of length prefixed
+ * NAL Units (ISOBMFF 'vvc1' / 'vvi1' samples or RTP style)
+ *
+ * Note :
+ *     - The sample is not kept by the Picture Unit, NAL Units
+ *     data are copied while removing emulation prevention bytes.
+ */
+int ovdmx_extract_lp_picture_unit(const uint8_t *data, size_t size, uint8_t length_size,
+                                  OVPictureUnit **ovpu_p);
+
+/* Build a random access index of an Annex B stream
+ *
+ * Reads the whole stream from io and reports IRAP Access Units
+ * offsets and Parameter Sets they might depend on.
+ *
+ * Note :
+ *     - io must not be the one attached to a demuxer. The index
+ *     can be built from another thread on a separate OVIO of the
+ *     same file while the demuxer is in use.
+ */
+int ovdmx_index_stream(OVIO *io, OVDmxIndex **index_p);
+
+/* Write index to a sidecar file so it can be reused with
+ * ovdmx_index_load() instead of indexing the stream again.
+ */
+int ovdmx_index_save(const OVDmxIndex *index, const char *path);
+
+int ovdmx_index_load(OVDmxIndex **index_p, const char *path);
+
+void ovdmx_index_free(OVDmxIndex **index_p);
+
+/* Return the index entry of the last random access point preceding
+ * picture pic_idx in decoding order or a negative value if there is none
+ */
+int ovdmx_index_find(const OVDmxIndex *index, uint32_t pic_idx);
+
+/* Reposition demuxer at a random access point
+ *
+ * The following extracted Picture Units start with the Parameter Sets
+ * listed in the index entry followed by the IRAP Access Unit so the
+ * decoder gets all the parameters required to decode it.
+ *
+ * Note :
+ *     - The attached OVIO must support seek.
+ *     - The decoder should be drained and flushed with ovdec_flush()
+ *     before the new Picture Units are submitted.
+ */
+int ovdmx_seek(OVVCDmx *const ovdmx, const OVDmxIndex *index, int entry_idx);
+
 #endif
 
@@ -0,0 +1,527 @@
+/**
+ *
+ *   OpenVVC is open-source real time software decoder compliant with the 
+ *   ITU-T H.266- MPEG-I - Part 3 VVC standard. OpenVVC is developed from 
+ *   scratch in C as a library that provides consumers with real time and
+ *   energy-aware decoding capabilities under different OS including MAC OS,
+ *   Windows, Linux and Android targeting low energy real-time decoding of
+ *   4K VVC videos on Intel x86 and ARM platforms.
+ * 
+ *   Copyright (C) 2020-2022  IETR-INSA Rennes :
+ *   
+ *   Pierre-Loup CABARAT
+ *   Wassim HAMIDOUCHE
+ *   Guillaume GAUTIER
+ *   Thomas AMESTOY
+ *
+ *   This library is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   This library is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *   USA
+ * 
+ **/
+
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ovutils.h"
+#include "overror.h"
+#include "ovmem.h"
+
+#include "ovdmx.h"
+#include "ovio.h"
+#include "ovunits.h"
+
+/* Random access index of Annex B streams.
+ * The stream is scanned for start codes and only the NAL Unit
+ * header and the first payload byte are inspected. This is enough
+ * to retrieve Parameter Sets ids and detect picture starts.
+ */
+
+#define NB_VPS_SLOTS 16
+#define NB_SPS_SLOTS 16
+#define NB_PPS_SLOTS 64
+#define NB_APS_SLOTS (8 * 32)
+
+#define VPS_SLOT 0
+#define SPS_SLOT (VPS_SLOT + NB_VPS_SLOTS)
+#define PPS_SLOT (SPS_SLOT + NB_SPS_SLOTS)
+#define APS_SLOT (PPS_SLOT + NB_PPS_SLOTS)
+#define NB_PS_SLOTS (APS_SLOT + NB_APS_SLOTS)
+
+#define NO_OFFSET UINT64_MAX
+
+#define OVDMX_INDEX_MAGIC "OVDI"
+#define OVDMX_INDEX_VERSION 1
+
+struct IndexScanCtx
+{
+    /* Number of consecutive zero bytes read */
+    uint32_t nb_zeros;
+
+    /* NAL Unit header and first payload byte */
+    uint8_t hdr[3];
+    uint8_t nb_hdr_bytes;
+    uint8_t read_hdr;
+
+    /* Offset of current NAL Unit start code */
+    uint64_t nalu_offset;
+
+    /* Offset of the first NAL Unit of the current Access Unit
+     * if it has been found
+     */
+    uint64_t au_offset;
+
+    /* A Picture Header NAL Unit was found so next VCL NAL Unit
+     * is the first of a new picture
+     */
+    uint8_t ph_pending;
+
+    /* Offset of last received Parameter Sets per type and id */
+    uint64_t ps_offsets[NB_PS_SLOTS];
+};
+
+static int
+append_entry(OVDmxIndex *const index, const struct IndexScanCtx *const scan,
+             uint8_t nalu_type)
+{
+    struct OVDmxIndexEntry *entry;
+    uint32_t nb_ps = 0;
+    int i;
+
+    if (index->nb_entries == index->entries_size) {
+        uint32_t new_size = OVMAX(2 * index->entries_size, 64);
+        struct OVDmxIndexEntry *entries = ov_malloc(sizeof(*entries) * new_size);
+        if (!entries) {
+            return OVVC_ENOMEM;
+        }
+
+        if (index->entries) {
+            memcpy(entries, index->entries, sizeof(*entries) * index->nb_entries);
+            ov_free(index->entries);
+        }
+
+        index->entries = entries;
+        index->entries_size = new_size;
+    }
+
+    if (index->nb_ps_offsets + NB_PS_SLOTS > index->ps_offsets_size) {
+        uint32_t new_size = OVMAX(2 * index->ps_offsets_size, index->nb_ps_offsets + NB_PS_SLOTS);
+        uint64_t *ps_offsets = ov_malloc(sizeof(*ps_offsets) * new_size);
+        if (!ps_offsets) {
+            return OVVC_ENOMEM;
+        }
+
+        if (index->ps_offsets) {
+            memcpy(ps_offsets, index->ps_offsets, sizeof(*ps_offsets) * index->nb_ps_offsets);
+            ov_free(index->ps_offsets);
+        }
+
+        index->ps_offsets = ps_offsets;
+        index->ps_offsets_size = new_size;
+    }
+
+    entry = &index->entries[index->nb_entries];
+
+    entry->offset    = scan->au_offset;
+    entry->pic_idx   = index->nb_pics;
+    entry->nalu_type = nalu_type;
+    entry->ps_start  = index->nb_ps_offsets;
+
+    /* Parameter Sets inside the Access Unit will be read with it
+     * and replace any previous one with the same id.
+     * Remaining ones are sorted in stream order using insertion sort
+     * since only a few of them are expected.
+     */
+    for (i = 0; i < NB_PS_SLOTS; ++i) {
+        uint64_t offset = scan->ps_offsets[i];
+        if (offset < scan->au_offset) {
+            uint64_t *ps_offsets = &index->ps_offsets[entry->ps_start];
+            int j = nb_ps++;
+            while (j > 0 && ps_offsets[j - 1] > offset) {
+                ps_offsets[j] = ps_offsets[j - 1];
+                j--;
+            }
+            ps_offsets[j] = offset;
+        }
+    }
+
+    entry->nb_ps = nb_ps;
+
+    index->nb_ps_offsets += nb_ps;
+    index->nb_entries++;
+
+    return 0;
+}
+
+static int
+process_nalu_header(OVDmxIndex *const index, struct IndexScanCtx *const scan)
+{
+    enum OVNALUType nalu_type = scan->hdr[1] >> 3;
+    uint8_t payload = scan->hdr[2];
+    int ret = 0;
+
+    switch (nalu_type) {
+    case OVNALU_TRAIL:
+    case OVNALU_STSA:
+    case OVNALU_RADL:
+    case OVNALU_RASL:
+    case OVNALU_RSVD_VCL_4:
+    case OVNALU_RSVD_VCL_5:
+    case OVNALU_RSVD_VCL_6:
+    case OVNALU_IDR_W_RADL:
+    case OVNALU_IDR_N_LP:
+    case OVNALU_CRA:
+    case OVNALU_GDR:
+    case OVNALU_RSVD_IRAP_VCL_11:
+        /* First bit of slice header is sh_picture_header_in_slice_header_flag
+         * in which case the picture contains only one slice
+         */
+        if (scan->ph_pending || (payload & 0x80)) {
+            if (scan->au_offset == NO_OFFSET) {
+                scan->au_offset = scan->nalu_offset;
+            }
+
+            if (nalu_type >= OVNALU_IDR_W_RADL && nalu_type <= OVNALU_GDR) {
+                ret = append_entry(index, scan, nalu_type);
+            }
+
+            index->nb_pics++;
+            scan->ph_pending = 0;
+        }
+        scan->au_offset = NO_OFFSET;
+        break;
+    case OVNALU_VPS:
+        scan->ps_offsets[VPS_SLOT + (payload >> 4)] = scan->nalu_offset;
+        goto au_prefix;
+    case OVNALU_SPS:
+        scan->ps_offsets[SPS_SLOT + (payload >> 4)] = scan->nalu_offset;
+        goto au_prefix;
+    case OVNALU_PPS:
+        scan->ps_offsets[PPS_SLOT + (payload >> 2)] = scan->nalu_offset;
+        goto au_prefix;
+    case OVNALU_PREFIX_APS:
+        /* aps_params_type and aps_adaptation_parameter_set_id */
+        scan->ps_offsets[APS_SLOT + payload] = scan->nalu_offset;
+        goto au_prefix;
+    case OVNALU_SUFFIX_APS:
+        scan->ps_offsets[APS_SLOT + payload] = scan->nalu_offset;
+        break;
+    case OVNALU_PH:
+        scan->ph_pending = 1;
+        goto au_prefix;
+    case OVNALU_AUD:
+    case OVNALU_OPI:
+    case OVNALU_DCI:
+    case OVNALU_PREFIX_SEI:
+    case OVNALU_RSVD_NVCL_26:
+    case OVNALU_RSVD_NVCL_27:
+    au_prefix:
+        if (scan->au_offset == NO_OFFSET) {
+            scan->au_offset = scan->nalu_offset;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return ret;
+}
+
+static int
+scan_chunk(OVDmxIndex *const index, struct IndexScanCtx *const scan,
+           const uint8_t *buff, size_t size, uint64_t offset)
+{
+    size_t i;
+
+    for (i = 0; i < size; ++i) {
+        uint8_t byte = buff[i];
+
+        if (scan->read_hdr) {
+            scan->hdr[scan->nb_hdr_bytes++] = byte;
+            if (scan->nb_hdr_bytes == 3) {
+                int ret = process_nalu_header(index, scan);
+                if (ret < 0) {
+                    return ret;
+                }
+                scan->read_hdr = 0;
+            }
+        }
+
+        if (!byte) {
+            scan->nb_zeros++;
+        } else {
+            if (byte == 0x01 && scan->nb_zeros >= 2) {
+                scan->nalu_offset = offset + i - 2;
+                scan->nb_hdr_bytes = 0;
+                scan->read_hdr = 1;
+            }
+            scan->nb_zeros = 0;
+        }
+    }
+
+    return 0;
+}
+
+int
+ovdmx_index_stream(OVIO *io, OVDmxIndex **index_p)
+{
+    struct IndexScanCtx scan = {0};
+    OVDmxIndex *index;
+    uint64_t offset = 0;
+    uint8_t *buff;
+    int ret = 0;
+    int i;
+
+    index = ov_mallocz(sizeof(*index));
+    if (!index) {
+        return OVVC_ENOMEM;
+    }
+
+    buff = ov_malloc(io->size);
+    if (!buff) {
+        ov_free(index);
+        return OVVC_ENOMEM;
+    }
+
+    for (i = 0; i < NB_PS_SLOTS; ++i) {
+        scan.ps_offsets[i] = NO_OFFSET;
+    }
+    scan.au_offset = NO_OFFSET;
+
+    while (!io->eof(io)) {
+        size_t read_in_buf = io->read(buff, io);
+
+        /* File read returns file position instead of zero on EOF */
+        if (io->eof(io) && read_in_buf >= io->size) {
+            break;
+        }
+
+        ret = scan_chunk(index, &scan, buff, read_in_buf, offset);
+        if (ret < 0) {
+            ov_log(NULL, OVLOG_ERROR, "Failed to index stream\n");
+            ovdmx_index_free(&index);
+            goto end;
+        }
+
+        offset += read_in_buf;
+
+        if (read_in_buf < io->size) {
+            break;
+        }
+    }
+
+    ov_log(NULL, OVLOG_VERBOSE, "Indexed %d random access points over %d pictures\n",
+           index->nb_entries, index->nb_pics);
+
+end:
+    ov_free(buff);
+    *index_p = index;
+
+    return ret;
+}
+
+void
+ovdmx_index_free(OVDmxIndex **index_p)
+{
+    OVDmxIndex *index = *index_p;
+    if (index) {
+        ov_freep(&index->entries);
+        ov_freep(&index->ps_offsets);
+        ov_freep(index_p);
+    }
+}
+
+int
+ovdmx_index_find(const OVDmxIndex *index, uint32_t pic_idx)
+{
+    int lo = 0;
+    int hi = (int)index->nb_entries - 1;
+    int found = -1;
+
+    /* Entries are sorted by picture index */
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        if (index->entries[mid].pic_idx <= pic_idx) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return found;
+}
+
+/* Sidecar files use little endian fixed size fields */
+static void
+write_le(FILE *file, uint64_t val, int nb_bytes)
+{
+    uint8_t bytes[8];
+    int i;
+    for (i = 0; i < nb_bytes; ++i) {
+        bytes[i] = (val >> (8 * i)) & 0xFF;
+    }
+    fwrite(bytes, 1, nb_bytes, file);
+}
+
+static int
+read_le(FILE *file, uint64_t *val, int nb_bytes)
+{
+    uint8_t bytes[8];
+    int i;
+    if (fread(bytes, 1, nb_bytes, file) != (size_t)nb_bytes) {
+        return -1;
+    }
+
+    *val = 0;
+    for (i = 0; i < nb_bytes; ++i) {
+        *val |= (uint64_t)bytes[i] << (8 * i);
+    }
+
+    return 0;
+}
+
+int
+ovdmx_index_save(const OVDmxIndex *index, const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    uint32_t i;
+    int ret = 0;
+
+    if (!file) {
+        ov_log(NULL, OVLOG_ERROR, "Could not open index file %s\n", path);
+        return OVVC_EINDATA;
+    }
+
+    fwrite(OVDMX_INDEX_MAGIC, 1, 4, file);
+    write_le(file, OVDMX_INDEX_VERSION, 4);
+    write_le(file, index->nb_pics, 4);
+    write_le(file, index->nb_entries, 4);
+    write_le(file, index->nb_ps_offsets, 4);
+
+    for (i = 0; i < index->nb_entries; ++i) {
+        const struct OVDmxIndexEntry *entry = &index->entries[i];
+        write_le(file, entry->offset, 8);
+        write_le(file, entry->pic_idx, 4);
+        write_le(file, entry->nalu_type, 1);
+        write_le(file, entry->ps_start, 4);
+        write_le(file, entry->nb_ps, 4);
+    }
+
+    for (i = 0; i < index->nb_ps_offsets; ++i) {
+        write_le(file, index->ps_offsets[i], 8);
+    }
+
+    if (ferror(file)) {
+        ov_log(NULL, OVLOG_ERROR, "Failed to write index file %s\n", path);
+        ret = OVVC_EINDATA;
+    }
+
+    fclose(file);
+
+    return ret;
+}
+
+int
+ovdmx_index_load(OVDmxIndex **index_p, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    OVDmxIndex *index;
+    char magic[4];
+    uint64_t val[5];
+    uint32_t i;
+
+    *index_p = NULL;
+
+    if (!file) {
+        ov_log(NULL, OVLOG_ERROR, "Could not open index file %s\n", path);
+        return OVVC_EINDATA;
+    }
+
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, OVDMX_INDEX_MAGIC, 4) ||
+        read_le(file, &val[0], 4) || val[0] != OVDMX_INDEX_VERSION) {
+        ov_log(NULL, OVLOG_ERROR, "Invalid index file %s\n", path);
+        fclose(file);
+        return OVVC_EINDATA;
+    }
+
+    index = ov_mallocz(sizeof(*index));
+    if (!index) {
+        fclose(file);
+        return OVVC_ENOMEM;
+    }
+
+    if (read_le(file, &val[0], 4) || read_le(file, &val[1], 4) ||
+        read_le(file, &val[2], 4)) {
+        goto fail;
+    }
+
+    index->nb_pics         = val[0];
+    index->nb_entries      = val[1];
+    index->nb_ps_offsets   = val[2];
+    index->entries_size    = index->nb_entries;
+    index->ps_offsets_size = index->nb_ps_offsets;
+
+    if (index->nb_entries) {
+        index->entries = ov_malloc(sizeof(*index->entries) * index->nb_entries);
+        if (!index->entries) {
+            goto fail;
+        }
+    }
+
+    if (index->nb_ps_offsets) {
+        index->ps_offsets = ov_malloc(sizeof(*index->ps_offsets) * index->nb_ps_offsets);
+        if (!index->ps_offsets) {
+            goto fail;
+        }
+    }
+
+    for (i = 0; i < index->nb_entries; ++i) {
+        struct OVDmxIndexEntry *entry = &index->entries[i];
+        if (read_le(file, &val[0], 8) || read_le(file, &val[1], 4) ||
+            read_le(file, &val[2], 1) || read_le(file, &val[3], 4) ||
+            read_le(file, &val[4], 4)) {
+            goto fail;
+        }
+
+        entry->offset    = val[0];
+        entry->pic_idx   = val[1];
+        entry->nalu_type = val[2];
+        entry->ps_start  = val[3];
+        entry->nb_ps     = val[4];
+
+        if ((uint64_t)entry->ps_start + entry->nb_ps > index->nb_ps_offsets) {
+            goto fail;
+        }
+    }
+
+    for (i = 0; i < index->nb_ps_offsets; ++i) {
+        if (read_le(file, &index->ps_offsets[i], 8)) {
+            goto fail;
+        }
+    }
+
+    fclose(file);
+    *index_p = index;
+
+    return 0;
+
+fail:
+    ov_log(NULL, OVLOG_ERROR, "Invalid index file %s\n", path);
+    ovdmx_index_free(&index);
+    fclose(file);
+    return OVVC_EINDATA;
+}
@@ -0,0 +1,397 @@
+/**
+ *
+ *   OpenVVC is open-source real time software decoder compliant with the 
+ *   ITU-T H.266- MPEG-I - Part 3 VVC standard. OpenVVC is developed from 
+ *   scratch in C as a library that provides consumers with real time and
+ *   energy-aware decoding capabilities under different OS including MAC OS,
+ *   Windows, Linux and Android targeting low energy real-time decoding of
+ *   4K VVC videos on Intel x86 and ARM platforms.
+ * 
+ *   Copyright (C) 2020-2022  IETR-INSA Rennes :
+ *   
+ *   Pierre-Loup CABARAT
+ *   Wassim HAMIDOUCHE
+ *   Guillaume GAUTIER
+ *   Thomas AMESTOY
+ *
+ *   This library is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   This library is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *   USA
+ * 
+ **/
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ovutils.h"
+#include "overror.h"
+#include "ovmem.h"
+
+#include "ovdmx.h"
+#include "ovunits.h"
+
+/* Length prefixed NAL Units demuxing as used in ISO Base Media File
+ * Format samples ('vvc1' / 'vvi1' sample entries) or RTP payloads.
+ * NAL Units are directly read from samples so only Emulation Prevention
+ * Bytes need to be removed.
+ */
+
+#define OV_RBSP_PADDING 8
+
+#define OVEPB_CACHE_SIZE 16
+
+struct ByteReader
+{
+    const uint8_t *pos;
+    const uint8_t *end;
+};
+
+static int
+read_bytes(struct ByteReader *const br, uint32_t *val, int nb_bytes)
+{
+    int i;
+    if (br->end - br->pos < nb_bytes) {
+        return -1;
+    }
+
+    *val = 0;
+    for (i = 0; i < nb_bytes; ++i) {
+        *val = (*val << 8) | *br->pos++;
+    }
+
+    return 0;
+}
+
+static int
+skip_bytes(struct ByteReader *const br, size_t nb_bytes)
+{
+    if ((size_t)(br->end - br->pos) < nb_bytes) {
+        return -1;
+    }
+
+    br->pos += nb_bytes;
+
+    return 0;
+}
+
+/* Copy NAL Unit data to a new RBSP buffer removing Emulation
+ * Prevention Bytes. EPB positions are reported the same way as
+ * the Annex B demuxer does.
+ */
+static int
+init_nalu_from_data(OVNALUnit **nalu_p, const uint8_t *data, size_t size)
+{
+    OVNALUnit *nalu;
+    uint8_t *rbsp_data;
+    uint32_t *epb_pos = NULL;
+    uint32_t epb_size = 0;
+    uint32_t nb_epb = 0;
+    size_t rbsp_size = 0;
+    const uint8_t *sgmt = data;
+    const uint8_t *end = data + size;
+    const uint8_t *byte = data;
+
+    if (size < 2) {
+        ov_log(NULL, OVLOG_ERROR, "NAL Unit too short\n");
+        return OVVC_EINDATA;
+    }
+
+    nalu = ov_mallocz(sizeof(*nalu));
+    if (!nalu) {
+        return OVVC_ENOMEM;
+    }
+
+    /* FIXME Using of mallocz is to prevent padding to be not zero */
+    rbsp_data = ov_mallocz(size + OV_RBSP_PADDING);
+    if (!rbsp_data) {
+        goto fail;
+    }
+
+    /* Look for 0x000003 patterns */
+    while (byte + 2 < end) {
+        if (byte[2] > 3) {
+            byte += 3;
+        } else if (byte[2] == 3 && !byte[1] && !byte[0]) {
+            size_t sgmt_size = byte + 2 - sgmt;
+
+            memcpy(rbsp_data + rbsp_size, sgmt, sgmt_size);
+            rbsp_size += sgmt_size;
+
+            if (nb_epb == epb_size) {
+                uint32_t *tmp = ov_malloc(sizeof(*tmp) * (epb_size + OVEPB_CACHE_SIZE));
+                if (!tmp) {
+                    goto fail;
+                }
+
+                if (epb_pos) {
+                    memcpy(tmp, epb_pos, sizeof(*tmp) * nb_epb);
+                    ov_free(epb_pos);
+                }
+
+                epb_pos = tmp;
+                epb_size += OVEPB_CACHE_SIZE;
+            }
+
+            epb_pos[nb_epb++] = rbsp_size - 1;
+
+            /* Skip 0x03 byte */
+            byte += 3;
+            sgmt = byte;
+        } else {
+            byte++;
+        }
+    }
+
+    memcpy(rbsp_data + rbsp_size, sgmt, end - sgmt);
+    rbsp_size += end - sgmt;
+
+    ov_nalu_init(nalu);
+
+    nalu->type      = (data[1] >> 3) & 0x1F;
+    nalu->rbsp_data = rbsp_data;
+    nalu->rbsp_size = rbsp_size;
+    nalu->epb_pos   = epb_pos;
+    nalu->nb_epb    = nb_epb;
+
+    *nalu_p = nalu;
+
+    return 0;
+
+fail:
+    ov_freep(&epb_pos);
+    ov_freep(&rbsp_data);
+    ov_free(nalu);
+    return OVVC_ENOMEM;
+}
+
+static int
+init_pu_from_nalus(OVPictureUnit **ovpu_p, OVNALUnit **nalus, int nb_nalus)
+{
+    int ret = ovpu_init(ovpu_p, nb_nalus);
+    if (ret < 0) {
+        return ret;
+    }
+
+    memcpy((*ovpu_p)->nalus, nalus, sizeof(*nalus) * nb_nalus);
+
+    return 0;
+}
+
+static void
+free_nalus(OVNALUnit **nalus, int nb_nalus)
+{
+    int i;
+    for (i = 0; i < nb_nalus; ++i) {
+        ov_nalu_unref(&nalus[i]);
+    }
+}
+
+static int
+skip_ptl_record(struct ByteReader *const br, uint8_t num_sublayers)
+{
+    uint32_t val;
+    uint32_t nb_cstr_bytes;
+    uint32_t sublayer_flags = 0;
+    uint32_t num_sub_profiles;
+    int i;
+
+    /* reserved + num_bytes_constraint_info */
+    if (read_bytes(br, &nb_cstr_bytes, 1)) {
+        return -1;
+    }
+    nb_cstr_bytes &= 0x3F;
+
+    /* general_profile_idc, general_tier_flag, general_level_idc,
+     * frame only and multilayer flags and general_constraint_info
+     */
+    if (skip_bytes(br, 2 + nb_cstr_bytes)) {
+        return -1;
+    }
+
+    /* ptl_sublayer_level_present_flags and reserved bits */
+    if (num_sublayers > 1 && read_bytes(br, &sublayer_flags, 1)) {
+        return -1;
+    }
+
+    for (i = num_sublayers - 2; i >= 0; --i) {
+        if (sublayer_flags & (0x80 >> (num_sublayers - 2 - i))) {
+            if (read_bytes(br, &val, 1)) {
+                return -1;
+            }
+        }
+    }
+
+    if (read_bytes(br, &num_sub_profiles, 1)) {
+        return -1;
+    }
+
+    return skip_bytes(br, 4 * num_sub_profiles);
+}
+
+int
+ovdmx_parse_vvcc(const uint8_t *data, size_t size, uint8_t *length_size,
+                 OVPictureUnit **ps_pu_p)
+{
+    struct ByteReader br = {data, data + size};
+    OVNALUnit *nalus[255];
+    int nb_nalus = 0;
+    uint32_t val;
+    uint32_t num_of_arrays;
+    uint32_t i, j;
+    int ret = OVVC_EINDATA;
+
+    *ps_pu_p = NULL;
+
+    /* reserved, LengthSizeMinusOne, ptl_present_flag */
+    if (read_bytes(&br, &val, 1)) {
+        goto fail;
+    }
+
+    *length_size = ((val >> 1) & 0x3) + 1;
+
+    if (val & 0x1) {
+        uint8_t num_sublayers;
+
+        /* ols_idx, num_sublayers, constant_frame_rate, chroma_format_idc,
+         * bit_depth_minus8
+         */
+        if (read_bytes(&br, &val, 3)) {
+            goto fail;
+        }
+
+        num_sublayers = (val >> 12) & 0x7;
+
+        if (skip_ptl_record(&br, num_sublayers)) {
+            goto fail;
+        }
+
+        /* max_picture_width, max_picture_height, avg_frame_rate */
+        if (skip_bytes(&br, 6)) {
+            goto fail;
+        }
+    }
+
+    if (read_bytes(&br, &num_of_arrays, 1)) {
+        goto fail;
+    }
+
+    for (i = 0; i < num_of_arrays; ++i) {
+        uint32_t nalu_type;
+        uint32_t num_nalus = 1;
+
+        if (read_bytes(&br, &nalu_type, 1)) {
+            goto fail;
+        }
+
+        nalu_type &= 0x1F;
+
+        if (nalu_type != OVNALU_DCI && nalu_type != OVNALU_OPI) {
+            if (read_bytes(&br, &num_nalus, 2)) {
+                goto fail;
+            }
+        }
+
+        for (j = 0; j < num_nalus; ++j) {
+            uint32_t nalu_length;
+            if (read_bytes(&br, &nalu_length, 2) || br.end - br.pos < nalu_length) {
+                goto fail;
+            }
+
+            if (nb_nalus == sizeof(nalus) / sizeof(*nalus)) {
+                ov_log(NULL, OVLOG_ERROR, "Too many NAL Units in configuration record\n");
+                goto fail;
+            }
+
+            ret = init_nalu_from_data(&nalus[nb_nalus], br.pos, nalu_length);
+            if (ret < 0) {
+                goto fail;
+            }
+
+            nb_nalus++;
+            br.pos += nalu_length;
+        }
+    }
+
+    if (nb_nalus) {
+        ret = init_pu_from_nalus(ps_pu_p, nalus, nb_nalus);
+        if (ret < 0) {
+            goto fail;
+        }
+    }
+
+    return 0;
+
+fail:
+    if (ret == OVVC_EINDATA) {
+        ov_log(NULL, OVLOG_ERROR, "Invalid VVC decoder configuration record\n");
+    }
+    free_nalus(nalus, nb_nalus);
+    return ret < 0 ? ret : OVVC_EINDATA;
+}
+
+int
+ovdmx_extract_lp_picture_unit(const uint8_t *data, size_t size, uint8_t length_size,
+                              OVPictureUnit **ovpu_p)
+{
+    struct ByteReader br = {data, data + size};
+    OVNALUnit *nalus[255];
+    int nb_nalus = 0;
+    int ret;
+
+    *ovpu_p = NULL;
+
+    if (length_size < 1 || length_size > 4) {
+        return OVVC_EINDATA;
+    }
+
+    while (br.pos < br.end) {
+        uint32_t nalu_length;
+
+        if (read_bytes(&br, &nalu_length, length_size) || br.end - br.pos < nalu_length) {
+            ov_log(NULL, OVLOG_ERROR, "Invalid NAL Unit length in sample\n");
+            ret = OVVC_EINDATA;
+            goto fail;
+        }
+
+        if (nb_nalus == sizeof(nalus) / sizeof(*nalus)) {
+            ov_log(NULL, OVLOG_ERROR, "Too many NAL Units in sample\n");
+            ret = OVVC_EINDATA;
+            goto fail;
+        }
+
+        ret = init_nalu_from_data(&nalus[nb_nalus], br.pos, nalu_length);
+        if (ret < 0) {
+            goto fail;
+        }
+
+        nb_nalus++;
+        br.pos += nalu_length;
+    }
+
+    if (!nb_nalus) {
+        return OVVC_EINDATA;
+    }
+
+    ret = init_pu_from_nalus(ovpu_p, nalus, nb_nalus);
+    if (ret < 0) {
+        goto fail;
+    }
+
+    return 0;
+
+fail:
+    free_nalus(nalus, nb_nalus);
+    return ret;
+}
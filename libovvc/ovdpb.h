@@ -112,6 +112,17 @@ struct OVPicture
         int mask_w;
         pthread_mutex_t *ref_mtx;
         pthread_cond_t  *ref_cnd;
+
+        /* Output of fully decoded CTU lines to the user
+         * for low latency applications
+         */
+        pthread_mutex_t out_mtx;
+        OVRowCallback row_cb;
+        void *row_cb_opaque;
+        uint16_t nb_ctb_w;
+        uint16_t nb_ctb_h;
+        uint8_t log2_ctb_s;
+        uint16_t nb_lines_out;
     } decoded_ctus;
 
     atomic_uint idx_function;
@@ -192,20 +203,52 @@ struct DPB
     */
    uint8_t state;
 
+   /* Pictures to be output in decoding order when
+    * the stream does not allow any reordering
+    * This avoids looking up the DPB for the next
+    * picture to output
+    */
+   struct OutputFIFO {
+       OVPicture *pic[64];
+       int32_t poc[64];
+       uint16_t cvs_id[64];
+       uint8_t first_idx;
+       uint8_t nb_pic;
+   } output_fifo;
+
+   /* Dimensions of decoded CTUs maps required by
+    * the pictures of the active SPS
+    */
+   int ctus_mask_w;
+   int ctus_mask_h;
+
    struct DPBInternal internal;
    uint64_t nb_units_in_ticks;
    uint64_t pts;
 };
 
-int ovdpb_init(OVDPB **dpb_p, const OVPS *ps);
+struct ThreadPlacement;
+int ovdpb_init(OVDPB **dpb_p, const OVPS *ps, const struct ThreadPlacement *const placement,
+               uint8_t luma_only);
 
 void ovdpb_uninit(OVDPB **dpb_p);
 
+int ovdpb_fits_sps(const OVDPB *dpb, const OVSPS *const sps);
+
+int ovdpb_realloc(OVDPB *dpb, const OVPS *ps, const struct ThreadPlacement *const placement);
+
+void ovdpb_update_params(OVDPB *dpb, const OVPS *ps);
+
 int ovdpb_init_picture(OVDPB *dpb, OVPicture **pic, const OVPS *const ps, uint8_t nalu_type, 
                    OVSliceDec *const sldec, const OVVCDec *ovdec);
 
+void ovdpb_update_skipped_poc(OVDPB *dpb, const OVPH *const ph, const OVSPS *const sps,
+                              uint8_t nalu_type);
+
 void ovdpb_flush_dpb(OVDPB *dpb);
 
+void ovdpb_clear_dpb(OVDPB *dpb);
+
 void ovdpb_unref_pic(OVPicture *pic, int flags);
 
 void ovdpb_release_pic(OVDPB *dpb, OVPicture *pic);
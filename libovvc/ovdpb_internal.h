@@ -37,22 +37,33 @@
 #include "ovdpb.h"
 #include "ovdefs.h"
 #include "ovframe.h"
+#include "dec_structures.h"
 
 struct FramePool;
 
 struct DPBInternal
 {
-    struct FramePool *frame_pool;
+    /* One frame pool per NUMA node frame threads
+     * are bound to
+     */
+    struct FramePool *frame_pool[OV_MAX_NUMA_NODES];
+    uint8_t nb_pools;
+
+    /* Frames are allocated without chroma planes */
+    uint8_t luma_only;
 };
 
 void dpb_uninit_framepool(struct DPBInternal *dpb_priv);
 
 int dpb_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps);
 
-int dpbpriv_request_frame(struct DPBInternal *dpb_priv, OVFrame **frame);
+int dpbpriv_request_frame(struct DPBInternal *dpb_priv, OVFrame **frame, uint8_t pool_idx);
 
 void dpbpriv_uninit_framepool(struct DPBInternal *dpb_priv);
 
-int dpbpriv_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps);
+int dpbpriv_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps,
+                           const struct ThreadPlacement *const placement);
+
+int dpbpriv_framepool_fits(const struct DPBInternal *dpb_priv, const OVSPS *const sps);
 
 #endif
@@ -43,6 +43,10 @@ enum ChromaFmt
 {
     OV_YUV_420_P8  = 0,
     OV_YUV_420_P10 = 1,
+
+    /* Luma only frames, data[1] and data[2] are NULL */
+    OV_YUV_400_P8  = 2,
+    OV_YUV_400_P10 = 3,
 };
 
 struct ColorDescription
@@ -60,6 +64,72 @@ struct FrameInfo
     struct ColorDescription color_desc;
 };
 
+/* Type of a Coding Unit as reported in frame side data */
+enum OVCUType
+{
+    OV_CU_INTER = 1,
+    OV_CU_INTRA = 2,
+    OV_CU_INTER_SKIP = 3,
+    OV_CU_MIP = 4,
+    OV_CU_AFFINE = 5,
+    OV_CU_INTER_SKIP_AFFINE = 6,
+    OV_CU_IBC = 7,
+    OV_CU_IBC_SKIP = 8,
+};
+
+/* Coding information of a 4x4 luma block */
+struct OVBlockInfo
+{
+    /* Top left luma sample position of the CU containing the block */
+    uint16_t cu_x;
+    uint16_t cu_y;
+
+    /* Luma QP of the CU */
+    int8_t qp;
+
+    /* Value of enum OVCUType */
+    uint8_t cu_type;
+
+    uint8_t log2_cu_w;
+    uint8_t log2_cu_h;
+};
+
+/* Motion vector of a 8x8 luma block in 1/16 sample precision */
+struct OVMotionVector
+{
+    int32_t x;
+    int32_t y;
+
+    /* Index in reference picture list or -1 if the list
+     * is not used by the block
+     */
+    int8_t ref_idx;
+    uint8_t reserved[3];
+};
+
+/* Coding information of a decoded picture
+ *
+ * Block grids cover the picture rounded up to CTU size
+ * and are stored in raster order.
+ */
+struct OVFrameSideData
+{
+    /* Per 4x4 luma block information */
+    struct OVBlockInfo *blk_info;
+    uint32_t blk_stride;
+    uint16_t nb_blk_w;
+    uint16_t nb_blk_h;
+
+    /* Per 8x8 luma block motion vectors for reference lists
+     * L0 and L1. Set to NULL when the picture has no motion
+     * for the list.
+     */
+    struct OVMotionVector *mvs[2];
+    uint32_t mv_stride;
+    uint16_t nb_mv_w;
+    uint16_t nb_mv_h;
+};
+
 struct FramePool;
 
 /* OVFrame private data */
@@ -71,6 +141,9 @@ struct FrameInternal
     struct FramePool *frame_pool;
     void *felem;
     void *pool_elem[4];
+
+    /* Pool elements of side data */
+    void *sd_elem[5];
 };
 
 struct Window
@@ -114,6 +187,11 @@ struct Frame
 
     struct FrameInfo frame_info;
 
+    /* Coding information on the picture, NULL unless
+     * OVDEC_EXPORT_SIDE_DATA option is set
+     */
+    struct OVFrameSideData *side_data;
+
     /* OVFrame Private data
      * Do not modify.
      */
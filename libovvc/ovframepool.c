@@ -83,8 +83,31 @@ static const struct ChromaFmtInfo yuv420_10 = {
   .shift_v = {0, 1, 1},
 };
 
-static const struct ChromaFmtInfo *const select_frame_format(enum ChromaFmt fmt, uint8_t bitdepth_min8)
+static const struct ChromaFmtInfo yuv400_8 = {
+  .nb_comp = 1,
+  .bd_shift = 0,
+  .shift_h = {0, 1, 1},
+  .shift_v = {0, 1, 1},
+};
+
+static const struct ChromaFmtInfo yuv400_10 = {
+  .nb_comp = 1,
+  .bd_shift = 1,
+  .shift_h = {0, 1, 1},
+  .shift_v = {0, 1, 1},
+};
+
+/* Note fmt is a chroma_format_idc value. Monochrome pictures are still
+ * reconstructed into 4:2:0 frames, only luma_only selects frames without
+ * chroma planes.
+ */
+static const struct ChromaFmtInfo *const select_frame_format(uint8_t fmt, uint8_t luma_only,
+                                                             uint8_t bitdepth_min8)
 {
+    if (luma_only) {
+        return bitdepth_min8 ? &yuv400_10 : &yuv400_8;
+    }
+
     if (bitdepth_min8) {
         return &yuv420_10;
     } else {
@@ -121,9 +144,10 @@ ovframepool_uninit(struct FramePool **fpool_p)
 }
 
 int
-ovframepool_init(struct FramePool **fpool_p, uint8_t fmt, uint8_t bitdepth_min8, uint16_t pic_w, uint16_t pic_h)
+ovframepool_init(struct FramePool **fpool_p, uint8_t fmt, uint8_t luma_only, uint8_t bitdepth_min8,
+                 uint16_t pic_w, uint16_t pic_h, int node)
 {
-    const struct ChromaFmtInfo *const fmt_info = select_frame_format(fmt, bitdepth_min8);
+    const struct ChromaFmtInfo *const fmt_info = select_frame_format(fmt, luma_only, bitdepth_min8);
 
     /* FIXME allocation size overflow */
     size_t pic_size = (pic_w * pic_h) << fmt_info->bd_shift;
@@ -139,7 +163,11 @@ ovframepool_init(struct FramePool **fpool_p, uint8_t fmt, uint8_t bitdepth_min8,
     fpool = *fpool_p;
 
     fpool->fmt_info = fmt_info;
-    fpool->fmt_c = bitdepth_min8 ? OV_YUV_420_P10 : OV_YUV_420_P8;
+    if (fmt_info->nb_comp == 1) {
+        fpool->fmt_c = bitdepth_min8 ? OV_YUV_400_P10 : OV_YUV_400_P8;
+    } else {
+        fpool->fmt_c = bitdepth_min8 ? OV_YUV_420_P10 : OV_YUV_420_P8;
+    }
 
     fpool->frame_pool = ovmempool_init(sizeof(OVFrame));
     if (!fpool->frame_pool) {
@@ -150,7 +178,7 @@ ovframepool_init(struct FramePool **fpool_p, uint8_t fmt, uint8_t bitdepth_min8,
         uint8_t comp_shift = fmt_info->shift_h[i] + fmt_info->shift_v[i];
         size_t elem_size = pic_size >> comp_shift;
 
-        fpool->plane_pool[i] = ovmempool_init(elem_size);
+        fpool->plane_pool[i] = ovmempool_init_on_node(elem_size, node);
 
         if (!fpool->plane_pool[i]) {
             goto fail_poolinit;
@@ -170,6 +198,20 @@ fail_alloc:
     return OVVC_ENOMEM;
 }
 
+/* Check if frames from the pool can hold pictures of
+ * the given format and dimensions
+ */
+int
+ovframepool_fits(const struct FramePool *fpool, uint8_t fmt, uint8_t luma_only, uint8_t bitdepth_min8,
+                 uint16_t pic_w, uint16_t pic_h)
+{
+    const struct ChromaFmtInfo *const fmt_info = select_frame_format(fmt, luma_only, bitdepth_min8);
+
+    return fpool->fmt_info == fmt_info &&
+           fpool->plane_prop[0].width  >= pic_w &&
+           fpool->plane_prop[0].height >= pic_h;
+}
+
 static void
 ovframepool_release_planes(OVFrame *const frame)
 {
@@ -218,9 +260,10 @@ ovframepool_request_planes(OVFrame *const frame, struct FramePool *const fpool)
 
         frame->size[i]     = pool->elem_size;
 
-        frame->frame_info.chroma_format = fpool->fmt_c;
     }
 
+    frame->frame_info.chroma_format = fpool->fmt_c;
+
     atomic_init(&frame->internal.ref_count, 0);
 
     return 0;
@@ -263,10 +306,22 @@ ovframepool_request_frame(struct FramePool *fpool)
     return frame;
 }
 
+static void
+ovframepool_release_side_data(OVFrame *const frame)
+{
+    int i;
+    for (i = 0; i < 5; ++i) {
+        ovmempool_pushelem(frame->internal.sd_elem[i]);
+        frame->internal.sd_elem[i] = NULL;
+    }
+    frame->side_data = NULL;
+}
+
 void
 ovframepool_release_frame(OVFrame **frame_p)
 {
     ovframepool_release_planes(*frame_p);
+    ovframepool_release_side_data(*frame_p);
     ovmempool_pushelem((*frame_p)->internal.felem);
     *frame_p = NULL;
 }
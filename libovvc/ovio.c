@@ -80,8 +80,15 @@ static int OVFileIOEOF(OVIO* io)
     return feof(file_io->file);
 }
 
+static int OVFileIOSeek(OVIO* io, uint64_t pos)
+{
+    OVFileIO* file_io = (OVFileIO*) io;
+    return fseek(file_io->file, (long)pos, SEEK_SET);
+}
+
 const OVFileIO defaultFileIO = {
-  .super = { .close = OVFileIOClose, .read = OVFileIORead, .eof = OVFileIOEOF, .size = OVIO_FILEIO_BUFF_SIZE },
+  .super = { .close = OVFileIOClose, .read = OVFileIORead, .eof = OVFileIOEOF, .seek = OVFileIOSeek,
+             .size = OVIO_FILEIO_BUFF_SIZE },
   .file = NULL
 };
 
@@ -215,3 +222,15 @@ ovio_stream_buff_size(OVIOStream* const io_str)
     OVIO *io = io_str->io;
     return io->size;
 }
+
+int
+ovio_stream_seek(OVIOStream *const io_str, uint64_t pos)
+{
+    OVIO *io = io_str->io;
+
+    if (!io->seek) {
+        return -1;
+    }
+
+    return io->seek(io, pos) ? -1 : 0;
+}
@@ -50,6 +50,11 @@ typedef struct OVIO {
     int (*const close)(struct OVIO*);
     size_t (*const read)(void *, struct OVIO*);
     int (*const eof)(struct OVIO*);
+
+    /* Set read position to an absolute byte offset.
+     * Can be NULL if the input cannot be repositioned.
+     */
+    int (*const seek)(struct OVIO*, uint64_t);
     size_t size;
 } OVIO;
 
@@ -70,4 +75,10 @@ int ovio_stream_eof(OVIOStream *const io_str);
 
 size_t ovio_stream_buff_size(OVIOStream* const io_str);
 
+/* Reposition stream at byte offset pos
+ * Returns 0 on success, -1 if the underlying OVIO is not seekable or
+ * failed to seek.
+ */
+int ovio_stream_seek(OVIOStream *const io_str, uint64_t pos);
+
 #endif
@@ -36,6 +36,11 @@
 #include "ovmem.h"
 #include "ovconfig.h"
 
+#if HAVE_LIBNUMA
+#include <numa.h>
+#include <unistd.h>
+#endif
+
 
 /* Wrappers around memory related function this will
    be useful if we plan later to adapt our allocations to
@@ -83,6 +88,33 @@ ov_mallocz(size_t alloc_size)
     return ptr;
 }
 
+/* Same as ov_mallocz() except the pages backing the allocation
+   are bound to the requested NUMA node before being first touched.
+   The returned pointer is to be released with ov_free().
+   Falls back to ov_mallocz() if node is negative or libnuma is not
+   available. */
+void *
+ov_mallocz_on_node(size_t alloc_size, int node)
+{
+#if HAVE_LIBNUMA && HAVE_POSIX_MEMALIGN
+    if (node >= 0 && alloc_size && numa_available() >= 0) {
+        long page_size = sysconf(_SC_PAGESIZE);
+        void *ptr;
+
+        if (posix_memalign(&ptr, page_size > ALIGN ? page_size : ALIGN, alloc_size)) {
+            return NULL;
+        }
+
+        numa_tonode_memory(ptr, alloc_size, node);
+
+        memset(ptr, 0, alloc_size);
+
+        return ptr;
+    }
+#endif
+    return ov_mallocz(alloc_size);
+}
+
 void
 ov_free(void *ptr)
 {
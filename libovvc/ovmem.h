@@ -44,6 +44,8 @@ void *ov_malloc(size_t alloc_size) ov_malloc_attrib;
 
 void *ov_mallocz(size_t alloc_size) ov_malloc_attrib;
 
+void *ov_mallocz_on_node(size_t alloc_size, int node) ov_malloc_attrib;
+
 void ov_free(void *ptr);
 
 void ov_freep(void *ptr_ref);
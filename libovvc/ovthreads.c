@@ -31,10 +31,19 @@
  * 
  **/
 
+#if __linux__
+#define _GNU_SOURCE
+#include <sched.h>
+#endif
+
 #include <pthread.h>
 /* FIXME tmp*/
 #include <stdatomic.h>
 
+#if !_WIN32
+#include <unistd.h>
+#endif
+
 #include "slicedec.h"
 #include "overror.h"
 #include "ovutils.h"
@@ -43,16 +52,18 @@
 #include "ovdpb.h"
 
 
+/* Entry thread running on current OS thread if any */
+static _Thread_local struct EntryThread *current_entry_th;
+
 static int
-ovthread_decode_entry(struct EntryJob *entry_job, struct EntryThread *entry_th)
+ovthread_decode_entry(struct EntryJob *entry_job, OVCTUDec *const ctudec)
 {   
     struct SliceSynchro* slice_sync = entry_job->slice_sync;
-    uint8_t entry_idx              = entry_job->entry_idx;
+    uint16_t entry_idx             = entry_job->entry_idx;
 
     uint16_t nb_entries  = slice_sync->nb_entries;
     ov_log(NULL, OVLOG_DEBUG, "Decoder with POC %d, start entry %d\n", slice_sync->owner->pic->poc, entry_idx);
     
-    OVCTUDec *const ctudec  = entry_th->ctudec;
     OVSliceDec *const sldec = slice_sync->owner;
     const OVPS *const prms  = sldec->active_params;
 
@@ -65,56 +76,201 @@ ovthread_decode_entry(struct EntryJob *entry_job, struct EntryThread *entry_th)
 }
 
 
-struct EntryJob *
-entry_thread_select_job(struct EntryThread *entry_th)
+/* Swap job at FIFO index i with the head of the FIFO
+ */
+static void
+move_job_to_head(struct MainThread *main_thread, int64_t first_idx, int64_t i)
+{
+    struct EntryJob *entry_jobs_fifo = main_thread->entry_jobs_fifo;
+    int size_fifo = main_thread->size_fifo;
+
+    if (i != first_idx) {
+        struct EntryJob *head = &entry_jobs_fifo[first_idx % size_fifo];
+        struct EntryJob *entry_job = &entry_jobs_fifo[i % size_fifo];
+        struct EntryJob tmp = *head;
+        *head = *entry_job;
+        *entry_job = tmp;
+    }
+}
+
+/* Move the first job of the FIFO belonging to a frame thread bound to
+ * the same NUMA node as the entry thread to the head of the FIFO
+ * so pictures are decoded by threads of a unique socket
+ * when possible.
+ */
+static void
+prioritize_local_job(struct EntryThread *entry_th, int64_t first_idx, int64_t last_idx)
 {
-    /* Get the first available job in the job fifo. 
-     */
     struct MainThread* main_thread = entry_th->main_thread;
-    uint16_t size_fifo = main_thread->size_fifo; 
     struct EntryJob *entry_jobs_fifo = main_thread->entry_jobs_fifo;
-    struct EntryJob *entry_job = NULL;
+    int size_fifo = main_thread->size_fifo;
+    int64_t i;
+
+    for (i = first_idx; i <= last_idx; ++i) {
+        struct EntryJob *entry_job = &entry_jobs_fifo[i % size_fifo];
+        if (entry_job->slice_sync->owner->node_idx == entry_th->node_idx) {
+            move_job_to_head(main_thread, first_idx, i);
+            return;
+        }
+    }
+}
+
+/* Move the tile on the right of (or else below) the last tile decoded
+ * by the entry thread to the head of the FIFO if it is still pending
+ * so neighbouring tiles tend to be decoded by the same thread.
+ * Return 1 if such a job was found.
+ */
+static int
+prioritize_neighbour_job(struct EntryThread *entry_th, int64_t first_idx, int64_t last_idx)
+{
+    struct MainThread* main_thread = entry_th->main_thread;
+    struct EntryJob *entry_jobs_fifo = main_thread->entry_jobs_fifo;
+    const struct SliceSynchro *slice_sync = entry_th->last_slice_sync;
+    int size_fifo = main_thread->size_fifo;
+    int nb_tile_cols = entry_th->last_nb_tile_cols;
+    int right_idx = entry_th->last_entry_idx + 1;
+    int below_idx = entry_th->last_entry_idx + nb_tile_cols;
+    int64_t below_pos = -1;
+    int64_t i;
+
+    /* No right neighbour on last tile column */
+    if (right_idx % nb_tile_cols == 0) {
+        right_idx = -1;
+    }
+
+    for (i = first_idx; i <= last_idx; ++i) {
+        struct EntryJob *entry_job = &entry_jobs_fifo[i % size_fifo];
+        if (entry_job->slice_sync == slice_sync) {
+            if (entry_job->entry_idx == right_idx) {
+                move_job_to_head(main_thread, first_idx, i);
+                return 1;
+            } else if (entry_job->entry_idx == below_idx) {
+                below_pos = i;
+            }
+        }
+    }
+
+    if (below_pos >= 0) {
+        move_job_to_head(main_thread, first_idx, below_pos);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Copy the next job to be decoded by the entry thread into entry_job.
+ * Return 1 if a job was available.
+ */
+static int
+entry_thread_select_job(struct EntryThread *entry_th, struct EntryJob *entry_job)
+{
+    struct MainThread* main_thread = entry_th->main_thread;
+    int th_idx = entry_th - main_thread->entry_threads_list;
+    int found = 0;
 
     pthread_mutex_lock(&main_thread->main_mtx); 
     int64_t first_idx = main_thread->first_idx_fifo;
     int64_t last_idx  = main_thread->last_idx_fifo;
-    if (first_idx <= last_idx) {
-        int idx = first_idx % size_fifo;
-        entry_job = &entry_jobs_fifo[idx];
+
+    main_thread->busy_time_us += entry_th->busy_time_us;
+    entry_th->busy_time_us = 0;
+
+    /* Parked threads do not pick jobs */
+    if (first_idx <= last_idx && th_idx < main_thread->nb_active_entry_th) {
+        uint8_t has_neighbour = 0;
+        if (entry_th->last_slice_sync) {
+            has_neighbour = prioritize_neighbour_job(entry_th, first_idx, last_idx);
+        }
+
+        if (!has_neighbour && entry_th->cpu >= 0) {
+            prioritize_local_job(entry_th, first_idx, last_idx);
+        }
+
+        /* Copy job since FIFO might be reallocated once unlocked */
+        *entry_job = main_thread->entry_jobs_fifo[first_idx % main_thread->size_fifo];
         main_thread->first_idx_fifo ++;
+        found = 1;
     }
     pthread_mutex_unlock(&main_thread->main_mtx);
 
-    return entry_job;
+    return found;
 }
 
 
+static void
+entry_thread_set_affinity(struct EntryThread *entry_th)
+{
+#if __linux__
+    cpu_set_t cpu_set;
+
+    CPU_ZERO(&cpu_set);
+    CPU_SET(entry_th->cpu, &cpu_set);
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)) {
+        ov_log(NULL, OVLOG_WARNING, "Could not pin entry thread on CPU %d\n", entry_th->cpu);
+    }
+#else
+    ov_log(NULL, OVLOG_WARNING, "Thread affinity is not supported on this platform\n");
+#endif
+}
+
 static void *
 entry_thread_main_function(void *opaque)
 {
     struct EntryThread *entry_th = (struct EntryThread *)opaque;
     struct MainThread* main_thread = entry_th->main_thread;
+    int ret;
+
+    if (entry_th->cpu >= 0) {
+        entry_thread_set_affinity(entry_th);
+    }
+
+    current_entry_th = entry_th;
+
+    /* The CTU decoder is allocated by the entry thread itself so its
+     * working buffers are first touched on the CPU it is pinned on
+     * and thus allocated on the local NUMA node.
+     */
+    ret = ctudec_init(&entry_th->ctudec);
 
     pthread_mutex_lock(&entry_th->entry_mtx);
     entry_th->state = IDLE;
+    entry_th->init_done = 1;
+    pthread_cond_signal(&entry_th->entry_cnd);
     pthread_mutex_unlock(&entry_th->entry_mtx);
 
+    if (ret < 0) {
+        ov_log(NULL, OVLOG_ERROR, "Failed line decoder initialisation\n");
+        return NULL;
+    }
+
     while (!entry_th->kill){
 
-        struct EntryJob *entry_job = entry_thread_select_job(entry_th);
+        struct EntryJob entry_job;
 
-        if (entry_job) {
-            slicedec_update_entry_decoder(entry_job->slice_sync->owner, entry_th->ctudec);
+        if (entry_thread_select_job(entry_th, &entry_job)) {
+            slicedec_update_entry_decoder(entry_job.slice_sync->owner, entry_th->ctudec);
             pthread_mutex_lock(&entry_th->entry_mtx);
             entry_th->state = ACTIVE;
             pthread_mutex_unlock(&entry_th->entry_mtx);
 
-            uint8_t is_last = ovthread_decode_entry(entry_job, entry_th);
+            uint64_t start_time = get_time_us();
+
+            uint8_t is_last = ovthread_decode_entry(&entry_job, entry_th->ctudec);
+
+            entry_th->busy_time_us += get_time_us() - start_time;
+
+            /* Slice synchro might be reused by a new picture once its
+             * last entry is decoded
+             */
+            entry_th->last_slice_sync = is_last ? NULL : entry_job.slice_sync;
+            entry_th->last_entry_idx  = entry_job.entry_idx;
+            entry_th->last_nb_tile_cols = entry_job.nb_tile_cols;
 
             /* Check if the entry was the last of the slice
              */
             if (is_last) {
-                slicedec_finish_decoding(entry_job->slice_sync->owner);
+                slicedec_finish_decoding(entry_job.slice_sync->owner);
             }
         } else {
             pthread_mutex_lock(&main_thread->entry_threads_mtx);
@@ -140,13 +296,7 @@ ovthread_init_entry_thread(struct EntryThread *entry_th)
 {
     entry_th->state = IDLE;
     entry_th->kill  = 0;
-
-    int ret = ctudec_init(&entry_th->ctudec);
-    if (ret < 0) {
-        ov_log(NULL, OVLOG_ERROR, "Failed line decoder initialisation\n");
-        ctudec_uninit(entry_th->ctudec);
-        return OVVC_ENOMEM;
-    }
+    entry_th->init_done = 0;
 
     pthread_mutex_init(&entry_th->entry_mtx, NULL);
     pthread_cond_init(&entry_th->entry_cnd, NULL);
@@ -158,6 +308,23 @@ ovthread_init_entry_thread(struct EntryThread *entry_th)
         ov_log(NULL, OVLOG_ERROR, "Thread creation failed at decoder init\n");
         return OVVC_ENOMEM;
     }
+
+    /* Wait for the entry thread to allocate its CTU decoder */
+    while (!entry_th->init_done) {
+        pthread_cond_wait(&entry_th->entry_cnd, &entry_th->entry_mtx);
+    }
+
+    if (!entry_th->ctudec) {
+        pthread_mutex_unlock(&entry_th->entry_mtx);
+        pthread_join(entry_th->thread, NULL);
+        return OVVC_ENOMEM;
+    }
+#else
+    if (ctudec_init(&entry_th->ctudec) < 0) {
+        pthread_mutex_unlock(&entry_th->entry_mtx);
+        ov_log(NULL, OVLOG_ERROR, "Failed line decoder initialisation\n");
+        return OVVC_ENOMEM;
+    }
 #endif
     pthread_mutex_unlock(&entry_th->entry_mtx);
     return 1;
@@ -170,9 +337,153 @@ ovthread_uninit_entry_thread(struct EntryThread *entry_th)
         pthread_mutex_destroy(&entry_th->entry_mtx);
         pthread_cond_destroy(&entry_th->entry_cnd);
 
-        ctudec_uninit(entry_th->ctudec);
+        if (entry_th->ctudec) {
+            ctudec_uninit(entry_th->ctudec);
+        }
+
+        if (entry_th->spare_ctudec) {
+            ctudec_uninit(entry_th->spare_ctudec);
+        }
 }
 
+/* Pop the first pending job of the FIFO belonging to the picture
+ * being decoded into pic.
+ * Return 1 if such a job was found.
+ */
+static int
+select_pic_job(struct MainThread *main_thread, const OVPicture *const pic,
+               struct EntryJob *entry_job)
+{
+    int size_fifo;
+    int found = 0;
+    int64_t i;
+
+    pthread_mutex_lock(&main_thread->main_mtx);
+    size_fifo = main_thread->size_fifo;
+    int64_t first_idx = main_thread->first_idx_fifo;
+    int64_t last_idx  = main_thread->last_idx_fifo;
+    for (i = first_idx; i <= last_idx; ++i) {
+        struct EntryJob *job = &main_thread->entry_jobs_fifo[i % size_fifo];
+        if (job->slice_sync->owner->pic == pic) {
+            move_job_to_head(main_thread, first_idx, i);
+            *entry_job = main_thread->entry_jobs_fifo[first_idx % size_fifo];
+            main_thread->first_idx_fifo ++;
+            found = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&main_thread->main_mtx);
+
+    return found;
+}
+
+/* Called by an entry thread waiting for CTUs of a reference picture
+ * Instead of sleeping, the thread decodes a pending entry of the
+ * reference picture with a spare CTU decoder, since the state of its
+ * own CTU decoder is kept by the suspended entry.
+ * Only entries of the reference picture are picked since they cannot
+ * depend on the suspended entry. Entries decoded this way are not
+ * suspended themselves so nesting is limited to one level.
+ * Return 1 if an entry was decoded.
+ */
+int
+ovthread_decode_ref_entry(const OVPicture *const ref_pic)
+{
+    struct EntryThread *entry_th = current_entry_th;
+    struct EntryJob entry_job;
+    uint8_t is_last;
+
+    if (!entry_th || entry_th->nested) {
+        return 0;
+    }
+
+    if (!entry_th->spare_ctudec) {
+        if (ctudec_init(&entry_th->spare_ctudec) < 0) {
+            return 0;
+        }
+    }
+
+    if (!select_pic_job(entry_th->main_thread, ref_pic, &entry_job)) {
+        return 0;
+    }
+
+    entry_th->nested = 1;
+
+    slicedec_update_entry_decoder(entry_job.slice_sync->owner, entry_th->spare_ctudec);
+
+    is_last = ovthread_decode_entry(&entry_job, entry_th->spare_ctudec);
+
+    if (is_last) {
+        slicedec_finish_decoding(entry_job.slice_sync->owner);
+    }
+
+    entry_th->nested = 0;
+
+    return 1;
+}
+
+
+/* Notify threads waiting for output pictures and write to the
+ * event pipe if any.
+ * Must be called with main_mtx locked.
+ */
+void
+ovthread_notify_output(struct MainThread *main_thread)
+{
+    main_thread->nb_output_events++;
+
+    pthread_cond_broadcast(&main_thread->main_cnd);
+
+#if !_WIN32
+    if (main_thread->event_fd[1] >= 0) {
+        /* Pipe is non blocking and might already be full */
+        const uint8_t byte = 0;
+        ssize_t ret = write(main_thread->event_fd[1], &byte, 1);
+        (void)ret;
+    }
+#endif
+}
+
+/* Enlarge the job FIFO so it can hold nb_new_jobs more jobs
+ * Must be called with main_mtx locked.
+ */
+static int
+grow_entry_jobs_fifo(struct MainThread *main_thread, int nb_new_jobs)
+{
+    struct EntryJob *old_fifo = main_thread->entry_jobs_fifo;
+    int64_t first_idx = main_thread->first_idx_fifo;
+    int64_t last_idx  = main_thread->last_idx_fifo;
+    int64_t nb_jobs = last_idx - first_idx + 1 + nb_new_jobs;
+    int old_size = main_thread->size_fifo;
+    int new_size = old_size;
+    struct EntryJob *new_fifo;
+    int64_t i;
+
+    if (nb_jobs <= old_size) {
+        return 0;
+    }
+
+    while (new_size < nb_jobs) {
+        new_size <<= 1;
+    }
+
+    new_fifo = ov_mallocz(new_size * sizeof(struct EntryJob));
+    if (!new_fifo) {
+        return OVVC_ENOMEM;
+    }
+
+    /* Keep FIFO indices valid for pending jobs */
+    for (i = first_idx; i <= last_idx; ++i) {
+        new_fifo[i % new_size] = old_fifo[i % old_size];
+    }
+
+    ov_free(old_fifo);
+
+    main_thread->entry_jobs_fifo = new_fifo;
+    main_thread->size_fifo = new_size;
+
+    return 0;
+}
 
 /*
 Functions needed for the synchro of threads decoding the slice
@@ -185,18 +496,31 @@ ovthread_slice_add_entry_jobs(struct SliceSynchro *slice_sync, DecodeFunc decode
     atomic_store_explicit(&slice_sync->nb_entries_decoded, 0, memory_order_relaxed);
 
     struct MainThread* main_thread = slice_sync->main_thread;
-    int size_fifo = main_thread->size_fifo; 
-    struct EntryJob *entry_jobs_fifo = main_thread->entry_jobs_fifo;
+    int size_fifo;
+    struct EntryJob *entry_jobs_fifo;
+    int nb_tile_cols;
+    int ret;
 
     /* Add entry jobs to the job FIFO of the main thread. 
      */
     pthread_mutex_lock(&main_thread->main_mtx);
+    ret = grow_entry_jobs_fifo(main_thread, nb_entries);
+    if (ret < 0) {
+        pthread_mutex_unlock(&main_thread->main_mtx);
+        ov_log(NULL, OVLOG_ERROR, "Failed to allocate entry jobs\n");
+        return ret;
+    }
+
+    size_fifo = main_thread->size_fifo;
+    entry_jobs_fifo = main_thread->entry_jobs_fifo;
+    nb_tile_cols = slice_sync->owner->active_params->pps_info.tile_info.nb_tile_cols;
     for (int i = 1; i <= nb_entries; ++i) {
         main_thread->last_idx_fifo++;
         int idx = main_thread->last_idx_fifo % size_fifo;
         struct EntryJob *entry_job = &entry_jobs_fifo[idx];
         entry_job->entry_idx = i-1;
         entry_job->slice_sync = slice_sync;
+        entry_job->nb_tile_cols = nb_tile_cols;
         ov_log(NULL, OVLOG_DEBUG, "Main adds POC %d entry %d\n", slice_sync->owner->pic->poc, i-1);
     }
     pthread_mutex_unlock(&main_thread->main_mtx);
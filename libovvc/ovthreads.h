@@ -58,19 +58,51 @@ struct EntryThread
      */
     OVCTUDec *ctudec;
 
+    /* CPU the thread is pinned on (-1 if not pinned)
+     * and index of its NUMA node in decoder placement
+     */
+    int cpu;
+    uint8_t node_idx;
+
+    /* Last entry decoded by the thread used to
+     * select a neighbouring tile as next job
+     */
+    struct SliceSynchro *last_slice_sync;
+    int last_entry_idx;
+    int last_nb_tile_cols;
+
+    /* CTU decoder used to decode entries of reference
+     * pictures while an entry is waiting for them
+     */
+    OVCTUDec *spare_ctudec;
+    uint8_t nested;
+
+    /* Time spent decoding not yet reported to main thread */
+    uint64_t busy_time_us;
+
     uint8_t state;
     uint8_t kill;
+    uint8_t init_done;
 };
 
 struct EntryJob{
     struct SliceSynchro *slice_sync;
-    uint8_t entry_idx;
+    uint16_t entry_idx;
+
+    /* Number of tile columns of the slice picture
+     * snapshotted when the job is queued
+     */
+    uint16_t nb_tile_cols;
 };
 
 int ovthread_init_entry_thread(struct EntryThread *entry_th);
 
 void ovthread_uninit_entry_thread(struct EntryThread *entry_th);
 
+void ovthread_notify_output(struct MainThread *main_thread);
+
+int ovthread_decode_ref_entry(const OVPicture *const ref_pic);
+
 int ovthread_slice_add_entry_jobs(struct SliceSynchro *slice_sync, DecodeFunc decode_entry, int nb_entries);
 
 int ovthread_slice_sync_init(struct SliceSynchro *slice_sync);
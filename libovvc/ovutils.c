@@ -31,7 +31,13 @@
  * 
  **/
 
+#if __linux__
+#define _GNU_SOURCE
+#include <sched.h>
+#endif
+
 #include <stdint.h>
+#include <time.h>
 
 #include "ovutils.h"
 #include "ovconfig.h"
@@ -41,6 +47,10 @@
 #include <unistd.h>
 #endif
 
+#if HAVE_LIBNUMA
+#include <numa.h>
+#endif
+
 /* FIXME check if used on negative numbers */
 
 int
@@ -53,3 +63,71 @@ get_number_of_cores() {
     return sysconf(_SC_NPROCESSORS_ONLN);
 #endif
 }
+
+int
+get_numa_node_of_cpu(int cpu)
+{
+#if HAVE_LIBNUMA
+    if (numa_available() >= 0) {
+        int node = numa_node_of_cpu(cpu);
+        return node < 0 ? 0 : node;
+    }
+#endif
+    return 0;
+}
+
+/* Fill cpu_list with the CPUs the process is allowed to run on.
+ * CPUs are grouped by NUMA node so that consecutive entries of
+ * the list are located on the same socket.
+ */
+int
+get_cpu_affinity_list(int *cpu_list, int max_nb_cpus)
+{
+    int nb_cpus = 0;
+#if __linux__
+    cpu_set_t cpu_set;
+    int max_node = 0;
+    int node;
+
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set)) {
+        return 0;
+    }
+
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &cpu_set)) {
+            max_node = OVMAX(max_node, get_numa_node_of_cpu(cpu));
+        }
+    }
+
+    for (node = 0; node <= max_node; ++node) {
+        for (int cpu = 0; cpu < CPU_SETSIZE && nb_cpus < max_nb_cpus; ++cpu) {
+            if (CPU_ISSET(cpu, &cpu_set) && get_numa_node_of_cpu(cpu) == node) {
+                cpu_list[nb_cpus++] = cpu;
+            }
+        }
+    }
+#else
+    nb_cpus = OVMIN(get_number_of_cores(), max_nb_cpus);
+    for (int cpu = 0; cpu < nb_cpus; ++cpu) {
+        cpu_list[cpu] = cpu;
+    }
+#endif
+    return nb_cpus;
+}
+
+/* Monotonic time in microseconds */
+uint64_t
+get_time_us()
+{
+#if _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (uint64_t)(count.QuadPart * 1000000.0 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
@@ -50,6 +50,10 @@
 #define ov_clz64(x) __builtin_clzl(x)
 #define ov_ctz64(x) __builtin_ctzl(x)
 
+#define ov_popcount64(x) __builtin_popcountll(x)
+
+#define ov_prefetch(p) __builtin_prefetch(p)
+
 #define ov_ceil_log2(x) 32 - __builtin_clz((x - !!x) + !(x - !!x))
 
 /* FIXME
@@ -108,4 +112,10 @@ floor_log2(unsigned x)
 
 int get_number_of_cores();
 
+int get_numa_node_of_cpu(int cpu);
+
+int get_cpu_affinity_list(int *cpu_list, int max_nb_cpus);
+
+uint64_t get_time_us();
+
 #endif
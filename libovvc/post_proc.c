@@ -116,7 +116,7 @@ pp_process_frame(const OVSEI* sei, OVFrame **frame_p)
         if (sei->upscale_flag){
             frame_post_proc->width = max_width[0];
             frame_post_proc->height = max_height[0];
-            for(int comp = 0; comp < 3; comp++){
+            for(int comp = 0; comp < 3 && frame->data[comp]; comp++){
                 pp_sample_rate_conv((uint16_t*)frame_post_proc->data[comp], frame_post_proc->linesize[comp]>>1, 
                                     max_width[comp], max_height[comp], 
                                     (uint16_t*)frame->data[comp], frame->linesize[comp]>>1, 
@@ -878,6 +878,11 @@ void fg_grain_apply_pic(int16_t** dstComp, int16_t** srcComp, struct OVSEIFGrain
     {
         for (compCtr = 0; compCtr < 3; compCtr++)
         {
+            /* Luma only frames */
+            if (!srcComp[compCtr]) {
+                continue;
+            }
+
             if (1 == fgrain->fg_comp_model_present_flag[compCtr])
             {
                 picOffset = poc + (picOrderCntOffset << 5);
@@ -144,6 +144,41 @@ rcn_init_intra_angular_functions(struct RCNFunctions *rcn_func, uint8_t bitdepth
     }
 }
 
+static void
+rcn_ilf_line_skip(OVCTUDec *const ctudec, const struct RectEntryInfo *const einfo, uint16_t ctb_y)
+{
+}
+
+void
+rcn_skip_in_loop_filters(struct RCNFunctions *rcn_func)
+{
+    rcn_func->sao.rcn_sao_first_pix_rows = &rcn_ilf_line_skip;
+    rcn_func->sao.rcn_sao_filter_line    = &rcn_ilf_line_skip;
+    rcn_func->alf.rcn_alf_filter_line    = &rcn_ilf_line_skip;
+}
+
+static void
+rcn_intra_pred_c_skip(const struct OVRCNCtx *const rcn_ctx, uint8_t intra_mode, int x0, int y0,
+                      int log2_pb_w, int log2_pb_h, CUFlags cu_flags)
+{
+}
+
+static void
+rcn_ibc_c_skip(OVCTUDec *const ctu_dec, int16_t x0, int16_t y0,
+               uint8_t log2_cu_w, uint8_t log2_cu_h, uint8_t log2_ctu_s, IBCMV mv)
+{
+}
+
+/* Chroma prediction functions those are not already guarded by
+ * OVRCNCtx luma_only flag
+ */
+void
+rcn_init_luma_only_functions(struct RCNFunctions *rcn_func)
+{
+    rcn_func->intra_pred_c = &rcn_intra_pred_c_skip;
+    rcn_func->rcn_ibc_c    = &rcn_ibc_c_skip;
+}
+
 void
 rcn_init_functions(struct RCNFunctions *rcn_func, uint8_t ict_type, uint8_t lm_chroma_enabled,
                    uint8_t sps_chroma_vertical_collocated_flag, uint8_t lmcs_flag, uint8_t bitdepth)
@@ -237,6 +272,11 @@ rcn_init_functions(struct RCNFunctions *rcn_func, uint8_t ict_type, uint8_t lm_c
             }
           }
       }
+
+      /* DMVR SADs are computed on 10 bits bilinear predictions */
+      if (__builtin_cpu_supports("sse4.1") && bitdepth == 8) {
+          rcn_init_dmvr_functions_sse(rcn_func);
+      }
       #endif
       #if HAVE_AVX2
         if (__builtin_cpu_supports("avx2") && bitdepth == 10) {
@@ -250,6 +290,23 @@ rcn_init_functions(struct RCNFunctions *rcn_func, uint8_t ict_type, uint8_t lm_c
           rcn_init_prof_functions_avx2(rcn_func);
           rcn_init_bdof_functions_avx2(rcn_func);
           rcn_init_intra_angular_functions_10_avx2(rcn_func);
+          rcn_init_tr_functions_avx2(rcn_func);
+          rcn_init_df_functions_avx2(rcn_func);
+          rcn_init_dc_planar_functions_avx2(rcn_func);
+          rcn_init_lfnst_functions_avx2(rcn_func);
+          rcn_init_dequant_avx2(rcn_func);
+
+          if (lm_chroma_enabled) {
+            if (!sps_chroma_vertical_collocated_flag /*sps->sps_chroma_horizontal_collocated_flag*/) {
+              rcn_init_cclm_functions_avx2(rcn_func);
+            }
+          }
+        }
+
+        if (__builtin_cpu_supports("avx2") && bitdepth == 8) {
+          rcn_init_dmvr_functions_avx2(rcn_func);
+          rcn_init_prof_functions_avx2(rcn_func);
+          rcn_init_bdof_functions_8_avx2(rcn_func);
         }
       #endif
     #elif __ARM_ARCH
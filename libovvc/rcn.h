@@ -43,6 +43,10 @@ void rcn_init_gpm_params();
 void rcn_init_functions(struct RCNFunctions *rcn_func, uint8_t ict_type, uint8_t lm_chroma_enabled,
                         uint8_t sps_chroma_vertical_collocated_flag, uint8_t lmcs_flag, uint8_t bitdepth);
 
+void rcn_skip_in_loop_filters(struct RCNFunctions *rcn_func);
+
+void rcn_init_luma_only_functions(struct RCNFunctions *rcn_func);
+
 void rcn_init_tr_functions(struct RCNFunctions *const rcn_funcs);
 
 void rcn_init_ctu_buffs_10(struct RCNFunctions *rcn_func);
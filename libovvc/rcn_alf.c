@@ -1287,7 +1287,8 @@ rcn_alf_filter_line(OVCTUDec *const ctudec, const struct RectEntryInfo *const ei
 {
     struct ALFInfo* alf_info = &ctudec->alf_info;
     struct OVRCNCtx *const rcn_ctx = &ctudec->rcn_ctx;
-    if (!alf_info->alf_luma_enabled_flag && !alf_info->alf_cb_enabled_flag && !alf_info->alf_cr_enabled_flag) {
+    uint8_t chroma_flag = !rcn_ctx->luma_only && (alf_info->alf_cb_enabled_flag || alf_info->alf_cr_enabled_flag);
+    if (!alf_info->alf_luma_enabled_flag && !chroma_flag) {
         return;
     }
 
@@ -1299,6 +1300,7 @@ rcn_alf_filter_line(OVCTUDec *const ctudec, const struct RectEntryInfo *const ei
     const OVPartInfo *const pinfo = ctudec->part_ctx;
     uint8_t log2_ctb_s = pinfo->log2_ctu_s;
     int ctu_s  = 1 << log2_ctb_s;
+    uint8_t nb_comp = rcn_ctx->luma_only ? 1 : 3;
 
     RCNALF* alf = &alf_info->rcn_alf;
     for (int ctb_x = 0; ctb_x < einfo->nb_ctu_w; ctb_x++) {
@@ -1361,7 +1363,7 @@ rcn_alf_filter_line(OVCTUDec *const ctudec, const struct RectEntryInfo *const ei
                                                          ctu_s, virbnd_pos);
         }
 
-        for (uint8_t c_idx = 1; c_idx < 3; c_idx++) {
+        for (uint8_t c_idx = 1; c_idx < nb_comp; c_idx++) {
             const int chr_scale = frame->linesize[0] / frame->linesize[c_idx];
 
             if ((c_idx==1 && (alf_params_ctu->ctb_alf_flag & 2)) || (c_idx==2 && (alf_params_ctu->ctb_alf_flag & 1))) {
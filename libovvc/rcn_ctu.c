@@ -103,6 +103,10 @@ rcn_write_ctu_to_frame(const struct OVRCNCtx *const rcn_ctx, uint8_t log2_ctb_s)
         dst_y += fd->stride;
     }
 
+    if (rcn_ctx->luma_only) {
+        return;
+    }
+
     for (i = 0; i < 1 << (log2_ctb_s - 1); ++i) {
         memcpy(dst_cb, src_cb, sizeof(OVSample) << (log2_ctb_s - 1));
         memcpy(dst_cr, src_cr, sizeof(OVSample) << (log2_ctb_s - 1));
@@ -172,6 +176,10 @@ rcn_write_ctu_to_frame_border(const struct OVRCNCtx *const rcn_ctx,
         src_y += ctu_buff->stride;
     }
 
+    if (rcn_ctx->luma_only) {
+        return;
+    }
+
     for (int i = 0; i < (last_ctu_h >> 1); i++) {
         memcpy(dst_cb, src_cb,  sizeof(*src_cb) * (last_ctu_w >> 1));
         memcpy(dst_cr, src_cr,  sizeof(*src_cr) * (last_ctu_w >> 1));
@@ -187,8 +195,10 @@ rcn_update_frame_buff(struct OVRCNCtx *const rcn_ctx, uint8_t log2_ctb_s)
 {
      struct OVBuffInfo *finfo = &rcn_ctx->frame_buff;
      finfo->y += 1 << log2_ctb_s;
-     finfo->cb += 1 << log2_ctb_s >> 1;
-     finfo->cr += 1 << log2_ctb_s >> 1;
+     if (!rcn_ctx->luma_only) {
+         finfo->cb += 1 << log2_ctb_s >> 1;
+         finfo->cr += 1 << log2_ctb_s >> 1;
+     }
 }
 
 static void
@@ -253,8 +263,9 @@ rcn_save_last_cols(struct OVRCNCtx *const rcn_ctx, int x_pic_l, int y_pic_l, uin
     const int width_l = ( x_pic_l + fb->filter_region_w[0] > rcn_ctx->frame_start->width ) ? ( rcn_ctx->frame_start->width - x_pic_l ) : fb->filter_region_w[0];
     const int height_l = ( y_pic_l + fb->filter_region_h[0] > rcn_ctx->frame_start->height ) ? ( rcn_ctx->frame_start->height - y_pic_l ) : fb->filter_region_h[0];
     const int margin = fb->margin;
+    const int nb_comp = rcn_ctx->luma_only ? 1 : 3;
 
-    for(int comp = 0; comp < 3; comp++) {
+    for(int comp = 0; comp < nb_comp; comp++) {
         OVSample* saved_cols = fb->saved_cols[comp];
         OVSample* filter_region = fb->filter_region[comp];
         int stride_filter = fb->filter_region_stride[comp];
@@ -279,8 +290,9 @@ rcn_save_last_rows(struct OVRCNCtx *const rcn_ctx, OVSample** saved_rows, int x_
     const int width_l = ( x_pic_l + fb->filter_region_w[0] > rcn_ctx->frame_start->width ) ? ( rcn_ctx->frame_start->width - x_pic_l ) : fb->filter_region_w[0];
     const int height_l = ( y_pic_l + fb->filter_region_h[0] > rcn_ctx->frame_start->height ) ? ( rcn_ctx->frame_start->height - y_pic_l ) : fb->filter_region_h[0];
     const int margin = fb->margin;
+    const int nb_comp = rcn_ctx->luma_only ? 1 : 3;
 
-    for(int comp = 0; comp < 3; comp++) {
+    for(int comp = 0; comp < nb_comp; comp++) {
         OVSample* saved_rows_comp = saved_rows[comp];
         OVSample* filter_region = fb->filter_region[comp];
         int stride_filter = fb->filter_region_stride[comp];
@@ -324,8 +336,9 @@ rcn_extend_filter_region(struct OVRCNCtx *const rcn_ctx, OVSample** saved_rows,
     const int height_l = (y_pic_l + fb->filter_region_h[0] > rcn_ctx->frame_start->height) ? (rcn_ctx->frame_start->height - y_pic_l)
                                                                             : fb->filter_region_h[0];
     const int margin = fb->margin;
+    const int nb_comp = rcn_ctx->luma_only ? 1 : 3;
 
-    for (int comp = 0; comp < 3; comp++) {
+    for (int comp = 0; comp < nb_comp; comp++) {
         int ratio_luma_chroma = 2;
         int ratio = comp==0 ? 1 : ratio_luma_chroma;
 
@@ -530,12 +543,16 @@ rcn_alloc_filter_buffers(struct OVRCNCtx *const rcn_ctx, int nb_ctu_w, int margi
         fb->filter_region_stride[comp]   = ctu_s / ratio + 2 * margin ;
         fb->filter_region_offset[comp]   = margin * fb->filter_region_stride[comp] + margin;
 
-        if (!filter_region[comp]) {
-            int ext_size = fb->filter_region_stride[comp] * (fb->filter_region_h[comp] + 2 * margin + 1);
-            filter_region[comp] = ov_malloc(ext_size * sizeof(OVSample));
-            saved_cols[comp]    = ov_malloc(fb->filter_region_h[comp] * margin * sizeof(OVSample));
+        /* CTU size might have changed since previous allocation */
+        if (filter_region[comp]) {
+            ov_freep(&filter_region[comp]);
+            ov_freep(&saved_cols[comp]);
         }
 
+        int ext_size = fb->filter_region_stride[comp] * (fb->filter_region_h[comp] + 2 * margin + 1);
+        filter_region[comp] = ov_malloc(ext_size * sizeof(OVSample));
+        saved_cols[comp]    = ov_malloc(fb->filter_region_h[comp] * margin * sizeof(OVSample));
+
         fb->saved_rows_stride[comp] = nb_ctu_w * ctu_s / ratio; ;
         if (saved_rows_sao[comp]) {
             ov_freep(&saved_rows_sao[comp]);
@@ -584,11 +601,17 @@ rcn_attach_frame_buff(struct OVRCNCtx *const rcn_ctx, const OVFrame *const f,
 
     /*FIXME clean offset */
     fbuff->y  = (OVSample *)f->data[0] + entry_start_offset;
-    fbuff->cb = (OVSample *)f->data[1] + entry_start_offset_c;
-    fbuff->cr = (OVSample *)f->data[2] + entry_start_offset_c;
-
     fbuff->stride   = f->linesize[0]/sizeof(OVSample);
-    fbuff->stride_c = f->linesize[1]/sizeof(OVSample);
+
+    if (rcn_ctx->luma_only) {
+        fbuff->cb = NULL;
+        fbuff->cr = NULL;
+        fbuff->stride_c = 0;
+    } else {
+        fbuff->cb = (OVSample *)f->data[1] + entry_start_offset_c;
+        fbuff->cr = (OVSample *)f->data[2] + entry_start_offset_c;
+        fbuff->stride_c = f->linesize[1]/sizeof(OVSample);
+    }
 
     rcn_ctx->line_start = *fbuff;
 }
@@ -599,8 +622,10 @@ rcn_next_buff_line(struct OVRCNCtx *const rcn_ctx,  uint8_t log2_ctb_s)
     struct OVBuffInfo *fbuff = &rcn_ctx->line_start;
 
     fbuff->y  += fbuff->stride << log2_ctb_s;
-    fbuff->cb += fbuff->stride_c << (log2_ctb_s - 1);
-    fbuff->cr += fbuff->stride_c << (log2_ctb_s - 1);
+    if (!rcn_ctx->luma_only) {
+        fbuff->cb += fbuff->stride_c << (log2_ctb_s - 1);
+        fbuff->cr += fbuff->stride_c << (log2_ctb_s - 1);
+    }
 
     rcn_ctx->frame_buff = *fbuff;
 }
@@ -1523,6 +1523,9 @@ mv_threshold_check(OVMV a, OVMV b)
 
 #define PB_POS_IN_BUF(x,y) (35 + (x) + ((y) * 34))
 
+/* Minimum number of units to check on an edge before using DFFunctions MV check */
+#define DBF_MV_CHECK_MIN_UNITS 8
+
 static uint64_t
 check_dbf_enabled_p(const int16_t *dist_ref_p, const int16_t *dist_ref_q, OVMV mv_p0, OVMV mv_q0)
 {
@@ -1539,12 +1542,9 @@ check_dbf_enabled_p(const int16_t *dist_ref_p, const int16_t *dist_ref_q, OVMV m
 }
 
 static uint64_t
-check_dbf_enabled(const struct InterDRVCtx *const inter_ctx,
+check_dbf_enabled(const int16_t *dist_0, const int16_t *dist_1,
                   OVMV mv_p0, OVMV mv_p1, OVMV mv_q0, OVMV mv_q1)
 {
-    const int16_t *dist_0 = inter_ctx->dist_ref_0;
-    const int16_t *dist_1 = inter_ctx->dist_ref_1;
-
     int16_t ref0_p = dist_0[mv_p0.ref_idx];
     int16_t ref1_p = dist_1[mv_p1.ref_idx];
 
@@ -1575,8 +1575,90 @@ check_dbf_enabled(const struct InterDRVCtx *const inter_ctx,
     return (uint64_t)bs;
 }
 
+/* Derive MV based BS for the units of an edge flagged in chk_b (both P and Q
+ * bi-predicted) or in chk_p0 / chk_p1 (Q using only L0 / L1).
+ * MVs of consecutive units along the edge are mv_stride apart.
+ */
 static uint64_t
-dbf_mv_set_hedges(const struct InterDRVCtx *const inter_ctx,
+dbf_mv_check(const OVMV *mv0_p, const OVMV *mv1_p, const OVMV *mv0_q, const OVMV *mv1_q,
+             ptrdiff_t mv_stride, const int16_t *dist_ref0, const int16_t *dist_ref1,
+             uint64_t chk_b, uint64_t chk_p0, uint64_t chk_p1, uint64_t mv_p_p0)
+{
+    uint64_t dst_map = 0;
+
+    if (chk_b) {
+        const OVMV *mv0_p_b = mv0_p;
+        const OVMV *mv1_p_b = mv1_p;
+        const OVMV *mv0_q_b = mv0_q;
+        const OVMV *mv1_q_b = mv1_q;
+
+        uint8_t pos_shift = 0;
+        do {
+            uint8_t nb_skipped_blk = ov_ctz64(chk_b);
+            mv0_p_b += mv_stride * nb_skipped_blk;
+            mv1_p_b += mv_stride * nb_skipped_blk;
+            mv0_q_b += mv_stride * nb_skipped_blk;
+            mv1_q_b += mv_stride * nb_skipped_blk;
+            pos_shift += nb_skipped_blk;
+
+            uint64_t bs = check_dbf_enabled(dist_ref0, dist_ref1, *mv0_p_b, *mv1_p_b, *mv0_q_b, *mv1_q_b);
+
+            dst_map |= bs << pos_shift;
+
+            mv0_p_b += mv_stride;
+            mv1_p_b += mv_stride;
+            mv0_q_b += mv_stride;
+            mv1_q_b += mv_stride;
+            pos_shift++;
+
+            chk_b >>= nb_skipped_blk + 1;
+
+        } while (chk_b);
+    }
+
+    if (chk_p0 | chk_p1) {
+        uint8_t pos_shift = 0;
+        do {
+            uint8_t nb_skipped_blk = ov_ctz64(chk_p0 | chk_p1);
+            mv0_p += mv_stride * nb_skipped_blk;
+            mv1_p += mv_stride * nb_skipped_blk;
+            mv0_q += mv_stride * nb_skipped_blk;
+            mv1_q += mv_stride * nb_skipped_blk;
+
+            chk_p0 >>= nb_skipped_blk;
+            chk_p1 >>= nb_skipped_blk;
+            mv_p_p0 >>= nb_skipped_blk;
+
+            pos_shift += nb_skipped_blk;
+            uint8_t is_l0_p = mv_p_p0 & 0x1;
+            uint8_t is_l0_q =  chk_p0 & 0x1;
+            const int16_t *dist_p = is_l0_p ? dist_ref0 : dist_ref1;
+            const int16_t *dist_q = is_l0_q ? dist_ref0 : dist_ref1;
+            OVMV mv_p = is_l0_p ? *mv0_p : *mv1_p;
+            OVMV mv_q = is_l0_q ? *mv0_q : *mv1_q;
+
+            uint64_t bs = check_dbf_enabled_p(dist_p, dist_q, mv_p, mv_q);
+
+            dst_map |= bs << pos_shift;
+
+            mv0_p += mv_stride;
+            mv1_p += mv_stride;
+            mv0_q += mv_stride;
+            mv1_q += mv_stride;
+            pos_shift++;
+
+            chk_p0 >>= 1;
+            chk_p1 >>= 1;
+            mv_p_p0 >>= 1;
+
+        } while (chk_p0 | chk_p1);
+    }
+
+    return dst_map;
+}
+
+static uint64_t
+dbf_mv_set_hedges(const struct DFFunctions *df, const struct InterDRVCtx *const inter_ctx,
                   const struct IBCMVCtx *const ibc_ctx,
                   int x0_unit, int y0_unit,
                   int nb_unit_w, int nb_unit_h, uint64_t msk)
@@ -1620,84 +1702,25 @@ dbf_mv_set_hedges(const struct InterDRVCtx *const inter_ctx,
 
     uint64_t dst_map_h = (ibc_p_msk & ibc_q_msk) ^ (~(chk_p0 | chk_p1 | chk_b)) & unit_msk_h;
 
-    if (chk_b) {
-        const OVMV *mv0_p = &mv_ctx0->mvs[PB_POS_IN_BUF(x0_unit, y0_unit - 1)];
-        const OVMV *mv1_p = &mv_ctx1->mvs[PB_POS_IN_BUF(x0_unit, y0_unit - 1)];
-        const OVMV *mv0_q = &mv_ctx0->mvs[PB_POS_IN_BUF(x0_unit, y0_unit)];
-        const OVMV *mv1_q = &mv_ctx1->mvs[PB_POS_IN_BUF(x0_unit, y0_unit)];
-
-        uint8_t pos_shift = 0;
-        do {
-            uint8_t nb_skipped_blk = ov_ctz64(chk_b);
-            mv0_p += nb_skipped_blk;
-            mv1_p += nb_skipped_blk;
-            mv0_q += nb_skipped_blk;
-            mv1_q += nb_skipped_blk;
-            pos_shift += nb_skipped_blk;
-
-            uint64_t abv_th = check_dbf_enabled(inter_ctx, *mv0_p, *mv1_p, *mv0_q, *mv1_q);
-
-            dst_map_h |= abv_th << pos_shift;
-
-            mv0_p++;
-            mv1_p++;
-            mv0_q++;
-            mv1_q++;
-            pos_shift++;
-
-            chk_b >>= nb_skipped_blk + 1;
-
-        } while (chk_b);
-    }
-
-    if (chk_p0 | chk_p1) {
+    if (chk_b | chk_p0 | chk_p1) {
         const OVMV *mv0_p = &mv_ctx0->mvs[PB_POS_IN_BUF(x0_unit, y0_unit - 1)];
         const OVMV *mv1_p = &mv_ctx1->mvs[PB_POS_IN_BUF(x0_unit, y0_unit - 1)];
         const OVMV *mv0_q = &mv_ctx0->mvs[PB_POS_IN_BUF(x0_unit, y0_unit)];
         const OVMV *mv1_q = &mv_ctx1->mvs[PB_POS_IN_BUF(x0_unit, y0_unit)];
 
-        uint8_t pos_shift = 0;
-        do {
-            uint8_t nb_skipped_blk = ov_ctz64(chk_p0 | chk_p1);
-            mv0_p += nb_skipped_blk;
-            mv1_p += nb_skipped_blk;
-            mv0_q += nb_skipped_blk;
-            mv1_q += nb_skipped_blk;
-
-            chk_p0 >>= nb_skipped_blk;
-            chk_p1 >>= nb_skipped_blk;
-            mv_p_p0 >>= nb_skipped_blk;
-
-            pos_shift += nb_skipped_blk;
-            uint8_t is_l0_p = mv_p_p0 & 0x1;
-            uint8_t is_l0_q =  chk_p0 & 0x1;
-            const int16_t *dist_p = is_l0_p ? dist_ref0 : dist_ref1;
-            const int16_t *dist_q = is_l0_q ? dist_ref0 : dist_ref1;
-            OVMV mv_p = is_l0_p ? *mv0_p : *mv1_p;
-            OVMV mv_q = is_l0_q ? *mv0_q : *mv1_q;
+        /* Checking units one by one is cheaper on sparse edges */
+        DBFMVCheckFunc mv_check = ov_popcount64(chk_b | chk_p0 | chk_p1) < DBF_MV_CHECK_MIN_UNITS
+                                  ? &dbf_mv_check : df->dbf_mv_check;
 
-            uint64_t abv_th = check_dbf_enabled_p(dist_p, dist_q, mv_p, mv_q);
-
-            dst_map_h |= abv_th << pos_shift;
-
-            mv0_p++;
-            mv1_p++;
-            mv0_q++;
-            mv1_q++;
-            pos_shift++;
-
-            chk_p0 >>= 1;
-            chk_p1 >>= 1;
-            mv_p_p0 >>= 1;
-
-        } while (chk_p0 | chk_p1);
+        dst_map_h |= mv_check(mv0_p, mv1_p, mv0_q, mv1_q, 1, dist_ref0, dist_ref1,
+                               chk_b, chk_p0, chk_p1, mv_p_p0);
     }
 
     return ((dst_map_h | bs1_map_h) << (x0_unit + 2) & msk);
 }
 
 static uint64_t
-dbf_mv_set_vedges(const struct InterDRVCtx *const inter_ctx,
+dbf_mv_set_vedges(const struct DFFunctions *df, const struct InterDRVCtx *const inter_ctx,
                   const struct IBCMVCtx *const ibc_ctx,
                   int x0_unit, int y0_unit,
                   int nb_unit_w, int nb_unit_h, uint64_t msk)
@@ -1742,84 +1765,25 @@ dbf_mv_set_vedges(const struct InterDRVCtx *const inter_ctx,
 
     uint64_t dst_map_v = (ibc_p_msk & ibc_q_msk) ^ (~(chk_p0 | chk_p1 | chk_b)) & unit_msk_v;
 
-    if (chk_b) {
+    if (chk_b | chk_p0 | chk_p1) {
         const OVMV *mv0_p = &mv_ctx0->mvs[PB_POS_IN_BUF(x0_unit - 1, y0_unit)];
         const OVMV *mv1_p = &mv_ctx1->mvs[PB_POS_IN_BUF(x0_unit - 1, y0_unit)];
         const OVMV *mv0_q = &mv_ctx0->mvs[PB_POS_IN_BUF(x0_unit, y0_unit)];
         const OVMV *mv1_q = &mv_ctx1->mvs[PB_POS_IN_BUF(x0_unit, y0_unit)];
 
-        uint8_t pos_shift = 0;
-        do {
-            uint8_t nb_skipped_blk = ov_ctz64(chk_b);
-            mv0_p += 34 * nb_skipped_blk;
-            mv1_p += 34 * nb_skipped_blk;
-            mv0_q += 34 * nb_skipped_blk;
-            mv1_q += 34 * nb_skipped_blk;
-            pos_shift += nb_skipped_blk;
-
-            uint64_t lft_th = check_dbf_enabled(inter_ctx, *mv0_p, *mv1_p, *mv0_q, *mv1_q);
+        /* Checking units one by one is cheaper on sparse edges */
+        DBFMVCheckFunc mv_check = ov_popcount64(chk_b | chk_p0 | chk_p1) < DBF_MV_CHECK_MIN_UNITS
+                                  ? &dbf_mv_check : df->dbf_mv_check;
 
-            dst_map_v |= lft_th << pos_shift;
-
-            mv0_p += 34;
-            mv1_p += 34;
-            mv0_q += 34;
-            mv1_q += 34;
-            pos_shift++;
-
-            chk_b >>= nb_skipped_blk + 1;
-
-        } while (chk_b);
-    }
-
-    if (chk_p0 | chk_p1) {
-        const OVMV *mv0_p = &mv_ctx0->mvs[PB_POS_IN_BUF(x0_unit - 1, y0_unit)];
-        const OVMV *mv1_p = &mv_ctx1->mvs[PB_POS_IN_BUF(x0_unit - 1, y0_unit)];
-        const OVMV *mv0_q = &mv_ctx0->mvs[PB_POS_IN_BUF(x0_unit, y0_unit)];
-        const OVMV *mv1_q = &mv_ctx1->mvs[PB_POS_IN_BUF(x0_unit, y0_unit)];
-
-        uint8_t pos_shift = 0;
-        do {
-            uint8_t nb_skipped_blk = ov_ctz64(chk_p0 | chk_p1);
-            mv0_p += 34 * nb_skipped_blk;
-            mv1_p += 34 * nb_skipped_blk;
-            mv0_q += 34 * nb_skipped_blk;
-            mv1_q += 34 * nb_skipped_blk;
-
-            chk_p0 >>= nb_skipped_blk;
-            chk_p1 >>= nb_skipped_blk;
-            mv_p_p0 >>= nb_skipped_blk;
-
-            pos_shift += nb_skipped_blk;
-            uint8_t is_l0_p = mv_p_p0 & 0x1;
-            uint8_t is_l0_q =  chk_p0 & 0x1;
-            const int16_t *dist_p = is_l0_p ? dist_ref0 : dist_ref1;
-            const int16_t *dist_q = is_l0_q ? dist_ref0 : dist_ref1;
-            OVMV mv_p = is_l0_p ? *mv0_p : *mv1_p;
-            OVMV mv_q = is_l0_q ? *mv0_q : *mv1_q;
-
-            uint64_t lft_th = check_dbf_enabled_p(dist_p, dist_q, mv_p, mv_q);
-
-            dst_map_v |= lft_th << pos_shift;
-
-            mv0_p += 34;
-            mv1_p += 34;
-            mv0_q += 34;
-            mv1_q += 34;
-            pos_shift++;
-
-            chk_p0 >>= 1;
-            chk_p1 >>= 1;
-            mv_p_p0 >>= 1;
-
-        } while (chk_p0 | chk_p1);
+        dst_map_v |= mv_check(mv0_p, mv1_p, mv0_q, mv1_q, 34, dist_ref0, dist_ref1,
+                               chk_b, chk_p0, chk_p1, mv_p_p0);
     }
 
     return ((dst_map_v  | bs1_map_v) << y0_unit) & msk;
 }
 
 static void
-dbf_ctu_preproc_h(const struct InterDRVCtx *const inter_ctx, struct DBFInfo *const dbf_info,
+dbf_ctu_preproc_h(const struct DFFunctions *df, const struct InterDRVCtx *const inter_ctx, struct DBFInfo *const dbf_info,
                   uint8_t nb_unit_h, uint8_t nb_unit_w)
 {
     int i;
@@ -1837,7 +1801,7 @@ dbf_ctu_preproc_h(const struct InterDRVCtx *const inter_ctx, struct DBFInfo *con
 
             if (no_filter) {
                 uint64_t tmp = bs_map;
-                tmp = dbf_mv_set_hedges(inter_ctx, dbf_info->ibc_ctx, 0, i, nb_unit_w, nb_unit_h, no_filter);
+                tmp = dbf_mv_set_hedges(df, inter_ctx, dbf_info->ibc_ctx, 0, i, nb_unit_w, nb_unit_h, no_filter);
                 dbf_info->bs1_map.hor[i] |= tmp;
             }
         }
@@ -1845,7 +1809,7 @@ dbf_ctu_preproc_h(const struct InterDRVCtx *const inter_ctx, struct DBFInfo *con
 }
 
 static void
-dbf_ctu_preproc_v(const struct InterDRVCtx *const inter_ctx, struct DBFInfo *const dbf_info,
+dbf_ctu_preproc_v(const struct DFFunctions *df, const struct InterDRVCtx *const inter_ctx, struct DBFInfo *const dbf_info,
                   uint8_t nb_unit_h, uint8_t nb_unit_w)
 {
     const uint64_t vedge_mask = ((uint64_t)1 << nb_unit_h) - 1;
@@ -1866,7 +1830,7 @@ dbf_ctu_preproc_v(const struct InterDRVCtx *const inter_ctx, struct DBFInfo *con
 
             if (no_filter) {
                 uint64_t tmp = bs_map;
-                tmp = dbf_mv_set_vedges(inter_ctx, dbf_info->ibc_ctx, i, 0, nb_unit_w, nb_unit_h, no_filter);
+                tmp = dbf_mv_set_vedges(df, inter_ctx, dbf_info->ibc_ctx, i, 0, nb_unit_w, nb_unit_h, no_filter);
                 dbf_info->bs1_map.ver[i] |= tmp;
             }
         }
@@ -2012,6 +1976,76 @@ vvc_dbf_ctu_hor(const struct DFFunctions * df, OVSample *src, int stride, const
     }
 }
 
+static void
+vvc_dbf_ctu_hor_x4(const struct DFFunctions * df, OVSample *src, int stride, const struct DBFInfo *const dbf_info,
+                   uint8_t nb_unit_h, int is_last_h, uint8_t nb_unit_w, uint8_t ctu_lft)
+{
+    const int blk_stride = stride << 2;
+    const uint64_t vedge_mask = ((uint64_t)1 << nb_unit_h) - 1;
+
+    const uint64_t *edg_map = &dbf_info->ctb_bound_ver[8];
+    const uint64_t *sb_edg_map = &dbf_info->aff_edg_ver[8];
+    const uint8_t skip_first = !ctu_lft;
+
+    int i;
+
+    src += skip_first << 2;
+
+    for (i = skip_first; i < nb_unit_w; ++i) {
+        uint64_t edg_msk = edg_map[i] | sb_edg_map[i];
+        uint64_t bs1_map  = dbf_info->bs1_map.ver[i];
+        uint64_t bs2_map  = dbf_info->bs2_map.ver[i];
+
+        edg_msk &= vedge_mask;
+        edg_msk &= bs2_map | bs1_map;
+
+        if (edg_msk) {
+            const uint64_t affine_p = dbf_info->affine_map.ver[i    ];
+            const uint64_t affine_q = dbf_info->affine_map.ver[i + 1];
+            const uint8_t *qp_col = &dbf_info->qp_map_y.hor[36 + i];
+            struct EdgeCtx edg_ctx;
+
+            edg_ctx.large_p_map = i % 4 ? 0 : derive_size_3_map(&edg_map[i - 7]);
+            set_edge_context(&edg_ctx, edg_map, sb_edg_map, i);
+
+            /* Process edge segments by groups of four units */
+            do {
+                uint8_t grp_start = ov_ctz64(edg_msk) & ~0x3;
+                uint8_t grp_msk = (edg_msk >> grp_start) & 0xF;
+                struct DFEdgeParams prms = {0};
+                int k;
+
+                for (k = 0; k < 4; ++k) {
+                    if (grp_msk & (1 << k)) {
+                        uint8_t y = grp_start + k;
+                        uint64_t pos_msk = (uint64_t)1 << y;
+                        uint8_t bs = 1 + !!(bs2_map & pos_msk);
+                        uint8_t qp = (qp_col[y * 34 - 1] + qp_col[y * 34] + 1) >> 1;
+
+                        const struct DBFParams dbf_params = compute_dbf_limits(dbf_info, qp, bs);
+                        if (dbf_params.tc || dbf_params.beta) {
+                            struct DBFLength max_lgth_info = derive_filter_length(&edg_ctx, affine_p, affine_q,
+                                                                                  pos_msk);
+                            prms.beta[k]    = dbf_params.beta;
+                            prms.tc[k]      = dbf_params.tc;
+                            prms.max_l_p[k] = max_lgth_info.lgth_p;
+                            prms.max_l_q[k] = max_lgth_info.lgth_q;
+                            prms.seg_msk   |= 1 << k;
+                        }
+                    }
+                }
+
+                if (prms.seg_msk) {
+                    df->filter_edge_h(df, src + grp_start * blk_stride, stride, &prms);
+                }
+
+                edg_msk &= ~((uint64_t)0xF << grp_start);
+            } while (edg_msk);
+        }
+        src += 1 << 2;
+    }
+}
+
 static void
 filter_horizontal_edge(const struct DFFunctions *df, const struct DBFParams *const dbf_params,
                        OVSample *src, ptrdiff_t stride,
@@ -2166,6 +2200,99 @@ vvc_dbf_ctu_ver(const struct DFFunctions *df, OVSample *src, int stride, const s
     }
 }
 
+static void
+vvc_dbf_ctu_ver_x4(const struct DFFunctions *df, OVSample *src, int stride, const struct DBFInfo *const dbf_info,
+                   uint8_t nb_unit_w, int is_last_w, uint8_t nb_unit_h, uint8_t ctu_abv)
+{
+    const int blk_stride = 1 << 2;
+    const uint64_t hedge_mask = ((uint64_t)1 << (nb_unit_w + (!!is_last_w << 1))) - 1;
+    int i;
+
+    const uint64_t *edg_map = &dbf_info->ctb_bound_hor[8];
+    const uint64_t *sb_edg_map = &dbf_info->aff_edg_hor[8];
+    uint8_t skip_first = !ctu_abv;
+
+    /* Same two units shift as in vvc_dbf_ctu_ver() */
+    src -= blk_stride << 1;
+    src += (skip_first * stride) << 2;
+
+    for (i = skip_first; i < nb_unit_h; ++i) {
+        uint64_t edg_msk = edg_map[i] | sb_edg_map[i];
+        uint64_t bs2_map = dbf_info->bs2_map.hor[i];
+        uint64_t bs1_map = dbf_info->bs1_map.hor[i];
+
+        edg_msk &= hedge_mask;
+        edg_msk &= bs2_map | bs1_map;
+
+        if (edg_msk) {
+            const uint64_t affine_p = dbf_info->affine_map.hor[i    ];
+            const uint64_t affine_q = dbf_info->affine_map.hor[i + 1];
+            const uint8_t *qp_row = &dbf_info->qp_map_y.hor[34 * i];
+            struct EdgeCtx edg_ctx;
+
+            edg_ctx.large_p_map = i % 4 || i < 7 ? 0 : derive_size_3_map(&edg_map[i - 7]);
+            set_edge_context(&edg_ctx, edg_map, sb_edg_map, i);
+
+            /* Process edge segments by groups of four units */
+            do {
+                uint8_t grp_start = ov_ctz64(edg_msk) & ~0x3;
+                uint8_t grp_msk = (edg_msk >> grp_start) & 0xF;
+                struct DFEdgeParams prms = {0};
+                int k;
+
+                for (k = 0; k < 4; ++k) {
+                    if (grp_msk & (1 << k)) {
+                        uint8_t x = grp_start + k;
+                        uint64_t pos_msk = (uint64_t)1 << x;
+                        uint8_t bs = 1 + !!(bs2_map & pos_msk);
+                        uint8_t qp = (qp_row[x] + qp_row[x + 34] + 1) >> 1;
+
+                        const struct DBFParams dbf_params = compute_dbf_limits(dbf_info, qp, bs);
+                        if (dbf_params.tc || dbf_params.beta) {
+                            struct DBFLength max_lgth_info = derive_filter_length(&edg_ctx, affine_p, affine_q,
+                                                                                  pos_msk);
+                            prms.beta[k]    = dbf_params.beta;
+                            prms.tc[k]      = dbf_params.tc;
+                            prms.max_l_p[k] = max_lgth_info.lgth_p;
+                            prms.max_l_q[k] = max_lgth_info.lgth_q;
+                            prms.seg_msk   |= 1 << k;
+                        }
+                    }
+                }
+
+                if (prms.seg_msk) {
+                    df->filter_edge_v(df, src + grp_start * blk_stride, stride, &prms);
+                }
+
+                edg_msk &= ~((uint64_t)0xF << grp_start);
+            } while (edg_msk);
+        }
+        src += stride << 2;
+    }
+}
+
+static void
+vvc_dbf_luma_hor(const struct DFFunctions *df, OVSample *src, int stride, const struct DBFInfo *const dbf_info,
+                 uint8_t nb_unit_h, int is_last_h, uint8_t nb_unit_w, uint8_t ctu_lft)
+{
+    if (df->filter_edge_h) {
+        vvc_dbf_ctu_hor_x4(df, src, stride, dbf_info, nb_unit_h, is_last_h, nb_unit_w, ctu_lft);
+    } else {
+        vvc_dbf_ctu_hor(df, src, stride, dbf_info, nb_unit_h, is_last_h, nb_unit_w, ctu_lft);
+    }
+}
+
+static void
+vvc_dbf_luma_ver(const struct DFFunctions *df, OVSample *src, int stride, const struct DBFInfo *const dbf_info,
+                 uint8_t nb_unit_w, int is_last_w, uint8_t nb_unit_h, uint8_t ctu_abv)
+{
+    if (df->filter_edge_v) {
+        vvc_dbf_ctu_ver_x4(df, src, stride, dbf_info, nb_unit_w, is_last_w, nb_unit_h, ctu_abv);
+    } else {
+        vvc_dbf_ctu_ver(df, src, stride, dbf_info, nb_unit_w, is_last_w, nb_unit_h, ctu_abv);
+    }
+}
+
 static void
 rcn_dbf_ctu(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *const dbf_info,
             uint8_t log2_ctu_s, uint8_t last_x, uint8_t last_y)
@@ -2178,14 +2305,18 @@ rcn_dbf_ctu(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *const dbf_inf
     uint8_t ctu_abv = rcn_ctx->ctudec->ctu_ngh_flags & CTU_UP_FLG;
 
     if (rcn_ctx->ctudec->tmp_slice_type !=2){
-        dbf_ctu_preproc_v(&rcn_ctx->ctudec->drv_ctx.inter_ctx, dbf_info, nb_unit, nb_unit);
-        dbf_ctu_preproc_h(&rcn_ctx->ctudec->drv_ctx.inter_ctx, dbf_info, nb_unit, nb_unit);
+        dbf_ctu_preproc_v(df, &rcn_ctx->ctudec->drv_ctx.inter_ctx, dbf_info, nb_unit, nb_unit);
+        dbf_ctu_preproc_h(df, &rcn_ctx->ctudec->drv_ctx.inter_ctx, dbf_info, nb_unit, nb_unit);
     }
 
     if (!dbf_info->disable_h)
-    vvc_dbf_ctu_hor(df, fbuff->y, fbuff->stride, dbf_info, nb_unit, !!last_y, nb_unit, ctu_lft);
+    vvc_dbf_luma_hor(df, fbuff->y, fbuff->stride, dbf_info, nb_unit, !!last_y, nb_unit, ctu_lft);
     if (!dbf_info->disable_v)
-    vvc_dbf_ctu_ver(df, fbuff->y, fbuff->stride, dbf_info, nb_unit, !!last_x, nb_unit, ctu_abv);
+    vvc_dbf_luma_ver(df, fbuff->y, fbuff->stride, dbf_info, nb_unit, !!last_x, nb_unit, ctu_abv);
+
+    if (rcn_ctx->luma_only) {
+        return;
+    }
 
     if (!dbf_info->disable_h)
     vvc_dbf_chroma_hor(df, fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
@@ -2211,14 +2342,18 @@ rcn_dbf_truncated_ctu(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *con
     uint8_t ctu_abv = rcn_ctx->ctudec->ctu_ngh_flags & CTU_UP_FLG;
 
     if (rcn_ctx->ctudec->tmp_slice_type !=2){
-        dbf_ctu_preproc_v(&rcn_ctx->ctudec->drv_ctx.inter_ctx, dbf_info, nb_unit_h, nb_unit_w);
-        dbf_ctu_preproc_h(&rcn_ctx->ctudec->drv_ctx.inter_ctx, dbf_info, nb_unit_h, nb_unit_w);
+        dbf_ctu_preproc_v(df, &rcn_ctx->ctudec->drv_ctx.inter_ctx, dbf_info, nb_unit_h, nb_unit_w);
+        dbf_ctu_preproc_h(df, &rcn_ctx->ctudec->drv_ctx.inter_ctx, dbf_info, nb_unit_h, nb_unit_w);
     }
 
     if (!dbf_info->disable_h)
-    vvc_dbf_ctu_hor(df, fbuff->y, fbuff->stride, dbf_info, nb_unit_h, !!last_y, nb_unit_w, ctu_lft);
+    vvc_dbf_luma_hor(df, fbuff->y, fbuff->stride, dbf_info, nb_unit_h, !!last_y, nb_unit_w, ctu_lft);
     if (!dbf_info->disable_v)
-    vvc_dbf_ctu_ver(df, fbuff->y, fbuff->stride, dbf_info, nb_unit_w, !!last_x, nb_unit_h, ctu_abv);
+    vvc_dbf_luma_ver(df, fbuff->y, fbuff->stride, dbf_info, nb_unit_w, !!last_x, nb_unit_h, ctu_abv);
+
+    if (rcn_ctx->luma_only) {
+        return;
+    }
 
     if (!dbf_info->disable_h)
     vvc_dbf_chroma_hor(df, fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
@@ -2262,6 +2397,9 @@ BD_DECL(rcn_init_df_functions)(struct RCNFunctions *const rcn_funcs)
   rcn_funcs->df.filter_weak_v_c = filter_chroma_weak_v;
   rcn_funcs->df.filter_strong_h_c = filter_chroma_strong_c_h;
   rcn_funcs->df.filter_strong_v_c = filter_chroma_strong_c_v;
+  rcn_funcs->df.filter_edge_h = NULL;
+  rcn_funcs->df.filter_edge_v = NULL;
+  rcn_funcs->df.dbf_mv_check = &dbf_mv_check;
 
   rcn_funcs->df.rcn_dbf_ctu = &rcn_dbf_ctu;
   rcn_funcs->df.rcn_dbf_truncated_ctu = &rcn_dbf_truncated_ctu;
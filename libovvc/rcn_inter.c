@@ -837,38 +837,6 @@ refine_mv(uint64_t *sad_buff)
 #define MV_MIN -(1 << 17)
 #define MV_MAX ((1 << 17) - 1)
 
-static void
-extend_bdof_grad(int16_t *dst_grad, int16_t grad_stride, int16_t pb_w, int16_t pb_h)
-{
-    int16_t       *dst = dst_grad + grad_stride;
-    const int16_t *ref = dst + 1;
-
-    int16_t       *dst_lst = (int16_t*)ref + pb_w;
-    const int16_t *ref_lst = dst_lst - 1;
-
-    int j;
-
-    /* Copy or extend left and right column*/
-    for (j = 0; j < pb_h; ++j) {
-        dst[0]     = ref[0];
-        dst_lst[0] = ref_lst[0];
-
-        ref     += grad_stride;
-        dst     += grad_stride;
-        ref_lst += grad_stride;
-        dst_lst += grad_stride;
-    }
-
-    /* Copy or extend upper and lower ref_line */
-    dst = dst_grad;
-    ref = dst + grad_stride;
-    ref_lst = dst + (pb_h) * grad_stride;
-    dst_lst = (int16_t*)ref_lst + grad_stride;
-
-    memcpy(dst,     ref    , sizeof(*ref) * (pb_w + 2));
-    memcpy(dst_lst, ref_lst, sizeof(*ref) * (pb_w + 2));
-}
-
 static uint8_t
 rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
                    uint8_t x0, uint8_t y0,
@@ -1019,15 +987,9 @@ rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
         mc_l->bidir1[prec_1_mc_type][log2_pu_w - 1](dst.y, dst.stride, ref1_b.y, ref1_b.stride,
                                                     tmp_buff, pu_h, prec_x1, prec_y1, pu_w);
     } else {
-        int16_t grad_x0[(16 + 2) * (16 + 2)];
-        int16_t grad_y0[(16 + 2) * (16 + 2)];
-        int16_t grad_x1[(16 + 2) * (16 + 2)];
-        int16_t grad_y1[(16 + 2) * (16 + 2)];
-        
         int16_t *tmp_buff1 = (int16_t*) rcn_ctx->data.tmp_buff1;
         
         int16_t ref_stride = 128;
-        int16_t grad_stride = pu_w + 2;
 
         mc_l->bidir0[prec_0_mc_type][log2_pu_w - 1](tmp_buff + 128 + 1,
                                                     ref0_b.y, ref0_b.stride, pu_h,
@@ -1041,26 +1003,8 @@ rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
         bdof->extend_bdof_buff(ref0_b.y, tmp_buff, ref0_b.stride, pu_w, pu_h, prec_x0 >> 3, prec_y0 >> 3);
         bdof->extend_bdof_buff(ref1_b.y, tmp_buff1, ref1_b.stride, pu_w, pu_h, prec_x1 >> 3, prec_y1 >> 3);
 
-        bdof->grad(tmp_buff, ref_stride, pu_w, pu_h, grad_stride,
-                   grad_x0 + grad_stride + 1, grad_y0 + grad_stride + 1);
-
-        bdof->grad(tmp_buff1, ref_stride, pu_w, pu_h, grad_stride,
-                   grad_x1 + grad_stride + 1, grad_y1 + grad_stride + 1);
-
-        /* Grad padding */
-        extend_bdof_grad(grad_x0, grad_stride, pu_w, pu_h);
-        extend_bdof_grad(grad_y0, grad_stride, pu_w, pu_h);
-        extend_bdof_grad(grad_x1, grad_stride, pu_w, pu_h);
-        extend_bdof_grad(grad_y1, grad_stride, pu_w, pu_h);
-
-        /* Reference padding overwrite for weights derivation */
-        extend_bdof_grad(tmp_buff, ref_stride, pu_w, pu_h);
-        extend_bdof_grad(tmp_buff1, ref_stride, pu_w, pu_h);
-
-        /* Split into 4x4 subblocks for BDOF computation */
-        bdof->rcn_bdof(bdof, dst.y, dst.stride, tmp_buff + 128 + 1, tmp_buff1 + 128 + 1,
-                       ref_stride, grad_x0, grad_y0, grad_x1, grad_y1,
-                       grad_stride, pu_w, pu_h);
+        bdof->rcn_bdof_blk(bdof, dst.y, dst.stride, tmp_buff + 128 + 1, tmp_buff1 + 128 + 1,
+                           ref_stride, pu_w, pu_h);
 
     }
 
@@ -1068,6 +1012,10 @@ rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
                                                 ctudec->lmcs_info.luts,
                                                 pu_w, pu_h);
 
+    if (rcn_ctx->luma_only) {
+        return disable_bdof;
+    }
+
     dst.cb += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
     dst.cr += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
 
@@ -1197,14 +1145,7 @@ rcn_bdof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     int16_t ref_bdof0[(16 + 2 * PROF_BUFF_PADD_H) * (128 + 2 * PROF_BUFF_PADD_W)] = {0};
     int16_t ref_bdof1[(16 + 2 * PROF_BUFF_PADD_H) * (128 + 2 * PROF_BUFF_PADD_W)] = {0};
 
-    /* FIXME tab dim */
-    int16_t grad_x0[(16 + 2) * (16 + 2)];
-    int16_t grad_y0[(16 + 2) * (16 + 2)];
-    int16_t grad_x1[(16 + 2) * (16 + 2)];
-    int16_t grad_y1[(16 + 2) * (16 + 2)];
-
     int16_t ref_stride = 128;
-    int16_t grad_stride = pu_w + 2;
 
     int pb_w = 1 << log2_pu_w;
     int pb_h = 1 << log2_pu_h;
@@ -1221,28 +1162,10 @@ rcn_bdof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     bdof->extend_bdof_buff(ref0_b.y, ref_bdof0, ref0_b.stride, pb_w, pb_h, prec_x0 >> 3, prec_y0 >> 3);
     bdof->extend_bdof_buff(ref1_b.y, ref_bdof1, ref1_b.stride, pb_w, pb_h, prec_x1 >> 3, prec_y1 >> 3);
 
-    bdof->grad(ref_bdof0, ref_stride, pb_w, pb_h, grad_stride,
-               grad_x0 + grad_stride + 1, grad_y0 + grad_stride + 1);
-
-    bdof->grad(ref_bdof1, ref_stride, pb_w, pb_h, grad_stride,
-               grad_x1 + grad_stride + 1, grad_y1 + grad_stride + 1);
-
-    /* Grad padding */
-    extend_bdof_grad(grad_x0, grad_stride, pb_w, pb_h);
-    extend_bdof_grad(grad_y0, grad_stride, pb_w, pb_h);
-    extend_bdof_grad(grad_x1, grad_stride, pb_w, pb_h);
-    extend_bdof_grad(grad_y1, grad_stride, pb_w, pb_h);
-
-    /* Reference padding overwrite for weights derivation */
-    extend_bdof_grad(ref_bdof0, ref_stride, pb_w, pb_h);
-    extend_bdof_grad(ref_bdof1, ref_stride, pb_w, pb_h);
-
     dst.y += x0 + y0 * dst.stride;
 
-    /* Split into 4x4 subblocks for BDOF computation */
-    bdof->rcn_bdof(bdof, dst.y, dst.stride, ref_bdof0 + 128 + 1, ref_bdof1 + 128 + 1,
-                   ref_stride, grad_x0, grad_y0, grad_x1, grad_y1,
-                   grad_stride, pb_w, pb_h);
+    bdof->rcn_bdof_blk(bdof, dst.y, dst.stride, ref_bdof0 + 128 + 1, ref_bdof1 + 128 + 1,
+                       ref_stride, pb_w, pb_h);
 
     ctudec->rcn_funcs.lmcs_reshape_forward(dst.y, dst.stride,
                                             ctudec->lmcs_info.luts,
@@ -1394,6 +1317,10 @@ rcn_motion_compensation_b_c(OVCTUDec *const ctudec, struct OVBuffInfo dst,
                             uint8_t log2_pu_w, uint8_t log2_pu_h,
                             OVMV mv0, OVMV mv1, uint8_t ref_idx0, uint8_t ref_idx1)
 {
+    if (ctudec->rcn_ctx.luma_only) {
+        return;
+    }
+
     struct OVRCNCtx    *const rcn_ctx   = &ctudec->rcn_ctx;
     const struct InterDRVCtx *const inter_ctx = &ctudec->drv_ctx.inter_ctx;
     struct MCFunctions *mc_c = &ctudec->rcn_funcs.mc_c;
@@ -1822,6 +1749,10 @@ static void
 rcn_mcp_c(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log2_pu_w, int log2_pu_h,
           OVMV mv, uint8_t type, uint8_t ref_idx)
 {
+    if (ctudec->rcn_ctx.luma_only) {
+        return;
+    }
+
     struct OVRCNCtx    *const rcn_ctx   = &ctudec->rcn_ctx;
     struct InterDRVCtx *const inter_ctx = &ctudec->drv_ctx.inter_ctx;
 
@@ -2258,6 +2189,10 @@ static void
 rcn_mcp_rpr_c(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log2_pu_w, int log2_pu_h,
         OVMV mv, uint8_t type, uint8_t ref_idx, int scaling_hor, int scaling_ver)
 {
+    if (ctudec->rcn_ctx.luma_only) {
+        return;
+    }
+
     uint8_t log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
     int pos_x = (ctudec->ctb_x << log2_ctb_s) + x0;
     int pos_y = (ctudec->ctb_y << log2_ctb_s) + y0;
@@ -2656,6 +2591,10 @@ rcn_mc_rpr_b_c(OVCTUDec *const ctudec, struct OVBuffInfo dst,
                         int scale_rpl0_hor, int scale_rpl0_ver, 
                         int scale_rpl1_hor, int scale_rpl1_ver, struct VVCGPM* gpm_ctx )
 {
+    if (ctudec->rcn_ctx.luma_only) {
+        return;
+    }
+
     uint8_t no_scale_rpl0 = scale_rpl0_hor == (1<<RPR_SCALE_BITS) && scale_rpl0_ver == (1<<RPR_SCALE_BITS);
     uint8_t no_scale_rpl1 = scale_rpl1_hor == (1<<RPR_SCALE_BITS) && scale_rpl1_ver == (1<<RPR_SCALE_BITS);
     int type0 = 0;
@@ -2917,6 +2856,480 @@ rcn_prof_mcp_b_l(OVCTUDec*const lc_ctx, struct OVBuffInfo dst, struct InterDRVCt
     }
 }
 
+/* Affine CUs are reconstructed from 4x4 sub-blocks which must use the
+ * 6-tap luma filters: they cannot be merged into larger MC blocks.
+ * Instead, sub-blocks of a same row whose clipped MVs share the same
+ * integer part read contiguous reference windows. Each of those runs
+ * is synchronised and edge emulated once and its sub-blocks are then
+ * interpolated from the shared window with their own fractional phase.
+ */
+#define AFFINE_MV_STRIDE 34
+
+static inline uint8_t
+mv_frac_l(int32_t mv, uint8_t hpel_if)
+{
+    uint8_t prec = mv & 0xF;
+    return prec + ((hpel_if && prec == 8) ? 8 : 0);
+}
+
+static int
+derive_affine_ref_run_l(const OVPicture *const ref_pic, const OVMV *const mv_row,
+                        OVMV *const mv_clip, int pos_x, int pos_y, int nb_sb,
+                        OVSample *edge_buff, struct OVBuffInfo *const ref_b,
+                        int log2_ctb_s)
+{
+    OVSample *const ref_l = (OVSample *) ref_pic->frame->data[0];
+    int src_stride = ref_pic->frame->linesize[0] / sizeof(OVSample);
+
+    const int pic_w = ref_pic->frame->width;
+    const int pic_h = ref_pic->frame->height;
+
+    int ref_x, ref_y, int_x, int_y;
+    int run_w;
+    int n = 1;
+
+    mv_clip[0] = clip_mv(pos_x, pos_y, pic_w, pic_h, SB_W, SB_H, mv_row[0]);
+
+    int_x = mv_clip[0].x >> 4;
+    int_y = mv_clip[0].y >> 4;
+
+    while (n < nb_sb) {
+        OVMV mv = clip_mv(pos_x + (n << 2), pos_y, pic_w, pic_h, SB_W, SB_H, mv_row[n]);
+        if ((mv.x >> 4) != int_x || (mv.y >> 4) != int_y) {
+            break;
+        }
+        mv_clip[n++] = mv;
+    }
+
+    ref_x = pos_x + int_x;
+    ref_y = pos_y + int_y;
+    run_w = n << 2;
+
+    /* Frame thread synchronization for the whole run */
+    rcn_inter_synchronization(ref_pic, ref_x, ref_y, run_w, SB_H, log2_ctb_s);
+
+    if (test_for_edge_emulation(ref_x, ref_y, pic_w, pic_h, run_w, SB_H)) {
+        const OVSample *src_y = &ref_l[ref_x + ref_y * src_stride];
+        int src_off  = REF_PADDING_L * src_stride + REF_PADDING_L;
+        int buff_off = REF_PADDING_L * RCN_CTB_STRIDE + REF_PADDING_L;
+
+        emulate_block_border(edge_buff + 2 * RCN_CTB_STRIDE + 2, src_y - src_off,
+                             RCN_CTB_STRIDE, src_stride,
+                             run_w + QPEL_EXTRA, SB_H + QPEL_EXTRA,
+                             ref_x - REF_PADDING_L, ref_y - REF_PADDING_L,
+                             pic_w, pic_h);
+
+        ref_b->y = edge_buff + buff_off + 2 * RCN_CTB_STRIDE + 2;
+        ref_b->stride = RCN_CTB_STRIDE;
+    } else {
+        ref_b->y = &ref_l[ref_x + ref_y * src_stride];
+        ref_b->stride = src_stride;
+    }
+
+    return n;
+}
+
+static void
+rcn_affine_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst, const OVMV *mv_buff,
+                 int x0, int y0, int nb_sb_w, int nb_sb_h, uint8_t type, uint8_t ref_idx)
+{
+    struct OVRCNCtx *const rcn_ctx = &ctudec->rcn_ctx;
+    const struct InterDRVCtx *const inter_ctx = &ctudec->drv_ctx.inter_ctx;
+    const struct MCFunctions *const mc_l = &ctudec->rcn_funcs.mc_l;
+
+    const OVPicture *const ref_pic = type ? inter_ctx->rpl1[ref_idx] : inter_ctx->rpl0[ref_idx];
+    OVSample *edge_buff = (OVSample *)rcn_ctx->data.edge_buff0;
+
+    uint8_t hpel_if = inter_ctx->prec_amvr == MV_PRECISION_HALF;
+    const int log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
+    int pos_x = (ctudec->ctb_x << log2_ctb_s) + x0;
+    int pos_y = (ctudec->ctb_y << log2_ctb_s) + y0;
+
+    OVMV mv_clip[MAX_PB_SIZE >> 2];
+    int i, j, k;
+
+    dst.y += x0 + y0 * dst.stride;
+
+    for (i = 0; i < nb_sb_h; ++i) {
+        for (j = 0; j < nb_sb_w; j += k) {
+            struct OVBuffInfo ref_b;
+            int nb_run = derive_affine_ref_run_l(ref_pic, &mv_buff[j], &mv_clip[j],
+                                                 pos_x + (j << 2), pos_y, nb_sb_w - j,
+                                                 edge_buff, &ref_b, log2_ctb_s);
+
+            for (k = 0; k < nb_run; ++k) {
+                uint8_t prec_x = mv_frac_l(mv_clip[j + k].x, hpel_if);
+                uint8_t prec_y = mv_frac_l(mv_clip[j + k].y, hpel_if);
+                uint8_t mc_type = (prec_x > 0) + ((prec_y > 0) << 1);
+
+                mc_l->unidir[mc_type][1](dst.y + ((j + k) << 2), dst.stride,
+                                         ref_b.y + (k << 2), ref_b.stride,
+                                         SB_H, prec_x, prec_y, SB_W);
+            }
+        }
+        mv_buff += AFFINE_MV_STRIDE;
+        dst.y   += dst.stride << 2;
+        pos_y   += SB_H;
+    }
+}
+
+static void
+rcn_affine_mcp_bi_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
+                    const OVMV *mv_buff0, const OVMV *mv_buff1,
+                    int x0, int y0, int nb_sb_w, int nb_sb_h,
+                    uint8_t ref_idx0, uint8_t ref_idx1)
+{
+    struct OVRCNCtx *const rcn_ctx = &ctudec->rcn_ctx;
+    const struct InterDRVCtx *const inter_ctx = &ctudec->drv_ctx.inter_ctx;
+    const struct MCFunctions *const mc_l = &ctudec->rcn_funcs.mc_l;
+
+    const OVPicture *const ref0 = inter_ctx->rpl0[ref_idx0];
+    const OVPicture *const ref1 = inter_ctx->rpl1[ref_idx1];
+    OVSample *edge_buff0 = (OVSample *)rcn_ctx->data.edge_buff0;
+    OVSample *edge_buff1 = (OVSample *)rcn_ctx->data.edge_buff1;
+    int16_t *tmp_buff = (int16_t *) rcn_ctx->data.tmp_buff;
+
+    uint8_t hpel_if = inter_ctx->prec_amvr == MV_PRECISION_HALF;
+    const int log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
+    int pos_x = (ctudec->ctb_x << log2_ctb_s) + x0;
+    int pos_y = (ctudec->ctb_y << log2_ctb_s) + y0;
+
+    OVMV mv_clip0[MAX_PB_SIZE >> 2];
+    OVMV mv_clip1[MAX_PB_SIZE >> 2];
+    int i, j, k;
+
+    dst.y += x0 + y0 * dst.stride;
+
+    for (i = 0; i < nb_sb_h; ++i) {
+        /* First list is interpolated into a row of intermediate sub-blocks */
+        for (j = 0; j < nb_sb_w; j += k) {
+            struct OVBuffInfo ref_b;
+            int nb_run = derive_affine_ref_run_l(ref0, &mv_buff0[j], &mv_clip0[j],
+                                                 pos_x + (j << 2), pos_y, nb_sb_w - j,
+                                                 edge_buff0, &ref_b, log2_ctb_s);
+
+            for (k = 0; k < nb_run; ++k) {
+                uint8_t prec_x = mv_frac_l(mv_clip0[j + k].x, hpel_if);
+                uint8_t prec_y = mv_frac_l(mv_clip0[j + k].y, hpel_if);
+                uint8_t mc_type = (prec_x > 0) + ((prec_y > 0) << 1);
+
+                mc_l->bidir0[mc_type][1](tmp_buff + ((j + k) << 2),
+                                         ref_b.y + (k << 2), ref_b.stride,
+                                         SB_H, prec_x, prec_y, SB_W);
+            }
+        }
+
+        for (j = 0; j < nb_sb_w; j += k) {
+            struct OVBuffInfo ref_b;
+            int nb_run = derive_affine_ref_run_l(ref1, &mv_buff1[j], &mv_clip1[j],
+                                                 pos_x + (j << 2), pos_y, nb_sb_w - j,
+                                                 edge_buff1, &ref_b, log2_ctb_s);
+
+            for (k = 0; k < nb_run; ++k) {
+                uint8_t bcw_idx_plus1 = mv_clip0[j + k].bcw_idx_plus1;
+                uint8_t prec_x = mv_frac_l(mv_clip1[j + k].x, hpel_if);
+                uint8_t prec_y = mv_frac_l(mv_clip1[j + k].y, hpel_if);
+                uint8_t mc_type = (prec_x > 0) + ((prec_y > 0) << 1);
+                OVSample *dst_sb = dst.y + ((j + k) << 2);
+                int16_t *tmp_sb = tmp_buff + ((j + k) << 2);
+
+                if (bcw_idx_plus1 == 0 || bcw_idx_plus1 == 3) {
+                    mc_l->bidir1[mc_type][1](dst_sb, dst.stride,
+                                             ref_b.y + (k << 2), ref_b.stride,
+                                             tmp_sb, SB_H, prec_x, prec_y, SB_W);
+                } else {
+                    int16_t wt1 = bcw_weights[bcw_idx_plus1 - 1];
+                    int16_t wt0 = 8 - wt1;
+                    int denom = floor_log2(wt0 + wt1);
+                    mc_l->bidir_w[mc_type][1]((uint8_t *)dst_sb, dst.stride << 1,
+                                              (uint8_t *)(ref_b.y + (k << 2)), ref_b.stride << 1,
+                                              tmp_sb, MAX_PB_SIZE, SB_H, denom, wt0, wt1,
+                                              prec_x, prec_y, SB_W);
+                }
+            }
+        }
+
+        mv_buff0 += AFFINE_MV_STRIDE;
+        mv_buff1 += AFFINE_MV_STRIDE;
+        dst.y    += dst.stride << 2;
+        pos_y    += SB_H;
+    }
+}
+
+static void
+affine_prof_sb_l(const struct PROFFunctions *const prof, const struct MCFunctions *const mc_l,
+                 OVSample *dst, int dst_stride, const OVSample *src, int src_stride,
+                 uint8_t prec_x, uint8_t prec_y,
+                 const int16_t *dmv_scale_h, const int16_t *dmv_scale_v, uint8_t bidir)
+{
+    int16_t tmp_prof[(SB_H + 2 * PROF_BUFF_PADD_H) * (PROF_BUFF_STRIDE + 2 * PROF_BUFF_PADD_W)];
+    int16_t tmp_grad_x[16];
+    int16_t tmp_grad_y[16];
+    uint8_t mc_type = (prec_x > 0) + ((prec_y > 0) << 1);
+
+    mc_l->bidir0[mc_type][1](tmp_prof + PROF_BUFF_STRIDE + 1, src, src_stride,
+                             SB_H, prec_x, prec_y, SB_W);
+
+    prof->extend_prof_buff(src, tmp_prof, src_stride, prec_x >> 3, prec_y >> 3);
+
+    prof->grad(tmp_prof, PROF_BUFF_STRIDE, SB_W, SB_H, 4, tmp_grad_x, tmp_grad_y);
+
+    prof->rcn(dst, dst_stride, tmp_prof + PROF_BUFF_STRIDE + 1, PROF_BUFF_STRIDE,
+              tmp_grad_x, tmp_grad_y, 4, dmv_scale_h, dmv_scale_v, bidir);
+}
+
+static void
+rcn_affine_prof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst, const OVMV *mv_buff,
+                      int x0, int y0, int nb_sb_w, int nb_sb_h, uint8_t type, uint8_t ref_idx,
+                      const int16_t *dmv_scale_h, const int16_t *dmv_scale_v)
+{
+    struct OVRCNCtx *const rcn_ctx = &ctudec->rcn_ctx;
+    const struct InterDRVCtx *const inter_ctx = &ctudec->drv_ctx.inter_ctx;
+    const struct MCFunctions *const mc_l = &ctudec->rcn_funcs.mc_l;
+    const struct PROFFunctions *const prof = &ctudec->rcn_funcs.prof;
+
+    const OVPicture *const ref_pic = type ? inter_ctx->rpl1[ref_idx] : inter_ctx->rpl0[ref_idx];
+    OVSample *edge_buff = (OVSample *)rcn_ctx->data.edge_buff0;
+
+    uint8_t hpel_if = inter_ctx->prec_amvr == MV_PRECISION_HALF;
+    const int log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
+    int pos_x = (ctudec->ctb_x << log2_ctb_s) + x0;
+    int pos_y = (ctudec->ctb_y << log2_ctb_s) + y0;
+
+    OVMV mv_clip[MAX_PB_SIZE >> 2];
+    int i, j, k;
+
+    dst.y += x0 + y0 * dst.stride;
+
+    for (i = 0; i < nb_sb_h; ++i) {
+        for (j = 0; j < nb_sb_w; j += k) {
+            struct OVBuffInfo ref_b;
+            int nb_run = derive_affine_ref_run_l(ref_pic, &mv_buff[j], &mv_clip[j],
+                                                 pos_x + (j << 2), pos_y, nb_sb_w - j,
+                                                 edge_buff, &ref_b, log2_ctb_s);
+
+            for (k = 0; k < nb_run; ++k) {
+                affine_prof_sb_l(prof, mc_l, dst.y + ((j + k) << 2), dst.stride,
+                                 ref_b.y + (k << 2), ref_b.stride,
+                                 mv_frac_l(mv_clip[j + k].x, hpel_if),
+                                 mv_frac_l(mv_clip[j + k].y, hpel_if),
+                                 dmv_scale_h, dmv_scale_v, 0);
+            }
+        }
+        mv_buff += AFFINE_MV_STRIDE;
+        dst.y   += dst.stride << 2;
+        pos_y   += SB_H;
+    }
+}
+
+static void
+rcn_affine_prof_mcp_bi_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
+                         const OVMV *mv_buff0, const OVMV *mv_buff1,
+                         int x0, int y0, int nb_sb_w, int nb_sb_h,
+                         uint8_t ref_idx0, uint8_t ref_idx1,
+                         uint8_t prof_dir, const struct PROFInfo *const prof_info)
+{
+    struct OVRCNCtx *const rcn_ctx = &ctudec->rcn_ctx;
+    const struct InterDRVCtx *const inter_ctx = &ctudec->drv_ctx.inter_ctx;
+    const struct MCFunctions *const mc_l = &ctudec->rcn_funcs.mc_l;
+    const struct PROFFunctions *const prof = &ctudec->rcn_funcs.prof;
+
+    const OVPicture *const ref0 = inter_ctx->rpl0[ref_idx0];
+    const OVPicture *const ref1 = inter_ctx->rpl1[ref_idx1];
+    OVSample *edge_buff0 = (OVSample *)rcn_ctx->data.edge_buff0;
+    OVSample *edge_buff1 = (OVSample *)rcn_ctx->data.edge_buff1;
+    int16_t *tmp_buff  = (int16_t *) rcn_ctx->data.tmp_buff;
+    int16_t *tmp_buff1 = (int16_t *) rcn_ctx->data.tmp_buff1;
+
+    uint8_t hpel_if = inter_ctx->prec_amvr == MV_PRECISION_HALF;
+    const int log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
+    int pos_x = (ctudec->ctb_x << log2_ctb_s) + x0;
+    int pos_y = (ctudec->ctb_y << log2_ctb_s) + y0;
+
+    OVMV mv_clip0[MAX_PB_SIZE >> 2];
+    OVMV mv_clip1[MAX_PB_SIZE >> 2];
+    int i, j, k;
+
+    dst.y += x0 + y0 * dst.stride;
+
+    for (i = 0; i < nb_sb_h; ++i) {
+        for (j = 0; j < nb_sb_w; j += k) {
+            struct OVBuffInfo ref_b;
+            int nb_run = derive_affine_ref_run_l(ref0, &mv_buff0[j], &mv_clip0[j],
+                                                 pos_x + (j << 2), pos_y, nb_sb_w - j,
+                                                 edge_buff0, &ref_b, log2_ctb_s);
+
+            for (k = 0; k < nb_run; ++k) {
+                uint8_t prec_x = mv_frac_l(mv_clip0[j + k].x, hpel_if);
+                uint8_t prec_y = mv_frac_l(mv_clip0[j + k].y, hpel_if);
+                int16_t *tmp_sb = tmp_buff + ((j + k) << 2);
+
+                if (prof_dir & 0x1) {
+                    affine_prof_sb_l(prof, mc_l, (OVSample *)tmp_sb, MAX_PB_SIZE,
+                                     ref_b.y + (k << 2), ref_b.stride, prec_x, prec_y,
+                                     prof_info->dmv_scale_h_0, prof_info->dmv_scale_v_0, 1);
+                } else {
+                    uint8_t mc_type = (prec_x > 0) + ((prec_y > 0) << 1);
+                    mc_l->bidir0[mc_type][1](tmp_sb, ref_b.y + (k << 2), ref_b.stride,
+                                             SB_H, prec_x, prec_y, SB_W);
+                }
+            }
+        }
+
+        for (j = 0; j < nb_sb_w; j += k) {
+            struct OVBuffInfo ref_b;
+            int nb_run = derive_affine_ref_run_l(ref1, &mv_buff1[j], &mv_clip1[j],
+                                                 pos_x + (j << 2), pos_y, nb_sb_w - j,
+                                                 edge_buff1, &ref_b, log2_ctb_s);
+
+            for (k = 0; k < nb_run; ++k) {
+                uint8_t bcw_idx_plus1 = mv_clip0[j + k].bcw_idx_plus1;
+                uint8_t prec_x = mv_frac_l(mv_clip1[j + k].x, hpel_if);
+                uint8_t prec_y = mv_frac_l(mv_clip1[j + k].y, hpel_if);
+                OVSample *dst_sb = dst.y + ((j + k) << 2);
+                const OVSample *src_sb = ref_b.y + (k << 2);
+                int16_t *tmp_sb = tmp_buff + ((j + k) << 2);
+
+                if (prof_dir & 0x2) {
+                    affine_prof_sb_l(prof, mc_l, (OVSample *)tmp_buff1, MAX_PB_SIZE,
+                                     src_sb, ref_b.stride, prec_x, prec_y,
+                                     prof_info->dmv_scale_h_1, prof_info->dmv_scale_v_1, 1);
+
+                    if (bcw_idx_plus1 == 0 || bcw_idx_plus1 == 3) {
+                        prof->tmp_prof_mrg(dst_sb, dst.stride, tmp_buff1, MAX_PB_SIZE,
+                                           tmp_sb, SB_H, 0, 0, SB_W);
+                    } else {
+                        int16_t wt1 = bcw_weights[bcw_idx_plus1 - 1];
+                        int16_t wt0 = 8 - wt1;
+                        prof->tmp_prof_mrg_w(dst_sb, dst.stride, tmp_buff1, MAX_PB_SIZE,
+                                             tmp_sb, SB_H, 0, 0, SB_W, wt1, wt0);
+                    }
+                } else {
+                    uint8_t mc_type = (prec_x > 0) + ((prec_y > 0) << 1);
+                    if (bcw_idx_plus1 == 0 || bcw_idx_plus1 == 3) {
+                        mc_l->bidir1[mc_type][1](dst_sb, dst.stride, src_sb, ref_b.stride,
+                                                 tmp_sb, SB_H, prec_x, prec_y, SB_W);
+                    } else {
+                        int16_t wt1 = bcw_weights[bcw_idx_plus1 - 1];
+                        int16_t wt0 = 8 - wt1;
+                        int denom = floor_log2(wt0 + wt1);
+                        mc_l->bidir_w[mc_type][1]((uint8_t *)dst_sb, dst.stride << 1,
+                                                  (uint8_t *)src_sb, ref_b.stride << 1,
+                                                  tmp_sb, MAX_PB_SIZE, SB_H, denom, wt0, wt1,
+                                                  prec_x, prec_y, SB_W);
+                    }
+                }
+            }
+        }
+
+        mv_buff0 += AFFINE_MV_STRIDE;
+        mv_buff1 += AFFINE_MV_STRIDE;
+        dst.y    += dst.stride << 2;
+        pos_y    += SB_H;
+    }
+}
+
+static uint8_t
+affine_rpr_enabled(const struct InterDRVCtx *const inter_ctx, uint8_t inter_dir,
+                   uint8_t ref_idx0, uint8_t ref_idx1)
+{
+    uint8_t rpr = 0;
+    if (inter_dir & 0x1) {
+        rpr |= inter_ctx->scale_fact_rpl0[ref_idx0][0] != (1 << RPR_SCALE_BITS);
+        rpr |= inter_ctx->scale_fact_rpl0[ref_idx0][1] != (1 << RPR_SCALE_BITS);
+    }
+    if (inter_dir & 0x2) {
+        rpr |= inter_ctx->scale_fact_rpl1[ref_idx1][0] != (1 << RPR_SCALE_BITS);
+        rpr |= inter_ctx->scale_fact_rpl1[ref_idx1][1] != (1 << RPR_SCALE_BITS);
+    }
+    return rpr;
+}
+
+static void
+rcn_affine_mcp_b_l(OVCTUDec*const lc_ctx, struct OVBuffInfo dst, struct InterDRVCtx *const inter_ctx,
+                   const OVMV *mv_buff0, const OVMV *mv_buff1,
+                   unsigned int x0, unsigned int y0,
+                   unsigned int log2_cu_w, unsigned int log2_cu_h,
+                   uint8_t inter_dir, uint8_t ref_idx0, uint8_t ref_idx1)
+{
+    int nb_sb_w = (1 << log2_cu_w) >> 2;
+    int nb_sb_h = (1 << log2_cu_h) >> 2;
+    int i, j;
+
+    /* Scaled references and sub-blocks possibly falling back to uni
+     * prediction use the generic per sub-block path
+     */
+    uint8_t same_ref = inter_dir == 3 && inter_ctx->rpl0[ref_idx0]->poc == inter_ctx->rpl1[ref_idx1]->poc;
+    if (same_ref || affine_rpr_enabled(inter_ctx, inter_dir, ref_idx0, ref_idx1)) {
+        for (i = 0; i < nb_sb_h; ++i) {
+            for (j = 0; j < nb_sb_w; ++j) {
+                rcn_mcp_b_l(lc_ctx, dst, inter_ctx, lc_ctx->part_ctx,
+                            mv_buff0[j], mv_buff1[j], x0 + 4 * j, y0 + 4 * i,
+                            2, 2, inter_dir, ref_idx0, ref_idx1);
+            }
+            mv_buff0 += AFFINE_MV_STRIDE;
+            mv_buff1 += AFFINE_MV_STRIDE;
+        }
+        return;
+    }
+
+    if (inter_dir == 3) {
+        rcn_affine_mcp_bi_l(lc_ctx, dst, mv_buff0, mv_buff1, x0, y0,
+                            nb_sb_w, nb_sb_h, ref_idx0, ref_idx1);
+    } else if (inter_dir & 0x2) {
+        rcn_affine_mcp_l(lc_ctx, dst, mv_buff1, x0, y0, nb_sb_w, nb_sb_h, 1, ref_idx1);
+    } else {
+        rcn_affine_mcp_l(lc_ctx, dst, mv_buff0, x0, y0, nb_sb_w, nb_sb_h, 0, ref_idx0);
+    }
+
+    dst.y += x0 + y0 * dst.stride;
+    lc_ctx->rcn_funcs.lmcs_reshape_forward(dst.y, dst.stride, lc_ctx->lmcs_info.luts,
+                                           1 << log2_cu_w, 1 << log2_cu_h);
+}
+
+static void
+rcn_affine_prof_mcp_b_l(OVCTUDec*const lc_ctx, struct OVBuffInfo dst, struct InterDRVCtx *const inter_ctx,
+                        const OVMV *mv_buff0, const OVMV *mv_buff1,
+                        unsigned int x0, unsigned int y0,
+                        unsigned int log2_cu_w, unsigned int log2_cu_h,
+                        uint8_t inter_dir, uint8_t ref_idx0, uint8_t ref_idx1,
+                        uint8_t prof_dir, const struct PROFInfo *const prof_info)
+{
+    int nb_sb_w = (1 << log2_cu_w) >> 2;
+    int nb_sb_h = (1 << log2_cu_h) >> 2;
+    int i, j;
+
+    if (affine_rpr_enabled(inter_ctx, inter_dir, ref_idx0, ref_idx1)) {
+        for (i = 0; i < nb_sb_h; ++i) {
+            for (j = 0; j < nb_sb_w; ++j) {
+                rcn_prof_mcp_b_l(lc_ctx, dst, inter_ctx, lc_ctx->part_ctx,
+                                 mv_buff0[j], mv_buff1[j], x0 + 4 * j, y0 + 4 * i,
+                                 2, 2, inter_dir, ref_idx0, ref_idx1,
+                                 prof_dir, prof_info);
+            }
+            mv_buff0 += AFFINE_MV_STRIDE;
+            mv_buff1 += AFFINE_MV_STRIDE;
+        }
+        return;
+    }
+
+    if (inter_dir == 3) {
+        rcn_affine_prof_mcp_bi_l(lc_ctx, dst, mv_buff0, mv_buff1, x0, y0,
+                                 nb_sb_w, nb_sb_h, ref_idx0, ref_idx1,
+                                 prof_dir, prof_info);
+    } else if (inter_dir & 0x2) {
+        rcn_affine_prof_mcp_l(lc_ctx, dst, mv_buff1, x0, y0, nb_sb_w, nb_sb_h, 1, ref_idx1,
+                              prof_info->dmv_scale_h_1, prof_info->dmv_scale_v_1);
+    } else {
+        rcn_affine_prof_mcp_l(lc_ctx, dst, mv_buff0, x0, y0, nb_sb_w, nb_sb_h, 0, ref_idx0,
+                              prof_info->dmv_scale_h_0, prof_info->dmv_scale_v_0);
+    }
+
+    dst.y += x0 + y0 * dst.stride;
+    lc_ctx->rcn_funcs.lmcs_reshape_forward(dst.y, dst.stride, lc_ctx->lmcs_info.luts,
+                                           1 << log2_cu_w, 1 << log2_cu_h);
+}
+
 static void
 rcn_mcp_b_c(OVCTUDec*const lc_ctx, struct OVBuffInfo dst, struct InterDRVCtx *const inter_ctx,
             const OVPartInfo *const part_ctx,
@@ -2988,6 +3401,10 @@ rcn_ciip_weighted_sum(OVCTUDec*const ctudec, struct OVBuffInfo* tmp_intra, struc
     ciip->weighted(dst.y, dst.stride, tmp_intra->y, tmp_inter->y, tmp_intra->stride, tmp_inter->stride,
                    1 << log2_pb_w, 1 << log2_pb_h, wt);
 
+    if (ctudec->rcn_ctx.luma_only) {
+        return;
+    }
+
     dst.cb += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
     tmp_intra->cb += (x0 >> 1) + (y0 >> 1) * tmp_intra->stride_c;
     tmp_inter->cb += (x0 >> 1) + (y0 >> 1) * tmp_inter->stride_c;
@@ -3161,6 +3578,8 @@ BD_DECL(rcn_init_inter_functions)(struct RCNFunctions *const rcn_funcs)
     rcn_funcs->rcn_mcp_b          = &rcn_mcp_b;
     rcn_funcs->rcn_mcp_b_l        = &rcn_mcp_b_l;
     rcn_funcs->rcn_prof_mcp_b_l   = &rcn_prof_mcp_b_l;
+    rcn_funcs->rcn_affine_mcp_b_l = &rcn_affine_mcp_b_l;
+    rcn_funcs->rcn_affine_prof_mcp_b_l = &rcn_affine_prof_mcp_b_l;
     rcn_funcs->rcn_mcp_b_c        = &rcn_mcp_b_c;
     rcn_funcs->rcn_ciip_b         = &rcn_ciip_b;
     rcn_funcs->rcn_ciip           = &rcn_ciip;
@@ -32,6 +32,7 @@
  **/
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "rcn_structures.h"
 #include "ovutils.h"
@@ -491,6 +492,76 @@ rcn_bdof(struct BDOFFunctions *const bdof, OVSample *dst, int dst_stride,
     }
 }
 
+static void
+extend_bdof_grad(int16_t *dst_grad, int16_t grad_stride, int16_t pb_w, int16_t pb_h)
+{
+    int16_t       *dst = dst_grad + grad_stride;
+    const int16_t *ref = dst + 1;
+
+    int16_t       *dst_lst = (int16_t*)ref + pb_w;
+    const int16_t *ref_lst = dst_lst - 1;
+
+    int j;
+
+    /* Copy or extend left and right column*/
+    for (j = 0; j < pb_h; ++j) {
+        dst[0]     = ref[0];
+        dst_lst[0] = ref_lst[0];
+
+        ref     += grad_stride;
+        dst     += grad_stride;
+        ref_lst += grad_stride;
+        dst_lst += grad_stride;
+    }
+
+    /* Copy or extend upper and lower ref_line */
+    dst = dst_grad;
+    ref = dst + grad_stride;
+    ref_lst = dst + (pb_h) * grad_stride;
+    dst_lst = (int16_t*)ref_lst + grad_stride;
+
+    memcpy(dst,     ref    , sizeof(*ref) * (pb_w + 2));
+    memcpy(dst_lst, ref_lst, sizeof(*ref) * (pb_w + 2));
+}
+
+static void
+rcn_bdof_blk(struct BDOFFunctions *const bdof, OVSample *dst, int dst_stride,
+             int16_t *ref_bdof0, int16_t *ref_bdof1, int ref_stride,
+             uint8_t pb_w, uint8_t pb_h)
+{
+    /* FIXME tab dim */
+    int16_t grad_x0[(16 + 2) * (16 + 2)];
+    int16_t grad_y0[(16 + 2) * (16 + 2)];
+    int16_t grad_x1[(16 + 2) * (16 + 2)];
+    int16_t grad_y1[(16 + 2) * (16 + 2)];
+
+    int16_t *ref0 = ref_bdof0 - ref_stride - 1;
+    int16_t *ref1 = ref_bdof1 - ref_stride - 1;
+
+    int16_t grad_stride = pb_w + 2;
+
+    bdof->grad(ref0, ref_stride, pb_w, pb_h, grad_stride,
+               grad_x0 + grad_stride + 1, grad_y0 + grad_stride + 1);
+
+    bdof->grad(ref1, ref_stride, pb_w, pb_h, grad_stride,
+               grad_x1 + grad_stride + 1, grad_y1 + grad_stride + 1);
+
+    /* Grad padding */
+    extend_bdof_grad(grad_x0, grad_stride, pb_w, pb_h);
+    extend_bdof_grad(grad_y0, grad_stride, pb_w, pb_h);
+    extend_bdof_grad(grad_x1, grad_stride, pb_w, pb_h);
+    extend_bdof_grad(grad_y1, grad_stride, pb_w, pb_h);
+
+    /* Reference padding overwrite for weights derivation */
+    extend_bdof_grad(ref0, ref_stride, pb_w, pb_h);
+    extend_bdof_grad(ref1, ref_stride, pb_w, pb_h);
+
+    /* Split into 4x4 subblocks for BDOF computation */
+    bdof->rcn_bdof(bdof, dst, dst_stride, ref_bdof0, ref_bdof1,
+                   ref_stride, grad_x0, grad_y0, grad_x1, grad_y1,
+                   grad_stride, pb_w, pb_h);
+}
+
 void
 BD_DECL(rcn_init_bdof_functions)(struct RCNFunctions *const rcn_funcs)
 {
@@ -498,4 +569,5 @@ BD_DECL(rcn_init_bdof_functions)(struct RCNFunctions *const rcn_funcs)
     rcn_funcs->bdof.subblock = &rcn_apply_bdof_subblock;
     rcn_funcs->bdof.rcn_bdof = &rcn_bdof;
     rcn_funcs->bdof.extend_bdof_buff = &extend_bdof_buff;
+    rcn_funcs->bdof.rcn_bdof_blk = &rcn_bdof_blk;
 }
@@ -56,6 +56,7 @@ struct RCNFunctions;
 struct OVLMCSData;
 struct LMCSInfo;
 struct ISPTUInfo;
+struct BDOFFunctions;
 struct TUInfo;
 
 
@@ -168,6 +169,10 @@ typedef void (*TrFunc)(const int16_t *src, int16_t *dst,
                  ptrdiff_t src_stride,
                  int num_lines, int num_columns, int shift);
 
+typedef void (*TrAddFunc)(const int16_t *src, OVSample *dst, ptrdiff_t dst_stride,
+                          uint64_t sig_sb_map, int scale, int shift,
+                          int num_lines, int num_columns);
+
 typedef void (*DCFunc)(const OVSample* const src_above,
                  const OVSample* const src_left, OVSample* const dst,
                  ptrdiff_t dst_stride, int log2_pb_w, int log2_pb_h);
@@ -232,6 +237,10 @@ typedef void (*PROFFunction)(OVSample* dst, int dst_stride, const int16_t* src,
                              const int16_t* grad_x, const int16_t* grad_y, int grad_stride,
                              const int16_t* dmv_scale_h, const int16_t* dmv_scale_v, uint8_t bidir);
 
+typedef void (*BDOFBlkFunction)(struct BDOFFunctions *const bdof, OVSample *dst, int dst_stride,
+                                int16_t *ref_bdof0, int16_t *ref_bdof1, int ref_stride,
+                                uint8_t pb_w, uint8_t pb_h);
+
 typedef void (*BDOFSBFunction)(const int16_t* src0, int src0_stride,
                                const int16_t* src1, int src1_stride,
                                OVSample *dst, int dst_stride,
@@ -283,6 +292,11 @@ struct TRFunctions
 {
    TrFunc func[NB_TR_TYPES][NB_TR_SIZES];
    void (*dc)(int16_t* const dst, int log2_tb_w, int log2_tb_h, int dc_val);
+
+   /* Fused dequantization, DCT II and residual add on square TBs
+    * NULL when not available
+    */
+   TrAddFunc dct_ii_add[NB_TR_SIZES];
 };
 
 struct DCFunctions
@@ -388,6 +402,10 @@ struct BDOFFunctions{
                              int16_t ref_stride, int16_t pb_w, int16_t pb_h,
                              uint8_t ext_x, uint8_t ext_y);
 
+    /* BDOF on a whole block from padded bi-prediction buffers
+     * including gradients derivation and padding
+     */
+    BDOFBlkFunction rcn_bdof_blk;
 };
 
 struct CIIPFunctions{
@@ -395,6 +413,29 @@ struct CIIPFunctions{
 };
 
 struct DBFInfo;
+struct OVMV;
+
+/* Filtering parameters of four consecutive 4-sample segments
+ * of a luma edge, segments not set in seg_msk are left untouched
+ */
+struct DFEdgeParams
+{
+    int16_t beta[4];
+    int16_t tc[4];
+    uint8_t max_l_p[4];
+    uint8_t max_l_q[4];
+    uint8_t seg_msk;
+};
+
+typedef uint64_t (*DBFMVCheckFunc)(const struct OVMV *mv0_p, const struct OVMV *mv1_p,
+                                   const struct OVMV *mv0_q, const struct OVMV *mv1_q, ptrdiff_t mv_stride,
+                                   const int16_t *dist_ref0, const int16_t *dist_ref1,
+                                   uint64_t chk_b, uint64_t chk_p0, uint64_t chk_p1, uint64_t mv_p_p0);
+
+struct DFFunctions;
+typedef void (*DFEdgeFunction)(const struct DFFunctions *df, OVSample *src, const int stride,
+                               const struct DFEdgeParams *prms);
+
 struct DFFunctions{
     DFFilterFunction filter_h[11];
     DFFilterFunction filter_v[11];
@@ -405,6 +446,13 @@ struct DFFunctions{
     void (*filter_strong_h_c)(OVSample* src, const int stride, const int tc);
     void (*filter_strong_v_c)(OVSample* src, const int stride, const int tc, uint8_t is_cbt_b);
 
+    /* Decide and filter 16 luma samples of an edge at once */
+    DFEdgeFunction filter_edge_h;
+    DFEdgeFunction filter_edge_v;
+
+    /* MV and reference based BS of the units of an edge */
+    DBFMVCheckFunc dbf_mv_check;
+
     void (*rcn_dbf_ctu)(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *const dbf_info,
                         uint8_t log2_ctu_s, uint8_t last_x, uint8_t last_y);
 
@@ -660,6 +708,20 @@ struct RCNFunctions
                              uint8_t inter_dir, uint8_t ref_idx0, uint8_t ref_idx1,
                              uint8_t prof_dir, const struct PROFInfo *const prof_info);
 
+    /* Luma MC of a whole affine CU from its 4x4 sub-block MV buffers */
+    void (*rcn_affine_mcp_b_l)(OVCTUDec*const lc_ctx, struct OVBuffInfo dst, struct InterDRVCtx *const inter_ctx,
+                               const OVMV *mv_buff0, const OVMV *mv_buff1,
+                               unsigned int x0, unsigned int y0,
+                               unsigned int log2_cu_w, unsigned int log2_cu_h,
+                               uint8_t inter_dir, uint8_t ref_idx0, uint8_t ref_idx1);
+
+    void (*rcn_affine_prof_mcp_b_l)(OVCTUDec*const lc_ctx, struct OVBuffInfo dst, struct InterDRVCtx *const inter_ctx,
+                                    const OVMV *mv_buff0, const OVMV *mv_buff1,
+                                    unsigned int x0, unsigned int y0,
+                                    unsigned int log2_cu_w, unsigned int log2_cu_h,
+                                    uint8_t inter_dir, uint8_t ref_idx0, uint8_t ref_idx1,
+                                    uint8_t prof_dir, const struct PROFInfo *const prof_info);
+
     void (*rcn_mcp_b_c)(OVCTUDec*const lc_ctx, struct OVBuffInfo dst, struct InterDRVCtx *const inter_ctx,
                         const OVPartInfo *const part_ctx,
                         const OVMV mv0, const OVMV mv1,
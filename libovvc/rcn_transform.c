@@ -625,4 +625,8 @@ BD_DECL(rcn_init_tr_functions)(struct RCNFunctions *const rcn_funcs)
     rcn_funcs->tr.func[DCT_II][6] = &inverse_dct_ii_64;
 
     rcn_funcs->tr.dc = &inverse_dct_ii_dc;
+
+    for (int i = 0; i < NB_TR_SIZES; ++i) {
+        rcn_funcs->tr.dct_ii_add[i] = NULL;
+    }
 }
@@ -528,6 +528,51 @@ dequant_is_neg(const OVCTUDec *const ctudec, uint8_t qp, uint8_t log2_tb_w, uint
     return (deq_prms.dequant_sb == &dequant_sb_neg);
 }
 
+/* Dequantize, inverse transform and add the residual to dst in a single
+ * call when a fused function is available for the TB.
+ * Returns 0 if the residual still has to be reconstructed by
+ * rcn_residual() and added afterwards.
+ */
+static uint8_t
+rcn_residual_add(OVCTUDec *const ctudec,
+                 OVSample *const dst, ptrdiff_t dst_stride, const int16_t *src,
+                 uint8_t x0, uint8_t y0,
+                 unsigned int log2_tb_w, unsigned int log2_tb_h,
+                 uint8_t cu_mts_flag, uint8_t is_dc, uint8_t lfnst_flag,
+                 uint8_t is_mip, uint64_t sig_sb_map)
+{
+    const struct TRFunctions *TRFunc = &ctudec->rcn_funcs.tr;
+    uint8_t qp = ctudec->dequant_luma.qp;
+    struct IQScale deq_prms;
+
+    /* Only DCT II on square TBs is fused */
+    if (log2_tb_w != log2_tb_h || log2_tb_w > 5 || !TRFunc->dct_ii_add[log2_tb_w]) {
+        return 0;
+    }
+
+    if (is_dc || cu_mts_flag || lfnst_flag) {
+        return 0;
+    }
+
+    /* Implicit MTS selects DST VII */
+    if (!is_mip && ctudec->mts_implicit && log2_tb_w <= 4) {
+        return 0;
+    }
+
+    deq_prms = derive_dequant(ctudec, qp, log2_tb_w, log2_tb_h);
+    if (deq_prms.dequant_sb == &dequant_sb_neg) {
+        return 0;
+    }
+
+    fill_bs_map(&ctudec->dbf_info.bs1_map, x0, y0, log2_tb_w, log2_tb_h);
+
+    TRFunc->dct_ii_add[log2_tb_w](src, dst, dst_stride, sig_sb_map,
+                                  deq_prms.scale, deq_prms.shift,
+                                  derive_nb_rows(sig_sb_map), derive_nb_cols(sig_sb_map));
+
+    return 1;
+}
+
 static void
 dequant_non_4x4_sb(const OVCTUDec *const ctudec, int16_t *dst, int16_t *src, uint64_t sig_sb_map,
                    uint8_t log2_tb_w, uint8_t log2_tb_h, uint8_t qp)
@@ -960,7 +1005,10 @@ rcn_1xX_tb(OVCTUDec *const ctudec, const struct TBInfo *const tb_info, uint8_t l
 
     dequant_non_4x4_sb(ctudec, dequant_coeffs, src, tb_info->sig_sb_map, log2_tb_w, log2_tb_h, qp);
 
-    TRFunc->func[type_v][OVMIN(log2_tb_h,6)](dequant_coeffs, ctudec->transform_buff, tb_w, tb_w, tb_info->last_pos & 0x1F, TR_SHIFT_H + 1);
+    /* Coefficients are along the vertical axis so last_x is always 0 */
+    int nb_col = ((tb_info->last_pos >> 8) & 0x1F) + 1;
+
+    TRFunc->func[type_v][OVMIN(log2_tb_h,6)](dequant_coeffs, ctudec->transform_buff, tb_w, tb_w, nb_col, TR_SHIFT_H + 1);
 
 }
 
@@ -1045,7 +1093,9 @@ rcn_Xx1_tb(OVCTUDec *const ctudec, const struct TBInfo *const tb_info, uint8_t l
 
     dequant_non_4x4_sb(ctudec, dequant_coeffs, src, tb_info->sig_sb_map, log2_tb_w, log2_tb_h, qp);
 
-    TRFunc->func[type_h][OVMIN(log2_tb_w,6)](dequant_coeffs, ctudec->transform_buff, tb_h, tb_h, tb_info->last_pos & 0x1F, TR_SHIFT_H + 1);
+    int nb_col = (tb_info->last_pos & 0x1F) + 1;
+
+    TRFunc->func[type_h][OVMIN(log2_tb_w,6)](dequant_coeffs, ctudec->transform_buff, tb_h, tb_h, nb_col, TR_SHIFT_H + 1);
 
 }
 
@@ -1235,11 +1285,19 @@ rcn_tu_st(OVCTUDec *const ctu_dec,
     uint8_t jcbcr_flag = cbf_mask & 0x8;
     uint8_t cbf_mask_c = cbf_mask & 0x3;
 
+    /* Chroma residuals are parsed but not reconstructed */
+    if (ctu_dec->rcn_ctx.luma_only) {
+        jcbcr_flag = 0;
+        cbf_mask_c = 0;
+    }
+
     if (cbf_flag_l) {
         const struct TBInfo *const tb_info = &tu_info->tb_info[2];
         const struct RCNFunctions *const rcn_func = &ctu_dec->rcn_funcs;
         const struct OVBuffInfo *const ctu_buff = &ctu_dec->rcn_ctx.ctu_buff;
         int16_t *tr_buff = ctu_dec->transform_buff;
+        OVSample *dst_y = &ctu_buff->y[x0 + y0 * ctu_buff->stride];
+        uint8_t res_added = 0;
 
         if (!(tu_info->tr_skip_mask & 0x10)) {
             int lim_sb_s = ((((tb_info->last_pos >> 8)) >> 2) + (((tb_info->last_pos & 0xFF))>> 2) + 1) << 2;
@@ -1247,9 +1305,16 @@ rcn_tu_st(OVCTUDec *const ctu_dec,
             uint8_t is_mip = !!(cu_flags & flg_mip_flag);
             uint8_t is_intra = !!(cu_flags & flg_pred_mode_flag);
             is_mip |= !is_intra;
-            rcn_residual(ctu_dec, tr_buff, coeffs_y, x0, y0, log2_tb_w, log2_tb_h,
-                         tu_info->cu_mts_flag, tu_info->cu_mts_idx,
-                         !tb_info->last_pos, tu_info->lfnst_flag, is_mip, tu_info->lfnst_idx, tb_info->sig_sb_map);
+
+            res_added = rcn_residual_add(ctu_dec, dst_y, ctu_buff->stride, coeffs_y, x0, y0,
+                                         log2_tb_w, log2_tb_h, tu_info->cu_mts_flag,
+                                         !tb_info->last_pos, tu_info->lfnst_flag, is_mip,
+                                         tb_info->sig_sb_map);
+            if (!res_added) {
+                rcn_residual(ctu_dec, tr_buff, coeffs_y, x0, y0, log2_tb_w, log2_tb_h,
+                             tu_info->cu_mts_flag, tu_info->cu_mts_idx,
+                             !tb_info->last_pos, tu_info->lfnst_flag, is_mip, tu_info->lfnst_idx, tb_info->sig_sb_map);
+            }
 
         } else {
             int16_t *const coeffs_y = ctu_dec->residual_y + tu_info->pos_offset;
@@ -1258,8 +1323,9 @@ rcn_tu_st(OVCTUDec *const ctu_dec,
                                     log2_tb_w, log2_tb_h, qp, cu_flags);
         }
 
-        /* FIXME use transform add optimization */
-        rcn_func->ict.add[log2_tb_w](tr_buff, &ctu_buff->y[x0 + y0 * ctu_buff->stride], ctu_buff->stride, log2_tb_w, log2_tb_h, 0);
+        if (!res_added) {
+            rcn_func->ict.add[log2_tb_w](tr_buff, dst_y, ctu_buff->stride, log2_tb_w, log2_tb_h, 0);
+        }
             fill_bs_map(&ctu_dec->dbf_info.bs1_map, x0, y0, log2_tb_w, log2_tb_h);
         if (!(cu_flags & flg_intra_bdpcm_luma_flag)) {
             if (cu_flags & flg_pred_mode_flag) {
@@ -1313,6 +1379,8 @@ rcn_tu_l(OVCTUDec *const ctu_dec,
         const struct RCNFunctions *const rcn_func = &ctu_dec->rcn_funcs;
         const OVBuffInfo *const ctu_buff = &ctu_dec->rcn_ctx.ctu_buff;
         int16_t dst_stride = ctu_buff->stride;
+        OVSample *dst_y = &ctu_buff->y[x0 + y0 * dst_stride];
+        uint8_t res_added = 0;
 
         if (!(tu_info->tr_skip_mask & 0x10)) {
             int lim_sb_s = ((((tb_info->last_pos >> 8)) >> 2) + (((tb_info->last_pos & 0xFF))>> 2) + 1) << 2;
@@ -1320,9 +1388,16 @@ rcn_tu_l(OVCTUDec *const ctu_dec,
             uint8_t is_mip = !!(cu_flags & flg_mip_flag);
             uint8_t is_intra = !!(cu_flags & flg_pred_mode_flag);
             is_mip |= !is_intra;
-            rcn_residual(ctu_dec, ctu_dec->transform_buff, coeffs_y, x0, y0, log2_tb_w, log2_tb_h,
-                         tu_info->cu_mts_flag, tu_info->cu_mts_idx,
-                         !tb_info->last_pos, tu_info->lfnst_flag, is_mip, tu_info->lfnst_idx, tb_info->sig_sb_map);
+
+            res_added = rcn_residual_add(ctu_dec, dst_y, dst_stride, coeffs_y, x0, y0,
+                                         log2_tb_w, log2_tb_h, tu_info->cu_mts_flag,
+                                         !tb_info->last_pos, tu_info->lfnst_flag, is_mip,
+                                         tb_info->sig_sb_map);
+            if (!res_added) {
+                rcn_residual(ctu_dec, ctu_dec->transform_buff, coeffs_y, x0, y0, log2_tb_w, log2_tb_h,
+                             tu_info->cu_mts_flag, tu_info->cu_mts_idx,
+                             !tb_info->last_pos, tu_info->lfnst_flag, is_mip, tu_info->lfnst_idx, tb_info->sig_sb_map);
+            }
 
         } else {
             int16_t *const coeffs_y = ctu_dec->residual_y + tu_info->pos_offset;
@@ -1338,9 +1413,10 @@ rcn_tu_l(OVCTUDec *const ctu_dec,
         }
             fill_bs_map(&ctu_dec->dbf_info.bs1_map, x0, y0, log2_tb_w, log2_tb_h);
 
-        /* FIXME use transform add optimization */
-        rcn_func->ict.add[log2_tb_w](ctu_dec->transform_buff, &ctu_buff->y[x0 + y0 * dst_stride],
-                                     dst_stride, log2_tb_w, log2_tb_h, 0);
+        if (!res_added) {
+            rcn_func->ict.add[log2_tb_w](ctu_dec->transform_buff, dst_y,
+                                         dst_stride, log2_tb_w, log2_tb_h, 0);
+        }
     }
     fill_ctb_bound(&ctu_dec->dbf_info, x0, y0, log2_tb_w, log2_tb_h);
 }
@@ -1354,6 +1430,11 @@ rcn_tu_c(OVCTUDec *const ctu_dec, uint8_t x0, uint8_t y0,
     uint8_t jcbcr_flag = cbf_mask & 0x8;
     uint8_t cbf_mask_c = cbf_mask & 0x3;
 
+    if (ctu_dec->rcn_ctx.luma_only) {
+        jcbcr_flag = 0;
+        cbf_mask_c = 0;
+    }
+
     uint8_t x0_unit = (x0 << 1) >> LOG2_MIN_CU_S;
     uint8_t y0_unit = (y0 << 1) >> LOG2_MIN_CU_S;
     uint8_t nb_unit_w = (2 << log2_tb_w) >> LOG2_MIN_CU_S;
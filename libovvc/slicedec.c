@@ -628,7 +628,8 @@ slicedec_finish_decoding(OVSliceDec *sldec)
     if(t_main){
         pthread_mutex_lock(&t_main->main_mtx);
         // ov_log(NULL, OVLOG_DEBUG,"Slice sign main\n");
-        pthread_cond_signal(&t_main->main_cnd);
+        t_main->nb_pic_decoded++;
+        ovthread_notify_output(t_main);
         pthread_mutex_unlock(&t_main->main_mtx);
     }
 }
@@ -643,7 +644,7 @@ slicedec_decode_rect_entries(OVSliceDec *sldec, const OVPS *const prms, struct E
     int ret = 0;
     #if USE_THREADS
     // ovthread_decode_entries(&sldec->slice_sync, slicedec_decode_rect_entry, nb_entries);
-    ovthread_slice_add_entry_jobs(&sldec->slice_sync, slicedec_decode_rect_entry, nb_entries);
+    ret = ovthread_slice_add_entry_jobs(&sldec->slice_sync, slicedec_decode_rect_entry, nb_entries);
     #else
     int i;
     for (i = 0; i < nb_entries; ++i) {
@@ -1315,11 +1316,18 @@ slicedec_decode_rect_entry(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS
 
     ctudec->rcn_funcs.rcn_attach_frame_buff(rcn_ctx, sldec->pic->frame, &einfo, log2_ctb_s);
 
-    if (nb_ctu_w > ctudec->prev_nb_ctu_w_rect_entry) {
+    /* Buffers also depend on CTU size and sample size which can
+     * change with a new SPS
+     */
+    if (nb_ctu_w > ctudec->prev_nb_ctu_w_rect_entry ||
+        log2_ctb_s != ctudec->prev_log2_ctb_s ||
+        ctudec->bitdepth_minus8 != ctudec->prev_bitdepth_minus8) {
         int margin = 3;
         ctudec->rcn_funcs.rcn_alloc_filter_buffers(rcn_ctx, einfo.nb_ctu_w, margin, log2_ctb_s);
         ctudec->rcn_funcs.rcn_alloc_intra_line_buff(rcn_ctx, einfo.nb_ctu_w + 2, log2_ctb_s);
         ctudec->prev_nb_ctu_w_rect_entry = nb_ctu_w;
+        ctudec->prev_log2_ctb_s = log2_ctb_s;
+        ctudec->prev_bitdepth_minus8 = ctudec->bitdepth_minus8;
     }
 
     while (ctb_y < nb_ctu_h - 1) {
@@ -1463,6 +1471,10 @@ slicedec_init_slice_tools(OVCTUDec *const ctudec, const OVPS *const prms)
                         sps->sps_chroma_vertical_collocated_flag, ph->ph_lmcs_enabled_flag,
                         sps->sps_bitdepth_minus8 + 8);
 
+    if (ctudec->rcn_ctx.luma_only) {
+        rcn_init_luma_only_functions(&ctudec->rcn_funcs);
+    }
+
     //In loop filter information for CTU reconstruction
     ctudec_init_in_loop_filters(ctudec, prms);
     ctudec->tmp_slice_type = sh->sh_slice_type;
@@ -1470,23 +1482,76 @@ slicedec_init_slice_tools(OVCTUDec *const ctudec, const OVPS *const prms)
     return 0;
 }
 
+/* Filters parameters are still parsed so CABAC stays in sync, only
+ * the reconstruction stages are disabled
+ */
+static void
+slicedec_skip_in_loop_filters(OVCTUDec *const ctudec)
+{
+    ctudec->dbf_disable  = 1;
+    ctudec->dmvr_enabled = 0;
+    ctudec->bdof_enabled = 0;
+
+    rcn_skip_in_loop_filters(&ctudec->rcn_funcs);
+}
+
 int
 slicedec_update_entry_decoder(OVSliceDec *sldec, OVCTUDec *ctudec)
 {
     const OVPS *const prms = sldec->active_params;
     ctudec->pic_w = prms->pps->pps_pic_width_in_luma_samples;
     ctudec->pic_h = prms->pps->pps_pic_height_in_luma_samples;
+    ctudec->rcn_ctx.luma_only = sldec->luma_only;
+    ctudec->side_data = sldec->pic->frame->side_data;
     slicedec_init_slice_tools(ctudec, prms);
 
+    if (sldec->skip_ilf) {
+        slicedec_skip_in_loop_filters(ctudec);
+    }
+
     return 0;
 }
 
+static void
+lines_capacity(struct LinesCapacity *const cap, const OVPS *const prms)
+{
+    const OVPartInfo *const pinfo = &prms->sps_info.part_info[0];
+    const struct TileInfo *const tinfo = &prms->pps_info.tile_info;
+
+    cap->pic_w         = prms->sps->sps_pic_width_max_in_luma_samples;
+    cap->log2_ctb_s    = pinfo->log2_ctu_s;
+    cap->log2_min_cb_s = pinfo->log2_min_cb_s;
+    cap->nb_tile_cols  = tinfo->nb_tile_cols;
+    cap->nb_tile_rows  = tinfo->nb_tile_rows;
+}
+
+static int
+lines_fit(const struct LinesCapacity *const cap, const struct LinesCapacity *const req)
+{
+    return cap->pic_w         >= req->pic_w &&
+           cap->log2_ctb_s    == req->log2_ctb_s &&
+           cap->log2_min_cb_s <= req->log2_min_cb_s &&
+           cap->nb_tile_cols  >= req->nb_tile_cols &&
+           cap->nb_tile_rows  >= req->nb_tile_rows;
+}
+
 int
 slicedec_init_lines(OVSliceDec *const sldec, const OVPS *const prms)
 {
     const OVSH *sh = prms->sh;
+    struct LinesCapacity req;
     sldec->slice_type = sh->sh_slice_type;
 
+    lines_capacity(&req, prms);
+
+    /* Lines were allocated for smaller pictures or different
+     * partitioning
+     */
+    if (sldec->cabac_lines[0].qt_depth_map_x && !lines_fit(&sldec->lines_cap, &req)) {
+        cabac_lines_uninit(sldec);
+        drv_lines_uninit(sldec);
+    }
+
     if (!sldec->cabac_lines[0].qt_depth_map_x) {
         int ret;
         ret = init_cabac_lines(sldec, prms);
@@ -1504,6 +1569,7 @@ slicedec_init_lines(OVSliceDec *const sldec, const OVPS *const prms)
             ov_log(NULL, 3, "FAILED init DRV lines\n");
             return ret;
         }
+        sldec->lines_cap = req;
     } else {
         reset_drv_lines(sldec, prms);
     }
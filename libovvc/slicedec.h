@@ -169,11 +169,36 @@ typedef struct OVSliceDec
     */
    struct DRVLines drv_lines;
 
+   /* Parameters the CABAC and DRV lines were allocated for
+    * Lines are only reallocated when they are too small
+    * for the current picture
+    */
+   struct LinesCapacity {
+       uint16_t pic_w;
+       uint8_t log2_ctb_s;
+       uint8_t log2_min_cb_s;
+       uint8_t nb_tile_cols;
+       uint8_t nb_tile_rows;
+   } lines_cap;
+
    /* Reference to current pic being decoded */
    OVPicture *pic;
 
    struct SliceSynchro slice_sync;
 
+   /* Index of the NUMA node the frame thread is bound to
+    * in the decoder thread placement
+    */
+   uint8_t node_idx;
+
+   /* In-loop filters and decoder side MV refinement are
+    * skipped on current picture
+    */
+   uint8_t skip_ilf;
+
+   /* Chroma components are not reconstructed */
+   uint8_t luma_only;
+
 } OVSliceDec;
 
 void slicedec_copy_params(OVSliceDec *sldec, struct OVPS* dec_params);
@@ -944,20 +944,16 @@ ovcabac_attach_entry(OVCABACCtx *const cabac_ctx, const uint8_t *const entry_poi
     cabac_ctx->bytestream_start = cabac_ctx->bytestream = entry_point;
     cabac_ctx->bytestream_end   = entry_end;
 
-    cabac_ctx->low_b  =  (int)cabac_ctx->bytestream[0] << 18;
-    cabac_ctx->low_b +=  (int)cabac_ctx->bytestream[1] << 10;
-    cabac_ctx->bytestream += 2;
-
-    if(((uintptr_t)cabac_ctx->bytestream & 1) == 0) {
-        cabac_ctx->low_b |= 1 << 9;
-    } else {
-        cabac_ctx->low_b +=  (*cabac_ctx->bytestream++) << 2;
-        cabac_ctx->low_b += 2;
-    }
+    /* First bits are loaded so the 9 bits decoder value is aligned
+     * on range and followed by the remaining loaded bits
+     */
+    cabac_ctx->low_b  = (uint64_t)ovcabac_load_bytes(cabac_ctx->bytestream) << 10;
+    cabac_ctx->low_b |= 1 << 9;
+    cabac_ctx->bytestream += NB_CABAC_BITS >> 3;
 
     cabac_ctx->range = 0x1FE;
 
-    if ((cabac_ctx->range << (NB_CABAC_BITS + 1)) < cabac_ctx->low_b)
+    if (((uint64_t)cabac_ctx->range << (NB_CABAC_BITS + 1)) < cabac_ctx->low_b)
         return OV_ERROR;
 
     return 0;
@@ -1012,23 +1008,15 @@ int
 ovcabac_end_of_slice(OVCABACCtx *cabac_ctx)
 {
     cabac_ctx->range -= 2;
-    if (cabac_ctx->low_b < cabac_ctx->range << (NB_CABAC_BITS + 1)){
+    if (cabac_ctx->low_b < (uint64_t)cabac_ctx->range << (NB_CABAC_BITS + 1)){
         uint8_t log2_renorm = lps_renorm_table[cabac_ctx->range >> 3];
 
         cabac_ctx->low_b <<= log2_renorm;
         cabac_ctx->range <<= log2_renorm;
 
         if (!(cabac_ctx->low_b & CABAC_MASK)){
-            int num_bits = 0;
-            int tmp_fill = -CABAC_MASK;
-
-            tmp_fill += cabac_ctx->bytestream[0] << 9;
-            tmp_fill += cabac_ctx->bytestream[1] << 1;
-            cabac_ctx->low_b += tmp_fill << num_bits;
-
-            if (cabac_ctx->bytestream < cabac_ctx->bytestream_end){
-                cabac_ctx->bytestream += NB_CABAC_BITS >> 3;
-            }
+            int num_bits = ov_ctz64(cabac_ctx->low_b) - NB_CABAC_BITS;
+            ovcabac_refill(cabac_ctx, num_bits);
         }
         return 0;
     } else {
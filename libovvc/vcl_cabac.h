@@ -136,7 +136,7 @@ struct OVCABACCtx{
     const uint8_t *bytestream_start;
     const uint8_t *bytestream_end;
     uint32_t range;
-    uint32_t low_b;
+    uint64_t low_b;
     uint64_t ctx_table[OVCABAC_NB_CTX];
 };
 
@@ -181,19 +181,7 @@ ovcabac_read_ae_mmvd_merge_idx(OVCABACCtx *const cabac_ctx,
             }
         }
     }
-    int var2 = 0;
-    if (ovcabac_bypass_read(cabac_ctx)){
-    var2 += 2;
-        if (ovcabac_bypass_read(cabac_ctx)){
-            var2 += 1;
-        }
-    }
-    else{
-        var2 += 0;
-        if (ovcabac_bypass_read(cabac_ctx)){
-            var2 += 1;
-        }
-    }
+    int var2 = ovcabac_bypass_read_n(cabac_ctx, 2);
     return (var0 * MMVD_MAX_REFINE_NUM + var1 * 4 + var2);
 }
 
@@ -351,7 +339,7 @@ ovcabac_read_ae_inter_dir(OVCABACCtx *const cabac_ctx,
     return  1 + ovcabac_ae_read(cabac_ctx, &cabac_state[INTER_DIR_CTX_OFFSET + 5]);
 }
 
-/* FIXME optimize bypass CABAC reading for golomb + only used by mvd */
+/* FIXME only used by mvd */
 static int
 vvc_exp_golomb_mv(OVCABACCtx *const cabac_ctx)
 {
@@ -378,11 +366,7 @@ vvc_exp_golomb_mv(OVCABACCtx *const cabac_ctx)
     }
     #endif
 
-    while(length){
-        add_val <<= 1;
-        add_val |= ovcabac_bypass_read(cabac_ctx);
-        length--;
-    }
+    add_val = ovcabac_bypass_read_n(cabac_ctx, length);
 
     return offset + add_val;
 }
@@ -612,13 +596,7 @@ ovcabac_read_ae_cclm_flag(OVCABACCtx *const cabac_ctx)
 static uint8_t
 ovcabac_read_ae_intra_luma_mpm_remainder(OVCABACCtx *const cabac_ctx)
 {
-    uint8_t mpm_idx = ovcabac_bypass_read(cabac_ctx);
-    int nb_bits = 5;//FIXME check behaviour
-
-    while (--nb_bits) {
-        mpm_idx = mpm_idx << 1;
-        mpm_idx |= ovcabac_bypass_read(cabac_ctx);
-    }
+    uint8_t mpm_idx = ovcabac_bypass_read_n(cabac_ctx, 5);
 
     if (mpm_idx >= (1 << 5) - (61 - 32)) {
         mpm_idx <<= 1;
@@ -652,9 +630,7 @@ ovcabac_read_ae_intra_lm_chroma(OVCABACCtx *const cabac_ctx)
 static uint8_t
 ovcabac_read_ae_intra_chroma_mpm_idx(OVCABACCtx *const cabac_ctx)
 {
-    uint8_t idx = ovcabac_bypass_read(cabac_ctx) << 1;
-
-    return (idx | ovcabac_bypass_read(cabac_ctx));
+    return ovcabac_bypass_read_n(cabac_ctx, 2);
 }
 
 static uint8_t
@@ -707,6 +683,38 @@ collocated_qp(const struct DBFQPMap *qp_map, int x0, int y0,
    return qp_map->hor[34 + 2 + x0_u + y0_u * 34];
 }
 
+/* Report CU information on the 4x4 grid of frame side data */
+static void
+export_cu_info(OVCTUDec *const ctu_dec, const OVPartInfo *const part_ctx,
+               uint8_t x0, uint8_t y0, uint8_t log2_cb_w, uint8_t log2_cb_h,
+               uint8_t cu_mode)
+{
+    struct OVFrameSideData *const side_data = ctu_dec->side_data;
+    uint8_t log2_ctb_s = part_ctx->log2_ctu_s;
+    uint16_t cu_x = (ctu_dec->ctb_x << log2_ctb_s) + x0;
+    uint16_t cu_y = (ctu_dec->ctb_y << log2_ctb_s) + y0;
+    int nb_blk_w = (1 << log2_cb_w) >> LOG2_MIN_CU_S;
+    int nb_blk_h = (1 << log2_cb_h) >> LOG2_MIN_CU_S;
+    struct OVBlockInfo *blk_info = &side_data->blk_info[(cu_x >> LOG2_MIN_CU_S) +
+                                                        (cu_y >> LOG2_MIN_CU_S) * side_data->blk_stride];
+    struct OVBlockInfo info;
+    int i, j;
+
+    info.cu_x = cu_x;
+    info.cu_y = cu_y;
+    info.qp = ctu_dec->qp_ctx.current_qp;
+    info.cu_type = cu_mode;
+    info.log2_cu_w = log2_cb_w;
+    info.log2_cu_h = log2_cb_h;
+
+    for (j = 0; j < nb_blk_h; ++j) {
+        for (i = 0; i < nb_blk_w; ++i) {
+            blk_info[i] = info;
+        }
+        blk_info += side_data->blk_stride;
+    }
+}
+
 int
 coding_unit(OVCTUDec *const ctu_dec,
             const OVPartInfo *const part_ctx,
@@ -815,6 +823,11 @@ coding_unit(OVCTUDec *const ctu_dec,
         for (int i = 0; i < nb_cb_h; i++) {
             ctu_dec->drv_ctx.qp_map_y[y_cb + i] = ctu_dec->qp_ctx.current_qp;
         }
+
+        if (ctu_dec->side_data) {
+            export_cu_info(ctu_dec, part_ctx, x0, y0, log2_cb_w, log2_cb_h,
+                           ctu_dec->part_map.cu_mode_x[x_cb]);
+        }
     }
 
     // Update depth_maps to selected depths
@@ -387,10 +387,7 @@ decode_truncated_rice(OVCABACCtx *const cabac_ctx, uint8_t rice_param){
         length += ( prefix == 17 ? 15 - rice_param : prefix - 5 );
     }
 
-    while(length--){
-        value <<= 1;
-        value |= ovcabac_bypass_read(cabac_ctx);
-    }
+    value = ovcabac_bypass_read_n(cabac_ctx, length);
 
     value += offset;
     value <<= 1;
@@ -398,9 +395,94 @@ decode_truncated_rice(OVCABACCtx *const cabac_ctx, uint8_t rice_param){
     return value;
 }
 
-static const uint8_t rice_param_tab[32] =
+/* Context and Rice parameter derivation tables indexed by the sums
+ * stored in the neighbourhood template so that no clipping is required
+ * on context derivation.
+ * Note sums are stored as uint8_t hence the 256 entries.
+ */
+
+/* OVMIN((sum_abs_lvl + 1) >> 1, 3) */
+static const uint8_t sig_ctx_nbh_lut[256] =
 {
-  0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3
+    0, 1, 1, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+};
+
+/* 1 + OVMIN(sum_sig_nbs, 4) */
+static const uint8_t gtx_ctx_nbh_lut[256] =
+{
+    1, 2, 3, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+};
+
+/* Rice parameter of bypass coded coefficients from sum_abs_lvl2 */
+static const uint8_t rice_param_lut[256] =
+{
+    0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+};
+
+/* Rice parameter of pass 2 remainders from sum_abs_lvl2 */
+static const uint8_t rice_param_pass2_lut[256] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1,
+    1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
 };
 
 static inline void
@@ -420,13 +502,10 @@ decode_pass2_core(OVCABACCtx *const cabac_ctx,
     for (scan_pos = 0; scan_pos < nb_pass2; ++scan_pos){
         int idx = next_pass_idx_map[scan_pos];
         int rem_abs_lvl;
-        int sum_abs ;
         int rice_param ;
         int tr_ctx_pos = (idx & x_mask) + (idx >> log2_sb_w) * VVC_TR_CTX_STRIDE;
 
-        sum_abs = OVMAX(OVMIN((int)c_coding_ctx->sum_abs_lvl2[tr_ctx_pos] - 20, 31), 0);
-
-        rice_param = rice_param_tab [sum_abs];
+        rice_param = rice_param_pass2_lut[c_coding_ctx->sum_abs_lvl2[tr_ctx_pos]];
 
         rem_abs_lvl = decode_truncated_rice(cabac_ctx, rice_param);
 
@@ -462,19 +541,19 @@ decode_bypassed_coeff_core(OVCABACCtx *const cabac_ctx,
     for(scan_pos = last_scan_pos; scan_pos >= 0; --scan_pos){
         int idx = scan_map & 0xF;
         int value;
+        int pos0;
 
         int tr_ctx_pos = (idx & x_mask) + (idx >> log2_sb_w) * VVC_TR_CTX_STRIDE;
 
-        int sum_abs = OVMIN(31, c_coding_ctx->sum_abs_lvl2[tr_ctx_pos]);
-
-        rice_param = rice_param_tab[sum_abs];
+        rice_param = rice_param_lut[c_coding_ctx->sum_abs_lvl2[tr_ctx_pos]];
 
         value = decode_truncated_rice(cabac_ctx, rice_param) >> 1;
 
-        /*FIXME understand value saturation*/
-        value = (value == ((*state < 2 ? 1: 2) << rice_param))
-              ?  0 : (value  < ((*state < 2 ? 1: 2) << rice_param))
-              ?  value + 1 : value;
+        /* Remap value around pos0 = (state < 2 ? 1 : 2) << rice_param
+         * pos0 maps to 0 and values below pos0 are incremented
+         */
+        pos0  = (1 + (*state >> 1)) << rice_param;
+        value = (value + (value < pos0)) & -(value != pos0);
 
         if(value){
             update_coeff_nbgh_bypassed(c_coding_ctx, tr_ctx_pos, value);
@@ -497,13 +576,7 @@ decode_signs(OVCABACCtx *const cabac_ctx, int16_t *const sb_coeffs,
              uint32_t state_map, const uint8_t *const sig_c_idx_map,
              int nb_sig_c)
 {
-    uint32_t nb_signs = nb_sig_c;
-    uint32_t signs_map = 0;
-
-    while (nb_signs--){
-        signs_map <<= 1;
-        signs_map  |= ovcabac_bypass_read(cabac_ctx);
-    }
+    uint32_t signs_map = ovcabac_bypass_read_n(cabac_ctx, nb_sig_c);
 
     for (unsigned  k = 0; k < nb_sig_c; k++ ){
         int idx = sig_c_idx_map[k];
@@ -607,7 +680,7 @@ residual_coding_first_subblock_4x4(OVCABACCtx *const cabac_ctx,
         /*FIXME we could state ctx switch by same offset for chroma and luma
         */
         ctx_offset  = state_offset[prev_state];
-        ctx_offset += OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+        ctx_offset += sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
         ctx_offset += sig_map & 0xF;
 
         sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -617,8 +690,7 @@ residual_coding_first_subblock_4x4(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
@@ -724,7 +796,7 @@ residual_coding_subblock_4x4(OVCABACCtx *const cabac_ctx,
         tr_ctx_pos = (idx & x_mask) + (idx >> log2_sb_w) * VVC_TR_CTX_STRIDE;
 
         ctx_offset  = state_offset[prev_state];
-        ctx_offset += OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+        ctx_offset += sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
         ctx_offset += sig_map & 0xF;
 
         sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -734,8 +806,7 @@ residual_coding_subblock_4x4(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
@@ -779,7 +850,7 @@ residual_coding_subblock_4x4(OVCABACCtx *const cabac_ctx,
 
         if (nb_sig_c){
             ctx_offset  = state_offset[prev_state];
-            ctx_offset += OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+            ctx_offset += sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
             ctx_offset += sig_map & 0xF;
 
             sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -791,8 +862,7 @@ residual_coding_subblock_4x4(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
@@ -900,7 +970,7 @@ residual_coding_subblock_dc(OVCABACCtx *const cabac_ctx,
         /*FIXME we could state ctx switch by same offset for chroma and luma
         */
         ctx_offset  = state_offset[prev_state];
-        ctx_offset += OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+        ctx_offset += sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
         ctx_offset += sig_map & 0xF;
 
         sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -910,8 +980,7 @@ residual_coding_subblock_dc(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
@@ -954,7 +1023,7 @@ residual_coding_subblock_dc(OVCABACCtx *const cabac_ctx,
         --scan_pos;
 
         ctx_offset  = state_offset[prev_state];
-        ctx_offset += OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+        ctx_offset += sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
         ctx_offset += sig_map & 0xF;
 
         sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -965,8 +1034,7 @@ residual_coding_subblock_dc(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
@@ -1332,6 +1400,17 @@ ovcabac_read_ae_sb_2x8_far_dpq(OVCABACCtx *const cabac_ctx,
     return 0;
 }
 
+/* TS sign context offset from the number of significant and negative
+ * coefficients among left and above neighbours
+ * (nb_sig != 2 ? nb_sig + nb_neg : (nb_neg == 2 ? 2 : nb_neg ^ 1))
+ */
+static const uint8_t ts_sign_ctx_lut[3][3] =
+{
+    {0, 1, 2},
+    {1, 2, 3},
+    {1, 0, 2}
+};
+
 static void
 update_ts_neighbourhood_first_pass(uint8_t   *const nb_significant,
                                    uint8_t   *const sign_map,
@@ -1442,10 +1521,8 @@ ovcabac_read_ae_sb_ts_core(OVCABACCtx *const cabac_ctx,
 
         if (ts_sig_c_flag) {
 
-            /* FIXME better computation of sign_offset */
             uint8_t nb_signs_ngh = cctx->sign_map[x + y * VVC_TR_CTX_STRIDE];
-            int sign_offset = nb_sig_c_ngh != 2 ? nb_sig_c_ngh + nb_signs_ngh :
-                (nb_signs_ngh == 2 ? 2 : nb_signs_ngh ^ 1);
+            int sign_offset = ts_sign_ctx_lut[nb_sig_c_ngh][nb_signs_ngh];
 
             if (cctx->is_bdpcm) {
                 nb_sig_c_ngh = 3;
@@ -1495,8 +1572,7 @@ ovcabac_read_ae_sb_ts_core(OVCABACCtx *const cabac_ctx,
 
         if (ts_sig_c_flag) {
             uint8_t nb_signs_ngh = cctx->sign_map[x + y * VVC_TR_CTX_STRIDE];
-            int sign_offset = nb_sig_c_ngh != 2 ? nb_sig_c_ngh + nb_signs_ngh :
-                                                 (nb_signs_ngh == 2 ? 2 : nb_signs_ngh ^ 1);
+            int sign_offset = ts_sign_ctx_lut[nb_sig_c_ngh][nb_signs_ngh];
 
             if (cctx->is_bdpcm) {
                 nb_sig_c_ngh = 3;
@@ -1626,19 +1702,17 @@ decode_bypassed_coeff_sdh(OVCABACCtx *const cabac_ctx,
     for(scan_pos = last_scan_pos; scan_pos >= 0; --scan_pos){
         int idx = scan_map & 0xF;
         int value;
+        int pos0;
 
         int tr_ctx_pos = (idx & x_mask) + (idx >> log2_sb_w) * VVC_TR_CTX_STRIDE;
 
-        int sum_abs = OVMIN(31, c_coding_ctx->sum_abs_lvl2[tr_ctx_pos]);
-
-        rice_param = rice_param_tab[sum_abs];
+        rice_param = rice_param_lut[c_coding_ctx->sum_abs_lvl2[tr_ctx_pos]];
 
         value = decode_truncated_rice(cabac_ctx, rice_param) >> 1;
 
-        /*FIXME understand value saturation*/
-        value = (value == ((0 < 2 ? 1: 2) << rice_param))
-            ?  0 : (value  < ((0 < 2 ? 1: 2) << rice_param))
-            ?  value + 1 : value;
+        /* Remap value around pos0 = 1 << rice_param */
+        pos0  = 1 << rice_param;
+        value = (value + (value < pos0)) & -(value != pos0);
 
         if(value){
             update_coeff_nbgh_bypassed(c_coding_ctx, tr_ctx_pos, value);
@@ -1658,14 +1732,8 @@ decode_signs_sdh(OVCABACCtx *const cabac_ctx, int16_t *const sb_coeffs,
 {
     /*FIXME we could avoid sum_abs by xor on parity_flags */
     const uint32_t nb_signs = nb_sig_c - use_sdh;
-    uint32_t signs_map  = 0;
+    uint32_t signs_map  = ovcabac_bypass_read_n(cabac_ctx, nb_signs);
     uint32_t sum_parity = 0;
-    uint32_t nb_bins = nb_signs;
-
-    while (nb_bins--){
-        signs_map  = signs_map << 1;
-        signs_map |= ovcabac_bypass_read(cabac_ctx);
-    }
 
     signs_map  <<= 32 - nb_signs;
 
@@ -1768,7 +1836,7 @@ residual_coding_first_subblock_sdh(OVCABACCtx *const cabac_ctx,
 
         /*FIXME we could state ctx switch by same offset for chroma and luma
         */
-        ctx_offset  = OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+        ctx_offset  = sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
         ctx_offset += sig_map & 0xF;
 
         sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -1778,8 +1846,7 @@ residual_coding_first_subblock_sdh(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
@@ -1881,7 +1948,7 @@ residual_coding_subblock_sdh(OVCABACCtx *const cabac_ctx,
 
         /*FIXME we could state ctx switch by same offset for chroma and luma
         */
-        ctx_offset  = OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+        ctx_offset  = sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
         ctx_offset += sig_map & 0xF;
 
         sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -1891,8 +1958,7 @@ residual_coding_subblock_sdh(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
@@ -1931,7 +1997,7 @@ residual_coding_subblock_sdh(OVCABACCtx *const cabac_ctx,
         --scan_pos;
 
         if (nb_sig_c){
-            ctx_offset  = OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+            ctx_offset  = sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
             ctx_offset += sig_map & 0xF;
 
             sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -1943,8 +2009,7 @@ residual_coding_subblock_sdh(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
@@ -2046,7 +2111,7 @@ residual_coding_subblock_dc_sdh(OVCABACCtx *const cabac_ctx,
 
         /*FIXME we could state ctx switch by same offset for chroma and luma
         */
-        ctx_offset  = OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+        ctx_offset  = sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
         ctx_offset += sig_map & 0xF;
 
         sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -2056,8 +2121,7 @@ residual_coding_subblock_dc_sdh(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
@@ -2095,7 +2159,7 @@ residual_coding_subblock_dc_sdh(OVCABACCtx *const cabac_ctx,
         //decrease scan_pos so we know last sig_coeff was read in first pass or not
         --scan_pos;
 
-        ctx_offset  = OVMIN(((c_coding_ctx->sum_abs_lvl[tr_ctx_pos] + 1) >> 1), 3);
+        ctx_offset  = sig_ctx_nbh_lut[c_coding_ctx->sum_abs_lvl[tr_ctx_pos]];
         ctx_offset += sig_map & 0xF;
 
         sig_coeff_flag = ovcabac_ae_read(cabac_ctx, sig_flg_ctx + ctx_offset);
@@ -2106,8 +2170,7 @@ residual_coding_subblock_dc_sdh(OVCABACCtx *const cabac_ctx,
 
         if (sig_coeff_flag){
 
-            ctx_offset  = 1;
-            ctx_offset += OVMIN(c_coding_ctx->sum_sig_nbs[tr_ctx_pos], 4);
+            ctx_offset  = gtx_ctx_nbh_lut[c_coding_ctx->sum_sig_nbs[tr_ctx_pos]];
             ctx_offset += (par_map & 0xF);
 
             abs_gt1_flag = ovcabac_ae_read(cabac_ctx, abs_gt1_ctx + ctx_offset);
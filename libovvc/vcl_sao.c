@@ -95,12 +95,9 @@ ovcabac_read_ae_sao_type_idx(OVCABACCtx *const cabac_ctx, uint64_t *const cabac_
                     }
 
                 }
-                sao_ctu->band_position[0] = 0;
-                for (i=1; i < 6; i++)
-                    sao_ctu->band_position[0] |= ovcabac_bypass_read(cabac_ctx)<<(5-i);
+                sao_ctu->band_position[0] = ovcabac_bypass_read_n(cabac_ctx, 5);
             } else {
-                sao_ctu->eo_class[0] = ovcabac_bypass_read(cabac_ctx)<<1;
-                sao_ctu->eo_class[0] |= ovcabac_bypass_read(cabac_ctx);
+                sao_ctu->eo_class[0] = ovcabac_bypass_read_n(cabac_ctx, 2);
 
                 sao_ctu->offset_val[0][0] =  sao_ctu->offset_abs[0][0];
                 sao_ctu->offset_val[0][1] =  sao_ctu->offset_abs[0][1];
@@ -136,15 +133,10 @@ ovcabac_read_ae_sao_type_idx(OVCABACCtx *const cabac_ctx, uint64_t *const cabac_
                     }
                 }
 
-                sao_ctu->band_position[1] = 0;
-
-                for (i=1; i < 6; i++) {
-                    sao_ctu->band_position[1] |= ovcabac_bypass_read(cabac_ctx)<<(5-i);
-                }
+                sao_ctu->band_position[1] = ovcabac_bypass_read_n(cabac_ctx, 5);
 
             } else {//edge
-                sao_ctu->eo_class[1] = ovcabac_bypass_read(cabac_ctx)<<1;
-                sao_ctu->eo_class[1] |= ovcabac_bypass_read(cabac_ctx);
+                sao_ctu->eo_class[1] = ovcabac_bypass_read_n(cabac_ctx, 2);
                 sao_ctu->offset_val[1][0] =  sao_ctu->offset_abs[1][0];
                 sao_ctu->offset_val[1][1] =  sao_ctu->offset_abs[1][1];
                 sao_ctu->offset_val[1][2] =  0;
@@ -173,11 +165,7 @@ ovcabac_read_ae_sao_type_idx(OVCABACCtx *const cabac_ctx, uint64_t *const cabac_
                     }
                 }
 
-                sao_ctu->band_position[2] = 0;
-
-                for (i = 1; i < 6; i++) {
-                    sao_ctu->band_position[2] |= ovcabac_bypass_read(cabac_ctx)<<(5-i);
-                }
+                sao_ctu->band_position[2] = ovcabac_bypass_read_n(cabac_ctx, 5);
 
             } else {
                 sao_ctu->eo_class[2] = sao_ctu->eo_class[1];
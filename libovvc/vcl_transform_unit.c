@@ -272,9 +272,8 @@ decode_last_sig_suffix(OVCABACCtx *const cabac_ctx, int prefix)
 {
     int num_bins = (prefix - 2) >> 1;
     int val = 0;
-    while (num_bins > 0){
-        val = val << 1 | ovcabac_bypass_read(cabac_ctx) ;
-        --num_bins;
+    if (num_bins > 0){
+        val = ovcabac_bypass_read_n(cabac_ctx, num_bins);
     }
     val = (1 << ((prefix >> 1) - 1)) * (2 + (prefix & 1)) + val;
     return val;
@@ -41,9 +41,16 @@ void rcn_init_ict_functions_avx2(struct RCNFunctions *rcn_func, uint8_t type);
 void rcn_init_mip_functions_avx2(struct RCNFunctions *const rcn_funcs);
 void rcn_init_prof_functions_avx2(struct RCNFunctions *const rcn_funcs);
 void rcn_init_bdof_functions_avx2(struct RCNFunctions *const rcn_funcs);
+void rcn_init_bdof_functions_8_avx2(struct RCNFunctions *const rcn_funcs);
 void rcn_init_dmvr_functions_avx2(struct RCNFunctions *const rcn_funcs);
 void rcn_init_ciip_functions_avx2(struct RCNFunctions *const rcn_funcs);
 void rcn_init_mc_functions_avx2(struct RCNFunctions *const rcn_funcs);
 void rcn_init_intra_angular_functions_10_avx2(struct RCNFunctions *rcn_func);
+void rcn_init_tr_functions_avx2(struct RCNFunctions *const rcn_funcs);
+void rcn_init_df_functions_avx2(struct RCNFunctions *const rcn_funcs);
+void rcn_init_cclm_functions_avx2(struct RCNFunctions *rcn_func);
+void rcn_init_dc_planar_functions_avx2(struct RCNFunctions *const rcn_funcs);
+void rcn_init_lfnst_functions_avx2(struct RCNFunctions *rcn_func);
+void rcn_init_dequant_avx2(struct RCNFunctions *rcn_funcs);
 
 #endif//RCN_AVX2_H
@@ -0,0 +1,177 @@
+/**
+ *
+ *   OpenVVC is open-source real time software decoder compliant with the 
+ *   ITU-T H.266- MPEG-I - Part 3 VVC standard. OpenVVC is developed from 
+ *   scratch in C as a library that provides consumers with real time and
+ *   energy-aware decoding capabilities under different OS including MAC OS,
+ *   Windows, Linux and Android targeting low energy real-time decoding of
+ *   4K VVC videos on Intel x86 and ARM platforms.
+ * 
+ *   Copyright (C) 2020-2022  IETR-INSA Rennes :
+ *   
+ *   Pierre-Loup CABARAT
+ *   Wassim HAMIDOUCHE
+ *   Guillaume GAUTIER
+ *   Thomas AMESTOY
+ *
+ *   This library is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   This library is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *   USA
+ * 
+ **/
+
+
+#include <stdint.h>
+#include <string.h>
+
+#include <immintrin.h>
+
+#include "ovutils.h"
+#include "rcn_structures.h"
+
+static int
+derive_nb_cols(uint64_t sig_sb_map)
+{
+    uint8_t num_z = ov_clz64(sig_sb_map | 1);
+    uint8_t z_div8 = (num_z >> 3);
+
+    return (8 - z_div8) << 2;
+}
+
+/* Dequantize a whole 4x4 sub-block at once.
+ * Coefficients are interleaved with the rounding offset so that
+ * a single madd gives coeff * scale + add (or coeff * scale for
+ * negative shifts where scale_v holds zero weights for add).
+ */
+static inline __m256i
+dequant_sb_avx2(const int16_t *src, __m256i add, __m256i scale_v, int shift,
+                const uint8_t neg)
+{
+    __m256i sb = _mm256_loadu_si256((__m256i *)src);
+    __m256i x_lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(sb, add), scale_v);
+    __m256i x_hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(sb, add), scale_v);
+
+    if (neg) {
+        x_lo = _mm256_slli_epi32(x_lo, shift);
+        x_hi = _mm256_slli_epi32(x_hi, shift);
+    } else {
+        x_lo = _mm256_srai_epi32(x_lo, shift);
+        x_hi = _mm256_srai_epi32(x_hi, shift);
+    }
+
+    return _mm256_packs_epi32(x_lo, x_hi);
+}
+
+static inline void
+dequant_tb_avx2(int16_t *dst, const int16_t *src, int scale, int shift,
+                uint8_t log2_tb_w, uint8_t log2_tb_h, uint64_t sig_sb_map,
+                const uint8_t neg)
+{
+    int nb_rows = derive_nb_cols(sig_sb_map);
+    uint8_t log2_stride = OVMIN(5, log2_tb_w);
+    int stride = 1 << log2_stride;
+
+    int padd_size = (1 << OVMIN(5, log2_tb_h)) - nb_rows;
+
+    const __m256i z = _mm256_setzero_si256();
+    const __m256i add = _mm256_set1_epi16((1 << shift) >> 1);
+    const __m256i scale_v = _mm256_unpacklo_epi16(_mm256_set1_epi16(scale),
+                                                  neg ? z : _mm256_set1_epi16(1));
+
+    /* Force sig_sb_map to one in case of DC coefficient */
+    sig_sb_map |= !sig_sb_map;
+
+    for (int i = 0; i < nb_rows/4 ; i++) {
+        uint8_t sig_sb_row = sig_sb_map >> (i << 3);
+
+        if (log2_stride == 2) {
+            /* Sub-block rows are contiguous in destination */
+            __m256i sb = (sig_sb_row & 0x1) ? dequant_sb_avx2(src, add, scale_v, shift, neg) : z;
+
+            _mm256_storeu_si256((__m256i *)dst, sb);
+
+        } else if (log2_stride == 3) {
+            __m256i sb0 = (sig_sb_row & 0x1) ? dequant_sb_avx2(src,      add, scale_v, shift, neg) : z;
+            __m256i sb1 = (sig_sb_row & 0x2) ? dequant_sb_avx2(src + 16, add, scale_v, shift, neg) : z;
+
+            /* Lines 0 and 2 in l02, 1 and 3 in l13 */
+            __m256i l02 = _mm256_unpacklo_epi64(sb0, sb1);
+            __m256i l13 = _mm256_unpackhi_epi64(sb0, sb1);
+
+            _mm256_storeu_si256((__m256i *)&dst[0],  _mm256_permute2x128_si256(l02, l13, 0x20));
+            _mm256_storeu_si256((__m256i *)&dst[16], _mm256_permute2x128_si256(l02, l13, 0x31));
+
+        } else {
+            for (int j = 0; j < stride >> 4; j++) {
+                int16_t *_dst = dst + (j << 4);
+                const int16_t *_src = src + (j << 6);
+                uint8_t sig_sb = sig_sb_row & 0xF;
+
+                if (sig_sb) {
+                    __m256i sb0 = (sig_sb & 0x1) ? dequant_sb_avx2(_src,      add, scale_v, shift, neg) : z;
+                    __m256i sb1 = (sig_sb & 0x2) ? dequant_sb_avx2(_src + 16, add, scale_v, shift, neg) : z;
+                    __m256i sb2 = (sig_sb & 0x4) ? dequant_sb_avx2(_src + 32, add, scale_v, shift, neg) : z;
+                    __m256i sb3 = (sig_sb & 0x8) ? dequant_sb_avx2(_src + 48, add, scale_v, shift, neg) : z;
+
+                    __m256i l02_lo = _mm256_unpacklo_epi64(sb0, sb1);
+                    __m256i l02_hi = _mm256_unpacklo_epi64(sb2, sb3);
+                    __m256i l13_lo = _mm256_unpackhi_epi64(sb0, sb1);
+                    __m256i l13_hi = _mm256_unpackhi_epi64(sb2, sb3);
+
+                    _mm256_storeu_si256((__m256i *)_dst, _mm256_permute2x128_si256(l02_lo, l02_hi, 0x20));
+                    _dst += stride;
+                    _mm256_storeu_si256((__m256i *)_dst, _mm256_permute2x128_si256(l13_lo, l13_hi, 0x20));
+                    _dst += stride;
+                    _mm256_storeu_si256((__m256i *)_dst, _mm256_permute2x128_si256(l02_lo, l02_hi, 0x31));
+                    _dst += stride;
+                    _mm256_storeu_si256((__m256i *)_dst, _mm256_permute2x128_si256(l13_lo, l13_hi, 0x31));
+                } else {
+                    _mm256_storeu_si256((__m256i *)_dst, z);
+                    _dst += stride;
+                    _mm256_storeu_si256((__m256i *)_dst, z);
+                    _dst += stride;
+                    _mm256_storeu_si256((__m256i *)_dst, z);
+                    _dst += stride;
+                    _mm256_storeu_si256((__m256i *)_dst, z);
+                }
+                sig_sb_row >>= 4;
+            }
+        }
+        src += stride << 2;
+        dst += stride << 2;
+    }
+
+    memset(dst, 0, sizeof(*dst) * stride * padd_size);
+}
+
+static void
+dequant_tb_4x4_avx2(int16_t *dst, const int16_t *src, int scale, int shift,
+                    uint8_t log2_tb_w, uint8_t log2_tb_h, uint64_t sig_sb_map)
+{
+    dequant_tb_avx2(dst, src, scale, shift, log2_tb_w, log2_tb_h, sig_sb_map, 0);
+}
+
+static void
+dequant_tb_4x4_neg_avx2(int16_t *dst, const int16_t *src, int scale, int shift,
+                        uint8_t log2_tb_w, uint8_t log2_tb_h, uint64_t sig_sb_map)
+{
+    dequant_tb_avx2(dst, src, scale, shift, log2_tb_w, log2_tb_h, sig_sb_map, 1);
+}
+
+void
+rcn_init_dequant_avx2(struct RCNFunctions *rcn_funcs)
+{
+     rcn_funcs->tmp.dequant_tb_4x4 = &dequant_tb_4x4_avx2;
+     rcn_funcs->tmp.dequant_tb_4x4_neg = &dequant_tb_4x4_neg_avx2;
+}
@@ -0,0 +1,732 @@
+/**
+ *
+ *   OpenVVC is open-source real time software decoder compliant with the 
+ *   ITU-T H.266- MPEG-I - Part 3 VVC standard. OpenVVC is developed from 
+ *   scratch in C as a library that provides consumers with real time and
+ *   energy-aware decoding capabilities under different OS including MAC OS,
+ *   Windows, Linux and Android targeting low energy real-time decoding of
+ *   4K VVC videos on Intel x86 and ARM platforms.
+ * 
+ *   Copyright (C) 2020-2022  IETR-INSA Rennes :
+ *   
+ *   Pierre-Loup CABARAT
+ *   Wassim HAMIDOUCHE
+ *   Guillaume GAUTIER
+ *   Thomas AMESTOY
+ *
+ *   This library is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   This library is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *   USA
+ * 
+ **/
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <immintrin.h>
+
+#include "ovutils.h"
+#include "rcn_structures.h"
+#include "ctudec.h"
+
+#define PXL_MAX ((1 << 10) - 1)
+
+/* Four adjacent 4-sample segments of a luma edge are processed together.
+ * Each 64-bit lane of a vector holds the samples of one segment so that
+ * per segment decisions taken on its first and last sample positions
+ * are obtained by broadcasting those positions inside the 64-bit lane.
+ * Long filters decisions are vectorised the same way but the filtering
+ * itself still relies on the per segment functions.
+ */
+struct EdgeDecision
+{
+    __m256i strong;
+    __m256i weak;
+    __m256i ext_p;
+    __m256i ext_q;
+    __m256i tc;
+    uint8_t long_msk;
+};
+
+static inline __m256i
+bcast_pos0(__m256i x)
+{
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0x00), 0x00);
+}
+
+static inline __m256i
+bcast_pos3(__m256i x)
+{
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xFF), 0xFF);
+}
+
+static inline __m256i
+load_seg_params_16(const int16_t *prm)
+{
+    __m256i x = _mm256_cvtepu16_epi64(_mm_loadl_epi64((const __m128i *)prm));
+    return bcast_pos0(x);
+}
+
+static inline __m256i
+load_seg_params_8(const uint8_t *prm)
+{
+    int32_t val;
+    memcpy(&val, prm, sizeof(val));
+    __m256i x = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(val));
+    return bcast_pos0(x);
+}
+
+static inline __m256i
+seg_msk_to_vec(uint8_t seg_msk)
+{
+    return _mm256_set_epi64x(-(int64_t)((seg_msk >> 3) & 0x1), -(int64_t)((seg_msk >> 2) & 0x1),
+                             -(int64_t)((seg_msk >> 1) & 0x1), -(int64_t)( seg_msk       & 0x1));
+}
+
+static inline uint8_t
+vec_to_seg_msk(__m256i x)
+{
+    return _mm256_movemask_pd(_mm256_castsi256_pd(x));
+}
+
+static inline uint8_t
+derive_filter_idx(int filter_l_p, int filter_l_q)
+{
+    uint8_t p_idx = (filter_l_p >> 1) - 1;
+    uint8_t q_idx = (filter_l_q >> 1) - 1;
+    return (((p_idx & 0x3) << 2) | (q_idx & 0x3));
+}
+
+static inline uint8_t
+has_long_candidate(const struct DFEdgeParams *prms)
+{
+    uint8_t msk = 0;
+    int k;
+    for (k = 0; k < 4; ++k) {
+        msk |= (prms->max_l_p[k] > 3 || prms->max_l_q[k] > 3) << k;
+    }
+    return msk & prms->seg_msk;
+}
+
+static inline __m256i
+strong_side_dist(__m256i x0, __m256i x3, __m256i x4, __m256i x5, __m256i x6, __m256i x7,
+                 __m256i max_l)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    __m256i s3 = _mm256_abs_epi16(_mm256_sub_epi16(x3, x0));
+    __m256i s5 = _mm256_abs_epi16(_mm256_sub_epi16(x3, x5));
+    __m256i s7 = _mm256_abs_epi16(_mm256_add_epi16(_mm256_sub_epi16(x4, x5), _mm256_sub_epi16(x7, x6)));
+
+    s7 = _mm256_add_epi16(s7, _mm256_abs_epi16(_mm256_sub_epi16(x3, x7)));
+    s7 = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(s3, s7), one), 1);
+    s5 = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(s3, s5), one), 1);
+
+    s3 = _mm256_blendv_epi8(s3, s5, _mm256_cmpeq_epi16(max_l, _mm256_set1_epi16(5)));
+    s3 = _mm256_blendv_epi8(s3, s7, _mm256_cmpeq_epi16(max_l, _mm256_set1_epi16(7)));
+
+    return s3;
+}
+
+/* p[k] and q[k] hold the k-th sample away from the edge on each side,
+ * p[4..7] and q[4..7] are only read when long_cand is not zero.
+ */
+static inline uint8_t
+luma_edge_decision(const __m256i *p, const __m256i *q, const struct DFEdgeParams *prms,
+                   uint8_t long_cand, struct EdgeDecision *dec)
+{
+    const __m256i one   = _mm256_set1_epi16(1);
+    const __m256i beta  = load_seg_params_16(prms->beta);
+    const __m256i tc    = load_seg_params_16(prms->tc);
+    const __m256i max_l_p = load_seg_params_8(prms->max_l_p);
+    const __m256i max_l_q = load_seg_params_8(prms->max_l_q);
+    const __m256i active  = seg_msk_to_vec(prms->seg_msk);
+
+    __m256i dp = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_add_epi16(p[2], p[0]), _mm256_add_epi16(p[1], p[1])));
+    __m256i dq = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_add_epi16(q[0], q[2]), _mm256_add_epi16(q[1], q[1])));
+
+    __m256i dp0 = bcast_pos0(dp);
+    __m256i dp3 = bcast_pos3(dp);
+    __m256i dq0 = bcast_pos0(dq);
+    __m256i dq3 = bcast_pos3(dq);
+
+    __m256i d0 = _mm256_add_epi16(dp0, dq0);
+    __m256i d3 = _mm256_add_epi16(dp3, dq3);
+    __m256i d  = _mm256_add_epi16(d0, d3);
+
+    __m256i dec_on = _mm256_and_si256(_mm256_cmpgt_epi16(beta, d), active);
+    __m256i long_sel = _mm256_setzero_si256();
+
+    __m256i tc5 = _mm256_add_epi16(_mm256_slli_epi16(tc, 2), tc);
+    __m256i abs_pq0 = _mm256_abs_epi16(_mm256_sub_epi16(p[0], q[0]));
+    __m256i sw, l1;
+
+    tc5 = _mm256_srli_epi16(_mm256_add_epi16(tc5, one), 1);
+
+    if (_mm256_testz_si256(dec_on, dec_on)) {
+        return 0;
+    }
+
+    if (long_cand && !_mm256_testz_si256(dec_on, seg_msk_to_vec(long_cand))) {
+        const __m256i three = _mm256_set1_epi16(3);
+        const __m256i lp = _mm256_cmpgt_epi16(max_l_p, three);
+        const __m256i lq = _mm256_cmpgt_epi16(max_l_q, three);
+        const __m256i thr = _mm256_srli_epi16(_mm256_add_epi16(beta, _mm256_set1_epi16(0x10)), 5);
+        const __m256i beta_3 = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(beta, beta), beta), 5);
+
+        __m256i dpL = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_add_epi16(p[5], p[3]), _mm256_add_epi16(p[4], p[4])));
+        __m256i dqL = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_add_epi16(q[3], q[5]), _mm256_add_epi16(q[4], q[4])));
+
+        __m256i dp0L = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(dp0, bcast_pos0(dpL)), one), 1);
+        __m256i dp3L = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(dp3, bcast_pos3(dpL)), one), 1);
+        __m256i dq0L = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(dq0, bcast_pos0(dqL)), one), 1);
+        __m256i dq3L = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(dq3, bcast_pos3(dqL)), one), 1);
+        __m256i d0L, d3L, dL, sp, sq, l0;
+
+        dp0L = _mm256_blendv_epi8(dp0, dp0L, lp);
+        dp3L = _mm256_blendv_epi8(dp3, dp3L, lp);
+        dq0L = _mm256_blendv_epi8(dq0, dq0L, lq);
+        dq3L = _mm256_blendv_epi8(dq3, dq3L, lq);
+
+        d0L = _mm256_add_epi16(dp0L, dq0L);
+        d3L = _mm256_add_epi16(dp3L, dq3L);
+        dL  = _mm256_add_epi16(d0L, d3L);
+
+        sp = strong_side_dist(p[0], p[3], p[4], p[5], p[6], p[7], max_l_p);
+        sq = strong_side_dist(q[0], q[3], q[4], q[5], q[6], q[7], max_l_q);
+
+        l0 = _mm256_cmpgt_epi16(beta_3, _mm256_add_epi16(sp, sq));
+        l0 = _mm256_and_si256(l0, _mm256_cmpgt_epi16(tc5, abs_pq0));
+        l0 = _mm256_and_si256(bcast_pos0(l0), bcast_pos3(l0));
+
+        long_sel = _mm256_and_si256(_mm256_cmpgt_epi16(beta, dL), _mm256_or_si256(lp, lq));
+        long_sel = _mm256_and_si256(long_sel, _mm256_cmpgt_epi16(thr, d0L));
+        long_sel = _mm256_and_si256(long_sel, _mm256_cmpgt_epi16(thr, d3L));
+        long_sel = _mm256_and_si256(long_sel, l0);
+        long_sel = _mm256_and_si256(long_sel, dec_on);
+
+        dec_on = _mm256_andnot_si256(long_sel, dec_on);
+    }
+
+    l1 = _mm256_add_epi16(_mm256_abs_epi16(_mm256_sub_epi16(p[3], p[0])),
+                          _mm256_abs_epi16(_mm256_sub_epi16(q[3], q[0])));
+    l1 = _mm256_cmpgt_epi16(_mm256_srli_epi16(beta, 3), l1);
+    l1 = _mm256_and_si256(l1, _mm256_cmpgt_epi16(tc5, abs_pq0));
+    l1 = _mm256_and_si256(bcast_pos0(l1), bcast_pos3(l1));
+
+    __m256i thr = _mm256_srli_epi16(_mm256_add_epi16(beta, _mm256_set1_epi16(0x4)), 3);
+    sw = _mm256_cmpgt_epi16(max_l_p, _mm256_set1_epi16(2));
+    sw = _mm256_and_si256(sw, _mm256_cmpgt_epi16(thr, d0));
+    sw = _mm256_and_si256(sw, _mm256_cmpgt_epi16(thr, d3));
+    sw = _mm256_and_si256(sw, l1);
+
+    __m256i side_thd = _mm256_srli_epi16(_mm256_add_epi16(beta, _mm256_srli_epi16(beta, 1)), 3);
+    __m256i ext = _mm256_cmpgt_epi16(max_l_p, one);
+
+    /* Note extend_q is also conditioned by max_l_p as in C */
+    dec->ext_p  = _mm256_and_si256(_mm256_cmpgt_epi16(side_thd, _mm256_add_epi16(dp0, dp3)), ext);
+    dec->ext_q  = _mm256_and_si256(_mm256_cmpgt_epi16(side_thd, _mm256_add_epi16(dq0, dq3)), ext);
+    dec->strong = _mm256_and_si256(dec_on, sw);
+    dec->weak   = _mm256_andnot_si256(sw, dec_on);
+    dec->tc     = tc;
+    dec->long_msk = vec_to_seg_msk(long_sel);
+
+    return vec_to_seg_msk(dec_on) | dec->long_msk;
+}
+
+static inline __m256i
+clip_tc(__m256i val, __m256i ref, __m256i tc)
+{
+    val = _mm256_max_epi16(val, _mm256_sub_epi16(ref, tc));
+    return _mm256_min_epi16(val, _mm256_add_epi16(ref, tc));
+}
+
+static inline void
+filter_strong_small(__m256i *p, __m256i *q, __m256i tc, __m256i msk)
+{
+    const __m256i two  = _mm256_set1_epi16(2);
+    const __m256i four = _mm256_set1_epi16(4);
+    const __m256i tc2 = _mm256_add_epi16(tc, tc);
+    const __m256i tc3 = _mm256_add_epi16(tc2, tc);
+
+    __m256i pq0 = _mm256_add_epi16(p[0], q[0]);
+    __m256i p0x2 = _mm256_add_epi16(p[0], p[0]);
+    __m256i q0x2 = _mm256_add_epi16(q[0], q[0]);
+    __m256i p1x2 = _mm256_add_epi16(p[1], p[1]);
+    __m256i q1x2 = _mm256_add_epi16(q[1], q[1]);
+    __m256i p2x3 = _mm256_add_epi16(_mm256_add_epi16(p[2], p[2]), p[2]);
+    __m256i q2x3 = _mm256_add_epi16(_mm256_add_epi16(q[2], q[2]), q[2]);
+    __m256i p3x2 = _mm256_add_epi16(p[3], p[3]);
+    __m256i q3x2 = _mm256_add_epi16(q[3], q[3]);
+    __m256i s_p = _mm256_add_epi16(_mm256_add_epi16(p[2], p[1]), pq0);
+    __m256i s_q = _mm256_add_epi16(_mm256_add_epi16(q[2], q[1]), pq0);
+
+    __m256i p2, p1, p0, q0, q1, q2;
+
+    p2 = _mm256_add_epi16(_mm256_add_epi16(p3x2, p2x3), _mm256_add_epi16(p[1], pq0));
+    p1 = s_p;
+    p0 = _mm256_add_epi16(_mm256_add_epi16(p[2], p1x2), _mm256_add_epi16(p0x2, q0x2));
+    p0 = _mm256_add_epi16(p0, q[1]);
+    q0 = _mm256_add_epi16(_mm256_add_epi16(p[1], p0x2), _mm256_add_epi16(q0x2, q1x2));
+    q0 = _mm256_add_epi16(q0, q[2]);
+    q1 = s_q;
+    q2 = _mm256_add_epi16(_mm256_add_epi16(q3x2, q2x3), _mm256_add_epi16(q[1], pq0));
+
+    p2 = _mm256_srli_epi16(_mm256_add_epi16(p2, four), 3);
+    p1 = _mm256_srli_epi16(_mm256_add_epi16(p1, two), 2);
+    p0 = _mm256_srli_epi16(_mm256_add_epi16(p0, four), 3);
+    q0 = _mm256_srli_epi16(_mm256_add_epi16(q0, four), 3);
+    q1 = _mm256_srli_epi16(_mm256_add_epi16(q1, two), 2);
+    q2 = _mm256_srli_epi16(_mm256_add_epi16(q2, four), 3);
+
+    p[2] = _mm256_blendv_epi8(p[2], clip_tc(p2, p[2], tc),  msk);
+    p[1] = _mm256_blendv_epi8(p[1], clip_tc(p1, p[1], tc2), msk);
+    p[0] = _mm256_blendv_epi8(p[0], clip_tc(p0, p[0], tc3), msk);
+    q[0] = _mm256_blendv_epi8(q[0], clip_tc(q0, q[0], tc3), msk);
+    q[1] = _mm256_blendv_epi8(q[1], clip_tc(q1, q[1], tc2), msk);
+    q[2] = _mm256_blendv_epi8(q[2], clip_tc(q2, q[2], tc),  msk);
+}
+
+static inline void
+filter_weak(__m256i *p, __m256i *q, const struct EdgeDecision *dec)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i pxl_max = _mm256_set1_epi16(PXL_MAX);
+    const __m256i tc = dec->tc;
+    const __m256i th_cut = _mm256_mullo_epi16(tc, _mm256_set1_epi16(10));
+    const __m256i tc_h = _mm256_srli_epi16(tc, 1);
+    const __m256i tc2_p = _mm256_and_si256(dec->ext_p, tc_h);
+    const __m256i tc2_q = _mm256_and_si256(dec->ext_q, tc_h);
+
+    __m256i d_pq0 = _mm256_sub_epi16(q[0], p[0]);
+    __m256i d_pq1 = _mm256_sub_epi16(q[1], p[1]);
+    __m256i delta, delta1, delta2, msk;
+
+    delta = _mm256_add_epi16(_mm256_slli_epi16(d_pq0, 3), d_pq0);
+    delta = _mm256_sub_epi16(delta, _mm256_add_epi16(_mm256_add_epi16(d_pq1, d_pq1), d_pq1));
+    delta = _mm256_srai_epi16(_mm256_add_epi16(delta, _mm256_set1_epi16(8)), 4);
+
+    msk = _mm256_and_si256(_mm256_cmpgt_epi16(th_cut, _mm256_abs_epi16(delta)), dec->weak);
+
+    delta = _mm256_max_epi16(delta, _mm256_sub_epi16(zero, tc));
+    delta = _mm256_min_epi16(delta, tc);
+
+    delta1 = _mm256_sub_epi16(_mm256_avg_epu16(p[2], p[0]), p[1]);
+    delta2 = _mm256_sub_epi16(_mm256_avg_epu16(q[2], q[0]), q[1]);
+    delta1 = _mm256_srai_epi16(_mm256_add_epi16(delta1, delta), 1);
+    delta2 = _mm256_srai_epi16(_mm256_sub_epi16(delta2, delta), 1);
+    delta1 = _mm256_min_epi16(_mm256_max_epi16(delta1, _mm256_sub_epi16(zero, tc2_p)), tc2_p);
+    delta2 = _mm256_min_epi16(_mm256_max_epi16(delta2, _mm256_sub_epi16(zero, tc2_q)), tc2_q);
+
+    __m256i p1 = _mm256_add_epi16(p[1], delta1);
+    __m256i p0 = _mm256_add_epi16(p[0], delta);
+    __m256i q0 = _mm256_sub_epi16(q[0], delta);
+    __m256i q1 = _mm256_add_epi16(q[1], delta2);
+
+    p1 = _mm256_min_epi16(_mm256_max_epi16(p1, zero), pxl_max);
+    p0 = _mm256_min_epi16(_mm256_max_epi16(p0, zero), pxl_max);
+    q0 = _mm256_min_epi16(_mm256_max_epi16(q0, zero), pxl_max);
+    q1 = _mm256_min_epi16(_mm256_max_epi16(q1, zero), pxl_max);
+
+    p[1] = _mm256_blendv_epi8(p[1], p1, msk);
+    p[0] = _mm256_blendv_epi8(p[0], p0, msk);
+    q[0] = _mm256_blendv_epi8(q[0], q0, msk);
+    q[1] = _mm256_blendv_epi8(q[1], q1, msk);
+}
+
+/* Transpose two 8x8 blocks of 16-bit samples, one per 128-bit lane */
+static inline void
+transpose_8x8_x2(__m256i *x)
+{
+    __m256i t0 = _mm256_unpacklo_epi16(x[0], x[1]);
+    __m256i t1 = _mm256_unpackhi_epi16(x[0], x[1]);
+    __m256i t2 = _mm256_unpacklo_epi16(x[2], x[3]);
+    __m256i t3 = _mm256_unpackhi_epi16(x[2], x[3]);
+    __m256i t4 = _mm256_unpacklo_epi16(x[4], x[5]);
+    __m256i t5 = _mm256_unpackhi_epi16(x[4], x[5]);
+    __m256i t6 = _mm256_unpacklo_epi16(x[6], x[7]);
+    __m256i t7 = _mm256_unpackhi_epi16(x[6], x[7]);
+
+    __m256i u0 = _mm256_unpacklo_epi32(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi32(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi32(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi32(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi32(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi32(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi32(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi32(t5, t7);
+
+    x[0] = _mm256_unpacklo_epi64(u0, u4);
+    x[1] = _mm256_unpackhi_epi64(u0, u4);
+    x[2] = _mm256_unpacklo_epi64(u1, u5);
+    x[3] = _mm256_unpackhi_epi64(u1, u5);
+    x[4] = _mm256_unpacklo_epi64(u2, u6);
+    x[5] = _mm256_unpackhi_epi64(u2, u6);
+    x[6] = _mm256_unpacklo_epi64(u3, u7);
+    x[7] = _mm256_unpackhi_epi64(u3, u7);
+}
+
+/* Vertical edge: the 16 rows crossing the edge are transposed so that
+ * each vector holds one column (p3 .. q3) of the 16 rows.
+ */
+static void
+filter_edge_h_avx2(const struct DFFunctions *df, OVSample *src, const int stride,
+                   const struct DFEdgeParams *prms)
+{
+    const uint8_t long_cand = has_long_candidate(prms);
+    struct EdgeDecision dec;
+    __m256i x[8];
+    __m256i p[8], q[8];
+    uint8_t filt_msk, short_msk;
+    int r, k;
+
+    for (r = 0; r < 8; ++r) {
+        const OVSample *row0 = src + r * stride - 4;
+        const OVSample *row1 = src + (r + 8) * stride - 4;
+        __m128i lo = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+        if (prms->seg_msk & (1 << (r >> 2))) {
+            lo = _mm_loadu_si128((const __m128i *)row0);
+        }
+        if (prms->seg_msk & (1 << ((r + 8) >> 2))) {
+            hi = _mm_loadu_si128((const __m128i *)row1);
+        }
+        x[r] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    }
+
+    transpose_8x8_x2(x);
+
+    for (k = 0; k < 4; ++k) {
+        p[k] = x[3 - k];
+        q[k] = x[4 + k];
+    }
+
+    if (long_cand) {
+        /* Outer samples p7 .. p4 and q4 .. q7 of segments with long filters */
+        for (r = 0; r < 8; ++r) {
+            int s0 = r >> 2;
+            int s1 = (r + 8) >> 2;
+            __m128i lo = _mm_setzero_si128();
+            __m128i hi = _mm_setzero_si128();
+            if (long_cand & (1 << s0)) {
+                const OVSample *row = src + r * stride;
+                if (prms->max_l_p[s0] > 3) lo = _mm_loadl_epi64((const __m128i *)(row - 8));
+                if (prms->max_l_q[s0] > 3) lo = _mm_unpacklo_epi64(lo, _mm_loadl_epi64((const __m128i *)(row + 4)));
+            }
+            if (long_cand & (1 << s1)) {
+                const OVSample *row = src + (r + 8) * stride;
+                if (prms->max_l_p[s1] > 3) hi = _mm_loadl_epi64((const __m128i *)(row - 8));
+                if (prms->max_l_q[s1] > 3) hi = _mm_unpacklo_epi64(hi, _mm_loadl_epi64((const __m128i *)(row + 4)));
+            }
+            x[r] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        }
+
+        transpose_8x8_x2(x);
+
+        for (k = 0; k < 4; ++k) {
+            p[4 + k] = x[3 - k];
+            q[4 + k] = x[4 + k];
+        }
+    }
+
+    filt_msk = luma_edge_decision(p, q, prms, long_cand, &dec);
+    if (!filt_msk) {
+        return;
+    }
+
+    short_msk = filt_msk & ~dec.long_msk;
+
+    if (short_msk) {
+        filter_strong_small(p, q, dec.tc, dec.strong);
+        filter_weak(p, q, &dec);
+
+        for (k = 0; k < 4; ++k) {
+            x[3 - k] = p[k];
+            x[4 + k] = q[k];
+        }
+
+        transpose_8x8_x2(x);
+
+        for (r = 0; r < 8; ++r) {
+            if (short_msk & (1 << (r >> 2))) {
+                _mm_storeu_si128((__m128i *)(src + r * stride - 4), _mm256_castsi256_si128(x[r]));
+            }
+            if (short_msk & (1 << ((r + 8) >> 2))) {
+                _mm_storeu_si128((__m128i *)(src + (r + 8) * stride - 4), _mm256_extracti128_si256(x[r], 1));
+            }
+        }
+    }
+
+    for (k = 0; k < 4; ++k) {
+        if (dec.long_msk & (1 << k)) {
+            const int filter_idx = derive_filter_idx(prms->max_l_p[k], prms->max_l_q[k]);
+            df->filter_h[filter_idx](src + 4 * k * stride, stride, prms->tc[k]);
+        }
+    }
+}
+
+/* Horizontal edge: rows on both sides of the edge are loaded directly,
+ * only segments to be filtered are read from or written to memory.
+ */
+static void
+filter_edge_v_avx2(const struct DFFunctions *df, OVSample *src, const int stride,
+                   const struct DFEdgeParams *prms)
+{
+    const uint8_t long_cand = has_long_candidate(prms);
+    const __m256i ld_msk = seg_msk_to_vec(prms->seg_msk);
+    struct EdgeDecision dec;
+    __m256i p[8], q[8];
+    uint8_t filt_msk, short_msk;
+    int k;
+
+    for (k = 0; k < 4; ++k) {
+        p[k] = _mm256_maskload_epi64((const long long *)(src - (k + 1) * stride), ld_msk);
+        q[k] = _mm256_maskload_epi64((const long long *)(src + k * stride), ld_msk);
+    }
+
+    if (long_cand) {
+        uint8_t msk_p = 0, msk_q = 0;
+        for (k = 0; k < 4; ++k) {
+            msk_p |= (prms->max_l_p[k] > 3) << k;
+            msk_q |= (prms->max_l_q[k] > 3) << k;
+        }
+        const __m256i ld_msk_p = seg_msk_to_vec(msk_p & long_cand);
+        const __m256i ld_msk_q = seg_msk_to_vec(msk_q & long_cand);
+        for (k = 4; k < 8; ++k) {
+            p[k] = _mm256_maskload_epi64((const long long *)(src - (k + 1) * stride), ld_msk_p);
+            q[k] = _mm256_maskload_epi64((const long long *)(src + k * stride), ld_msk_q);
+        }
+    }
+
+    filt_msk = luma_edge_decision(p, q, prms, long_cand, &dec);
+    if (!filt_msk) {
+        return;
+    }
+
+    short_msk = filt_msk & ~dec.long_msk;
+
+    if (short_msk) {
+        const __m256i st_msk = seg_msk_to_vec(short_msk);
+
+        filter_strong_small(p, q, dec.tc, dec.strong);
+        filter_weak(p, q, &dec);
+
+        for (k = 0; k < 3; ++k) {
+            _mm256_maskstore_epi64((long long *)(src - (k + 1) * stride), st_msk, p[k]);
+            _mm256_maskstore_epi64((long long *)(src + k * stride), st_msk, q[k]);
+        }
+    }
+
+    for (k = 0; k < 4; ++k) {
+        if (dec.long_msk & (1 << k)) {
+            const int filter_idx = derive_filter_idx(prms->max_l_p[k], prms->max_l_q[k]);
+            df->filter_v[filter_idx](src + 4 * k, stride, prms->tc[k]);
+        }
+    }
+}
+
+/* MV based BS derivation: eight units of an edge are checked at once.
+ * An edge spans at most 32 units and MV buffers are 34x34 so whole blocks
+ * of eight MVs can be read without going past the MV buffer.
+ */
+struct MVLanes
+{
+    __m256i x;
+    __m256i y;
+    __m256i dist;
+};
+
+static inline __m256i
+lookup_dist(__m256i ref_idx, const __m256i *dist_ref)
+{
+    /* Look up the 16 entries POC distance table from registers */
+    __m256i dist_lo = _mm256_permutevar8x32_epi32(dist_ref[0], ref_idx);
+    __m256i dist_hi = _mm256_permutevar8x32_epi32(dist_ref[1], ref_idx);
+    __m256 sel = _mm256_castsi256_ps(_mm256_slli_epi32(ref_idx, 28));
+
+    return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(dist_lo),
+                                                _mm256_castsi256_ps(dist_hi), sel));
+}
+
+/* Only the int8_t ref_idx field is kept */
+static inline __m256i
+ref_idx_field(__m256i x)
+{
+    return _mm256_and_si256(x, _mm256_set1_epi32(0xF));
+}
+
+/* Eight consecutive OVMV are read as three vectors of 32-bit fields
+ * and deinterleaved with permutes
+ */
+static inline void
+load_mvs_contiguous(struct MVLanes *mv, const OVMV *src, const __m256i *dist_ref)
+{
+    const __m256i *src_v = (const __m256i *)src;
+    __m256i a = _mm256_loadu_si256(&src_v[0]);
+    __m256i b = _mm256_loadu_si256(&src_v[1]);
+    __m256i c = _mm256_loadu_si256(&src_v[2]);
+
+    __m256i x = _mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(0, 3, 6, 0, 0, 0, 0, 0));
+    __m256i y = _mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(1, 4, 7, 0, 0, 0, 0, 0));
+    __m256i r = _mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(2, 5, 0, 0, 0, 0, 0, 0));
+
+    x = _mm256_blend_epi32(x, _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(0, 0, 0, 1, 4, 7, 0, 0)), 0x38);
+    y = _mm256_blend_epi32(y, _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(0, 0, 0, 2, 5, 0, 0, 0)), 0x18);
+    r = _mm256_blend_epi32(r, _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(0, 0, 0, 3, 6, 0, 0, 0)), 0x1C);
+
+    x = _mm256_blend_epi32(x, _mm256_permutevar8x32_epi32(c, _mm256_setr_epi32(0, 0, 0, 0, 0, 0, 2, 5)), 0xC0);
+    y = _mm256_blend_epi32(y, _mm256_permutevar8x32_epi32(c, _mm256_setr_epi32(0, 0, 0, 0, 0, 0, 3, 6)), 0xE0);
+    r = _mm256_blend_epi32(r, _mm256_permutevar8x32_epi32(c, _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 4, 7)), 0xE0);
+
+    mv->x = x;
+    mv->y = y;
+    mv->dist = lookup_dist(ref_idx_field(r), dist_ref);
+}
+
+/* Strided OVMV are read one by one as (x, y, ref_idx, -) and transposed */
+static inline void
+load_mvs_strided(struct MVLanes *mv, const OVMV *src, ptrdiff_t mv_stride, const __m256i *dist_ref)
+{
+    __m256i r[4];
+    int k;
+
+    for (k = 0; k < 4; ++k) {
+        __m128i lo = _mm_loadu_si128((const __m128i *)&src[k * mv_stride]);
+        __m128i hi = _mm_loadu_si128((const __m128i *)&src[(k + 4) * mv_stride]);
+        r[k] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    }
+
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    __m256i t1 = _mm256_unpacklo_epi32(r[2], r[3]);
+    __m256i t2 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+
+    mv->x = _mm256_unpacklo_epi64(t0, t1);
+    mv->y = _mm256_unpackhi_epi64(t0, t1);
+    mv->dist = lookup_dist(ref_idx_field(_mm256_unpacklo_epi64(t2, t3)), dist_ref);
+}
+
+static inline void
+load_mvs(struct MVLanes *mv, const OVMV *src, ptrdiff_t mv_stride, const __m256i *dist_ref)
+{
+    if (mv_stride == 1) {
+        load_mvs_contiguous(mv, src, dist_ref);
+    } else {
+        load_mvs_strided(mv, src, mv_stride, dist_ref);
+    }
+}
+
+static inline __m256i
+mv_threshold_check(__m256i ax, __m256i ay, __m256i bx, __m256i by)
+{
+    const __m256i th = _mm256_set1_epi32(8 - 1);
+    __m256i abs_x = _mm256_abs_epi32(_mm256_sub_epi32(ax, bx));
+    __m256i abs_y = _mm256_abs_epi32(_mm256_sub_epi32(ay, by));
+    return _mm256_cmpgt_epi32(_mm256_max_epu32(abs_x, abs_y), th);
+}
+
+static inline __m256i
+bits_to_lanes(uint8_t bits)
+{
+    const __m256i sel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(bits), sel), sel);
+}
+
+static uint64_t
+dbf_mv_check_avx2(const OVMV *mv0_p, const OVMV *mv1_p, const OVMV *mv0_q, const OVMV *mv1_q,
+                  ptrdiff_t mv_stride, const int16_t *dist_ref0, const int16_t *dist_ref1,
+                  uint64_t chk_b, uint64_t chk_p0, uint64_t chk_p1, uint64_t mv_p_p0)
+{
+    const __m256i one = _mm256_set1_epi32(-1);
+    const __m256i dist0[2] = {
+        _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)&dist_ref0[0])),
+        _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)&dist_ref0[8]))
+    };
+    const __m256i dist1[2] = {
+        _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)&dist_ref1[0])),
+        _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)&dist_ref1[8]))
+    };
+    uint64_t chk = chk_b | chk_p0 | chk_p1;
+    uint64_t dst_map = 0;
+    int pos;
+
+    for (pos = 0; pos < 64 && (chk >> pos); pos += 8) {
+        const uint8_t blk_msk = (chk >> pos) & 0xFF;
+        const ptrdiff_t offset = pos * mv_stride;
+        const uint8_t bi_msk = (chk_b >> pos) & 0xFF;
+        struct MVLanes p0, p1, q0, q1;
+        __m256i bs = _mm256_setzero_si256();
+
+        if (!blk_msk) {
+            continue;
+        }
+
+        load_mvs(&p0, mv0_p + offset, mv_stride, dist0);
+        load_mvs(&p1, mv1_p + offset, mv_stride, dist1);
+        load_mvs(&q0, mv0_q + offset, mv_stride, dist0);
+        load_mvs(&q1, mv1_q + offset, mv_stride, dist1);
+
+        if (bi_msk) {
+            /* Both P and Q bi-predicted */
+            __m256i paired  = _mm256_and_si256(_mm256_cmpeq_epi32(p0.dist, q0.dist),
+                                               _mm256_cmpeq_epi32(p1.dist, q1.dist));
+            __m256i swapped = _mm256_and_si256(_mm256_cmpeq_epi32(p0.dist, q1.dist),
+                                               _mm256_cmpeq_epi32(p1.dist, q0.dist));
+            __m256i coupled = _mm256_cmpeq_epi32(p0.dist, p1.dist);
+
+            __m256i th_pr = _mm256_or_si256(mv_threshold_check(q0.x, q0.y, p0.x, p0.y),
+                                            mv_threshold_check(q1.x, q1.y, p1.x, p1.y));
+            __m256i th_sw = _mm256_or_si256(mv_threshold_check(q1.x, q1.y, p0.x, p0.y),
+                                            mv_threshold_check(q0.x, q0.y, p1.x, p1.y));
+
+            __m256i bs_b = one;
+            bs_b = _mm256_blendv_epi8(bs_b, th_sw, swapped);
+            bs_b = _mm256_blendv_epi8(bs_b, th_pr, paired);
+            bs_b = _mm256_blendv_epi8(bs_b, _mm256_and_si256(th_pr, th_sw), _mm256_and_si256(paired, coupled));
+
+            bs = _mm256_and_si256(bs_b, bits_to_lanes(bi_msk));
+        }
+
+        if (blk_msk & ~bi_msk) {
+            /* Single MV on both sides */
+            __m256i is_l0_q = bits_to_lanes((chk_p0  >> pos) & 0xFF);
+            __m256i is_l0_p = bits_to_lanes((mv_p_p0 >> pos) & 0xFF);
+
+            __m256i px = _mm256_blendv_epi8(p1.x,    p0.x,    is_l0_p);
+            __m256i py = _mm256_blendv_epi8(p1.y,    p0.y,    is_l0_p);
+            __m256i pd = _mm256_blendv_epi8(p1.dist, p0.dist, is_l0_p);
+            __m256i qx = _mm256_blendv_epi8(q1.x,    q0.x,    is_l0_q);
+            __m256i qy = _mm256_blendv_epi8(q1.y,    q0.y,    is_l0_q);
+            __m256i qd = _mm256_blendv_epi8(q1.dist, q0.dist, is_l0_q);
+
+            __m256i bs_u = _mm256_blendv_epi8(one, mv_threshold_check(qx, qy, px, py),
+                                              _mm256_cmpeq_epi32(pd, qd));
+
+            bs = _mm256_or_si256(bs, _mm256_and_si256(bs_u, bits_to_lanes(blk_msk & ~bi_msk)));
+        }
+
+        dst_map |= (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(bs)) << pos;
+    }
+
+    return dst_map;
+}
+
+void
+rcn_init_df_functions_avx2(struct RCNFunctions *const rcn_funcs)
+{
+    rcn_funcs->df.filter_edge_h = &filter_edge_h_avx2;
+    rcn_funcs->df.filter_edge_v = &filter_edge_v_avx2;
+    rcn_funcs->df.dbf_mv_check  = &dbf_mv_check_avx2;
+}
@@ -38,32 +38,9 @@
 #define DMVR_NUM_ITERATION 2
 #define DMVR_SAD_STRIDE  ((2 * DMVR_NUM_ITERATION) + 1)
 #define DMVR_NB_IDX (DMVR_SAD_STRIDE * DMVR_SAD_STRIDE)
+#define DMVR_CENTER_IDX ((DMVR_NB_IDX - 1) >> 1)
 
-static const int8_t dmvr_mv_x[25 + 25] = {
-    -2, -1, 0, 1, 2,
-    -2, -1, 0, 1, 2,
-    -2, -1, 0, 1, 2,
-    -2, -1, 0, 1, 2,
-    -2, -1, 0, 1, 2,
-    2, 1, 0, -1, -2,
-    2, 1, 0, -1, -2,
-    2, 1, 0, -1, -2,
-    2, 1, 0, -1, -2,
-    2, 1, 0, -1, -2,
-};
-
-static const int8_t dmvr_mv_y[25 + 25] = {
-    -2, -2, -2, -2, -2,
-    -1, -1, -1, -1, -1,
-     0,  0,  0,  0,  0,
-     1,  1,  1,  1,  1,
-     2,  2,  2,  2,  2,
-     2,  2,  2,  2,  2,
-     1,  1,  1,  1,  1,
-     0,  0,  0,  0,  0,
-    -1, -1, -1, -1, -1,
-    -2, -2, -2, -2, -2,
-};
+#define DMVR_STRIDE (128 + 4)
 
 static uint64_t
 rcn_dmvr_sad_16(const uint16_t *ref0, const uint16_t *ref1,
@@ -90,44 +67,154 @@ rcn_dmvr_sad_16(const uint16_t *ref0, const uint16_t *ref1,
   return sum;
 }
 
-/*FIXME return min_dmvr_idx; */
-static uint8_t
-dmvr_compute_sads_16(const uint16_t *ref0, const uint16_t *ref1,
-                  uint64_t *sad_array, int sb_w, int sb_h)
+static uint64_t
+rcn_dmvr_sad_8(const uint16_t *ref0, const uint16_t *ref1,
+               int16_t dmvr_stride, int16_t pb_w, int16_t pb_h)
 {
-    const int32_t stride_l0 = 128 + 4;
-    const int32_t stride_l1 = 128 + 4;
+  const __m256i one = _mm256_set1_epi16(1);
+  __m256i acc = _mm256_setzero_si256();
+  __m128i sum;
+  int i;
 
-    const int16_t *const ref0_start = ref0;
-    const int16_t *const ref1_start = ref1;
-    uint64_t min_cost = (uint64_t) -1;
+  /* Two sub-sampled lines per register */
+  for (i = 0; i < (pb_h >> 2); ++i) {
+      __m256i x = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)ref0)),
+                                          _mm_loadu_si128((__m128i *)&ref0[dmvr_stride << 1]), 1);
+      __m256i y = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)ref1)),
+                                          _mm_loadu_si128((__m128i *)&ref1[dmvr_stride << 1]), 1);
 
-    uint8_t idx;
-    uint8_t dmvr_idx = 12;
+      x = _mm256_abs_epi16(_mm256_sub_epi16(x, y));
+      acc = _mm256_add_epi32(acc, _mm256_madd_epi16(x, one));
 
-    for (idx = 0; idx < 12; ++idx) {
-        ref0 = ref0_start + (int16_t)dmvr_mv_x[idx]
-                          + (int16_t)dmvr_mv_y[idx] * stride_l0;
+      ref0 += dmvr_stride << 2;
+      ref1 += dmvr_stride << 2;
+  }
 
-        ref1 = ref1_start - (int16_t)dmvr_mv_x[idx]
-                          - (int16_t)dmvr_mv_y[idx] * stride_l1;
+  sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  sum = _mm_hadd_epi32(sum, sum);
+  sum = _mm_hadd_epi32(sum, sum);
 
-        sad_array[idx] = rcn_dmvr_sad_16(ref0, ref1, stride_l1,
-                                     sb_w, sb_h);
+  return (uint32_t)_mm_cvtsi128_si32(sum);
+}
+
+/* Reduce the five accumulators of a search line into its SADs
+ */
+static inline void
+dmvr_store_sad_line(uint64_t *sad_line, __m256i acc0, __m256i acc1,
+                    __m256i acc2, __m256i acc3, __m256i acc4)
+{
+    int32_t sad[8];
+    __m256i acc01   = _mm256_hadd_epi32(acc0, acc1);
+    __m256i acc23   = _mm256_hadd_epi32(acc2, acc3);
+    __m256i acc44   = _mm256_hadd_epi32(acc4, acc4);
+    __m256i acc0123 = _mm256_hadd_epi32(acc01, acc23);
+
+    acc44 = _mm256_hadd_epi32(acc44, acc44);
+
+    _mm_storeu_si128((__m128i *)&sad[0], _mm_add_epi32(_mm256_castsi256_si128(acc0123),
+                                                       _mm256_extracti128_si256(acc0123, 1)));
+    _mm_storeu_si128((__m128i *)&sad[4], _mm_add_epi32(_mm256_castsi256_si128(acc44),
+                                                       _mm256_extracti128_si256(acc44, 1)));
+
+    sad_line[0] = (uint32_t)sad[0];
+    sad_line[1] = (uint32_t)sad[1];
+    sad_line[2] = (uint32_t)sad[2];
+    sad_line[3] = (uint32_t)sad[3];
+    sad_line[4] = (uint32_t)sad[4];
+}
+
+/* SADs of the five horizontal offsets of search line dy
+ * References are loaded once per line and offset and absolute
+ * differences are accumulated on 32 bits
+ */
+static void
+dmvr_sad_line_16(const uint16_t *ref0, const uint16_t *ref1,
+                 uint64_t *sad_line, int sb_h)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    __m256i acc3 = _mm256_setzero_si256();
+    __m256i acc4 = _mm256_setzero_si256();
+    int i;
+
+    for (i = 0; i < (sb_h >> 1); ++i) {
+        __m256i d0 = _mm256_sub_epi16(_mm256_loadu_si256((__m256i *)&ref0[-2]),
+                                      _mm256_loadu_si256((__m256i *)&ref1[ 2]));
+        __m256i d1 = _mm256_sub_epi16(_mm256_loadu_si256((__m256i *)&ref0[-1]),
+                                      _mm256_loadu_si256((__m256i *)&ref1[ 1]));
+        __m256i d2 = _mm256_sub_epi16(_mm256_loadu_si256((__m256i *)&ref0[ 0]),
+                                      _mm256_loadu_si256((__m256i *)&ref1[ 0]));
+        __m256i d3 = _mm256_sub_epi16(_mm256_loadu_si256((__m256i *)&ref0[ 1]),
+                                      _mm256_loadu_si256((__m256i *)&ref1[-1]));
+        __m256i d4 = _mm256_sub_epi16(_mm256_loadu_si256((__m256i *)&ref0[ 2]),
+                                      _mm256_loadu_si256((__m256i *)&ref1[-2]));
+
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_abs_epi16(d0), one));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_abs_epi16(d1), one));
+        acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_abs_epi16(d2), one));
+        acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_abs_epi16(d3), one));
+        acc4 = _mm256_add_epi32(acc4, _mm256_madd_epi16(_mm256_abs_epi16(d4), one));
+
+        ref0 += DMVR_STRIDE << 1;
+        ref1 += DMVR_STRIDE << 1;
     }
 
-    for (idx = 13; idx < DMVR_NB_IDX; ++idx) {
-        ref0 = ref0_start + (int16_t)dmvr_mv_x[idx]
-                          + (int16_t)dmvr_mv_y[idx] * stride_l0;
+    dmvr_store_sad_line(sad_line, acc0, acc1, acc2, acc3, acc4);
+}
+
+static inline __m256i
+dmvr_load_2x8(const uint16_t *ref)
+{
+    __m128i l0 = _mm_loadu_si128((__m128i *)ref);
+    __m128i l1 = _mm_loadu_si128((__m128i *)&ref[DMVR_STRIDE << 1]);
+
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(l0), l1, 1);
+}
 
-        ref1 = ref1_start - (int16_t)dmvr_mv_x[idx]
-                          - (int16_t)dmvr_mv_y[idx] * stride_l1;
+static void
+dmvr_sad_line_8(const uint16_t *ref0, const uint16_t *ref1,
+                uint64_t *sad_line, int sb_h)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    __m256i acc3 = _mm256_setzero_si256();
+    __m256i acc4 = _mm256_setzero_si256();
+    int i;
 
-        sad_array[idx] = rcn_dmvr_sad_16(ref0, ref1, stride_l1,
-                                     sb_w, sb_h);
+    /* Two sub-sampled lines per register */
+    for (i = 0; i < (sb_h >> 2); ++i) {
+        __m256i d0 = _mm256_sub_epi16(dmvr_load_2x8(&ref0[-2]), dmvr_load_2x8(&ref1[ 2]));
+        __m256i d1 = _mm256_sub_epi16(dmvr_load_2x8(&ref0[-1]), dmvr_load_2x8(&ref1[ 1]));
+        __m256i d2 = _mm256_sub_epi16(dmvr_load_2x8(&ref0[ 0]), dmvr_load_2x8(&ref1[ 0]));
+        __m256i d3 = _mm256_sub_epi16(dmvr_load_2x8(&ref0[ 1]), dmvr_load_2x8(&ref1[-1]));
+        __m256i d4 = _mm256_sub_epi16(dmvr_load_2x8(&ref0[ 2]), dmvr_load_2x8(&ref1[-2]));
+
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_abs_epi16(d0), one));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_abs_epi16(d1), one));
+        acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_abs_epi16(d2), one));
+        acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_abs_epi16(d3), one));
+        acc4 = _mm256_add_epi32(acc4, _mm256_madd_epi16(_mm256_abs_epi16(d4), one));
+
+        ref0 += DMVR_STRIDE << 2;
+        ref1 += DMVR_STRIDE << 2;
     }
+
+    dmvr_store_sad_line(sad_line, acc0, acc1, acc2, acc3, acc4);
+}
+
+static uint8_t
+dmvr_select_min_sad(const uint64_t *sad_array)
+{
+    uint64_t min_cost = (uint64_t) -1;
+    uint8_t dmvr_idx = DMVR_CENTER_IDX;
+    uint8_t idx;
+
     for (idx = 0; idx < DMVR_NB_IDX; ++idx) {
-        if (sad_array[idx] < min_cost || (idx == 12 && sad_array[idx] <= min_cost)) {
+        if (sad_array[idx] < min_cost || (idx == DMVR_CENTER_IDX && sad_array[idx] <= min_cost)) {
             min_cost = sad_array[idx];
             dmvr_idx = idx;
         }
@@ -136,10 +223,63 @@ dmvr_compute_sads_16(const uint16_t *ref0, const uint16_t *ref1,
     return dmvr_idx;
 }
 
+/* Evaluate the 25 DMVR search positions line by line
+ * Center SAD is already set in sad_array and is left untouched
+ */
+static uint8_t
+dmvr_compute_sads_16(const uint16_t *ref0, const uint16_t *ref1,
+                     uint64_t *sad_array, int sb_w, int sb_h)
+{
+    uint64_t sad_line[DMVR_SAD_STRIDE];
+    int dy;
+
+    for (dy = -DMVR_NUM_ITERATION; dy <= DMVR_NUM_ITERATION; ++dy) {
+        uint64_t *sad_dst = &sad_array[(dy + DMVR_NUM_ITERATION) * DMVR_SAD_STRIDE];
+
+        dmvr_sad_line_16(ref0 + dy * DMVR_STRIDE, ref1 - dy * DMVR_STRIDE, sad_line, sb_h);
+
+        sad_dst[0] = sad_line[0];
+        sad_dst[1] = sad_line[1];
+        if (dy) {
+            sad_dst[2] = sad_line[2];
+        }
+        sad_dst[3] = sad_line[3];
+        sad_dst[4] = sad_line[4];
+    }
+
+    return dmvr_select_min_sad(sad_array);
+}
+
+static uint8_t
+dmvr_compute_sads_8(const uint16_t *ref0, const uint16_t *ref1,
+                    uint64_t *sad_array, int sb_w, int sb_h)
+{
+    uint64_t sad_line[DMVR_SAD_STRIDE];
+    int dy;
+
+    for (dy = -DMVR_NUM_ITERATION; dy <= DMVR_NUM_ITERATION; ++dy) {
+        uint64_t *sad_dst = &sad_array[(dy + DMVR_NUM_ITERATION) * DMVR_SAD_STRIDE];
+
+        dmvr_sad_line_8(ref0 + dy * DMVR_STRIDE, ref1 - dy * DMVR_STRIDE, sad_line, sb_h);
+
+        sad_dst[0] = sad_line[0];
+        sad_dst[1] = sad_line[1];
+        if (dy) {
+            sad_dst[2] = sad_line[2];
+        }
+        sad_dst[3] = sad_line[3];
+        sad_dst[4] = sad_line[4];
+    }
+
+    return dmvr_select_min_sad(sad_array);
+}
+
 void
 rcn_init_dmvr_functions_avx2(struct RCNFunctions *const rcn_funcs)
 {
+    rcn_funcs->dmvr.sad[0] = &rcn_dmvr_sad_8;
     rcn_funcs->dmvr.sad[1] = &rcn_dmvr_sad_16;
 
+    rcn_funcs->dmvr.computeSB[0] = &dmvr_compute_sads_8;
     rcn_funcs->dmvr.computeSB[1] = &dmvr_compute_sads_16;
 }
@@ -0,0 +1,225 @@
+/**
+ *
+ *   OpenVVC is open-source real time software decoder compliant with the 
+ *   ITU-T H.266- MPEG-I - Part 3 VVC standard. OpenVVC is developed from 
+ *   scratch in C as a library that provides consumers with real time and
+ *   energy-aware decoding capabilities under different OS including MAC OS,
+ *   Windows, Linux and Android targeting low energy real-time decoding of
+ *   4K VVC videos on Intel x86 and ARM platforms.
+ * 
+ *   Copyright (C) 2020-2022  IETR-INSA Rennes :
+ *   
+ *   Pierre-Loup CABARAT
+ *   Wassim HAMIDOUCHE
+ *   Guillaume GAUTIER
+ *   Thomas AMESTOY
+ *
+ *   This library is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   This library is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *   USA
+ * 
+ **/
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "ovutils.h"
+#include "rcn_structures.h"
+#include "ctudec.h"
+
+#define CLIP_10 ((1 << 10) - 1)
+
+/* Luma down sampling filter on sums of the two luma rows.
+ * Each 32-bit output is s[2k - 1] + 2 * s[2k] + s[2k + 1]
+ * with s_m1 being s shifted by one sample on the left.
+ */
+static inline __m256i
+lm_filter(__m256i s, __m256i s_m1)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    __m256i t = _mm256_add_epi32(_mm256_madd_epi16(s, one),
+                                 _mm256_madd_epi16(s_m1, one));
+
+    t = _mm256_add_epi32(t, _mm256_set1_epi32(4));
+
+    return _mm256_srai_epi32(t, 3);
+}
+
+/* Eight down sampled values from 16 luma samples of a chroma row */
+static inline __m256i
+lm_subsample_8(const uint16_t *lm_src, ptrdiff_t stride, uint8_t pad_left)
+{
+    __m256i x0 = _mm256_loadu_si256((__m256i *)&lm_src[0]);
+    __m256i x1 = _mm256_loadu_si256((__m256i *)&lm_src[stride]);
+    __m256i s  = _mm256_add_epi16(x0, x1);
+    __m256i s_m1;
+
+    if (pad_left) {
+        const __m256i first_msk = _mm256_setr_epi16(-1, 0, 0, 0, 0, 0, 0, 0,
+                                                      0, 0, 0, 0, 0, 0, 0, 0);
+        __m256i s_lo = _mm256_permute2x128_si256(s, s, 0x08);
+        s_m1 = _mm256_alignr_epi8(s, s_lo, 14);
+        s_m1 = _mm256_or_si256(s_m1, _mm256_and_si256(s, first_msk));
+    } else {
+        __m256i y0 = _mm256_loadu_si256((__m256i *)&lm_src[-1]);
+        __m256i y1 = _mm256_loadu_si256((__m256i *)&lm_src[stride - 1]);
+        s_m1 = _mm256_add_epi16(y0, y1);
+    }
+
+    return lm_filter(s, s_m1);
+}
+
+/* Four down sampled values for two consecutive chroma rows,
+ * one row per 128-bit lane
+ */
+static inline __m256i
+lm_subsample_4x2(const uint16_t *lm_src, ptrdiff_t stride, uint8_t pad_left)
+{
+    ptrdiff_t stride2 = stride << 1;
+    __m256i x0 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)&lm_src[0])),
+                                         _mm_loadu_si128((__m128i *)&lm_src[stride2]), 1);
+    __m256i x1 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)&lm_src[stride])),
+                                         _mm_loadu_si128((__m128i *)&lm_src[stride2 + stride]), 1);
+    __m256i s  = _mm256_add_epi16(x0, x1);
+    __m256i s_m1;
+
+    if (pad_left) {
+        s_m1 = _mm256_blend_epi16(_mm256_slli_si256(s, 2), s, 0x01);
+    } else {
+        __m256i y0 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)&lm_src[-1])),
+                                             _mm_loadu_si128((__m128i *)&lm_src[stride2 - 1]), 1);
+        __m256i y1 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)&lm_src[stride - 1])),
+                                             _mm_loadu_si128((__m128i *)&lm_src[stride2 + stride - 1]), 1);
+        s_m1 = _mm256_add_epi16(y0, y1);
+    }
+
+    return lm_filter(s, s_m1);
+}
+
+/* Apply linear model to two groups of eight down sampled values
+ * Result holds the first group in low lane and the second one in high lane
+ */
+static inline __m256i
+lm_linear(__m256i t_a, __m256i t_b, __m256i scale, int shift, __m256i offset)
+{
+    __m256i r_a = _mm256_srai_epi32(_mm256_mullo_epi32(t_a, scale), shift);
+    __m256i r_b = _mm256_srai_epi32(_mm256_mullo_epi32(t_b, scale), shift);
+    __m256i r;
+
+    r_a = _mm256_add_epi32(r_a, offset);
+    r_b = _mm256_add_epi32(r_b, offset);
+
+    r = _mm256_packs_epi32(r_a, r_b);
+
+    r = _mm256_max_epi16(r, _mm256_setzero_si256());
+    r = _mm256_min_epi16(r, _mm256_set1_epi16(CLIP_10));
+
+    return _mm256_permute4x64_epi64(r, 0xD8);
+}
+
+static void
+compute_lm_subsample_avx2(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *dst_cr,
+                          ptrdiff_t lm_src_stride, ptrdiff_t dst_stride_c,
+                          const struct CCLMParams *const lm_params,
+                          int pb_w, int pb_h, uint8_t lft_avail)
+{
+    int i, j;
+    ptrdiff_t lm_src_stride2 = lm_src_stride << 1;
+    const __m256i scale_cb  = _mm256_set1_epi32(lm_params->cb.a);
+    const __m256i offset_cb = _mm256_set1_epi32(lm_params->cb.b);
+    const __m256i scale_cr  = _mm256_set1_epi32(lm_params->cr.a);
+    const __m256i offset_cr = _mm256_set1_epi32(lm_params->cr.b);
+    const int shift_cb = lm_params->cb.shift;
+    const int shift_cr = lm_params->cr.shift;
+    uint8_t pad_left = !lft_avail;
+
+    if (pb_w == 4) {
+        /* Four chroma rows per iteration */
+        for (j = 0; j < pb_h; j += 4) {
+            uint8_t has_b = j + 2 < pb_h;
+            __m256i t_a = lm_subsample_4x2(lm_src, lm_src_stride, pad_left);
+            __m256i t_b = has_b ? lm_subsample_4x2(lm_src + (lm_src_stride2 << 1), lm_src_stride, pad_left)
+                                : t_a;
+
+            __m256i cb = lm_linear(t_a, t_b, scale_cb, shift_cb, offset_cb);
+            __m256i cr = lm_linear(t_a, t_b, scale_cr, shift_cr, offset_cr);
+
+            __m128i cb_a = _mm256_castsi256_si128(cb);
+            __m128i cr_a = _mm256_castsi256_si128(cr);
+
+            _mm_storel_epi64((__m128i *)&dst_cb[0], cb_a);
+            _mm_storel_epi64((__m128i *)&dst_cr[0], cr_a);
+            _mm_storel_epi64((__m128i *)&dst_cb[dst_stride_c], _mm_srli_si128(cb_a, 8));
+            _mm_storel_epi64((__m128i *)&dst_cr[dst_stride_c], _mm_srli_si128(cr_a, 8));
+
+            if (has_b) {
+                __m128i cb_b = _mm256_extracti128_si256(cb, 1);
+                __m128i cr_b = _mm256_extracti128_si256(cr, 1);
+                _mm_storel_epi64((__m128i *)&dst_cb[2 * dst_stride_c], cb_b);
+                _mm_storel_epi64((__m128i *)&dst_cr[2 * dst_stride_c], cr_b);
+                _mm_storel_epi64((__m128i *)&dst_cb[3 * dst_stride_c], _mm_srli_si128(cb_b, 8));
+                _mm_storel_epi64((__m128i *)&dst_cr[3 * dst_stride_c], _mm_srli_si128(cr_b, 8));
+            }
+
+            dst_cb += dst_stride_c << 2;
+            dst_cr += dst_stride_c << 2;
+            lm_src += lm_src_stride2 << 2;
+        }
+    } else if (pb_w == 8) {
+        /* Two chroma rows per iteration */
+        for (j = 0; j < pb_h; j += 2) {
+            __m256i t_a = lm_subsample_8(lm_src, lm_src_stride, pad_left);
+            __m256i t_b = lm_subsample_8(lm_src + lm_src_stride2, lm_src_stride, pad_left);
+
+            __m256i cb = lm_linear(t_a, t_b, scale_cb, shift_cb, offset_cb);
+            __m256i cr = lm_linear(t_a, t_b, scale_cr, shift_cr, offset_cr);
+
+            _mm_storeu_si128((__m128i *)&dst_cb[0], _mm256_castsi256_si128(cb));
+            _mm_storeu_si128((__m128i *)&dst_cr[0], _mm256_castsi256_si128(cr));
+            _mm_storeu_si128((__m128i *)&dst_cb[dst_stride_c], _mm256_extracti128_si256(cb, 1));
+            _mm_storeu_si128((__m128i *)&dst_cr[dst_stride_c], _mm256_extracti128_si256(cr, 1));
+
+            dst_cb += dst_stride_c << 1;
+            dst_cr += dst_stride_c << 1;
+            lm_src += lm_src_stride2 << 1;
+        }
+    } else {
+        for (j = 0; j < pb_h; j++) {
+            for (i = 0; i < pb_w; i += 16) {
+                uint8_t pad = pad_left && !i;
+                __m256i t_a = lm_subsample_8(&lm_src[2 * i], lm_src_stride, pad);
+                __m256i t_b = lm_subsample_8(&lm_src[2 * i + 16], lm_src_stride, 0);
+
+                __m256i cb = lm_linear(t_a, t_b, scale_cb, shift_cb, offset_cb);
+                __m256i cr = lm_linear(t_a, t_b, scale_cr, shift_cr, offset_cr);
+
+                _mm256_storeu_si256((__m256i *)&dst_cb[i], cb);
+                _mm256_storeu_si256((__m256i *)&dst_cr[i], cr);
+            }
+            dst_cb += dst_stride_c;
+            dst_cr += dst_stride_c;
+            lm_src += lm_src_stride2;
+        }
+    }
+}
+
+void
+rcn_init_cclm_functions_avx2(struct RCNFunctions *rcn_func)
+{
+   struct CCLMFunctions *const cclm = &rcn_func->cclm;
+   cclm->compute_subsample = &compute_lm_subsample_avx2;
+}
@@ -0,0 +1,267 @@
+/**
+ *
+ *   OpenVVC is open-source real time software decoder compliant with the 
+ *   ITU-T H.266- MPEG-I - Part 3 VVC standard. OpenVVC is developed from 
+ *   scratch in C as a library that provides consumers with real time and
+ *   energy-aware decoding capabilities under different OS including MAC OS,
+ *   Windows, Linux and Android targeting low energy real-time decoding of
+ *   4K VVC videos on Intel x86 and ARM platforms.
+ * 
+ *   Copyright (C) 2020-2022  IETR-INSA Rennes :
+ *   
+ *   Pierre-Loup CABARAT
+ *   Wassim HAMIDOUCHE
+ *   Guillaume GAUTIER
+ *   Thomas AMESTOY
+ *
+ *   This library is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   This library is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *   USA
+ * 
+ **/
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "ovutils.h"
+#include "rcn_structures.h"
+
+/* Only widths of 16 samples or more are handled here, narrower blocks
+ * keep using SSE functions.
+ * PDPC weights are zero past the 12th sample, so only the first 16 columns
+ * and the first lines need PDPC.
+ */
+static const uint8_t vvc_pdpc_w[3][16] = {
+{32,  8,  2,  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+{32, 16,  8,  4, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+{32, 32, 16, 16, 8, 8, 4, 4, 2, 2, 1, 1, 0, 0, 0, 0},
+};
+
+/* Number of non zero weights per PDPC scale */
+static const uint8_t vvc_pdpc_len[3] = {3, 6, 12};
+
+static inline __m256i
+load_pdpc_w(int pdpc_scale)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)vvc_pdpc_w[pdpc_scale]));
+}
+
+/* Sum of nb_smp (multiple of 16) reference samples */
+static inline uint32_t
+sum_ref_avx2(const uint16_t *ref, int nb_smp)
+{
+    __m256i acc = _mm256_setzero_si256();
+    __m128i sum;
+
+    for (int i = 0; i < nb_smp; i += 16) {
+        __m256i x = _mm256_loadu_si256((__m256i *)&ref[i]);
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(x, _mm256_set1_epi16(1)));
+    }
+
+    sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_hadd_epi32(sum, sum);
+    sum = _mm_hadd_epi32(sum, sum);
+
+    return _mm_cvtsi128_si32(sum);
+}
+
+/* PDPC on 16 samples of value val.
+ * Weights sum to 64 and samples are 10 bits so that
+ * the weighted sum fits in unsigned 16 bits
+ */
+static inline __m256i
+pdpc_16(__m256i val, __m256i x_w, __m256i l_v, __m256i y_w, __m256i t_v)
+{
+    __m256i sum = _mm256_add_epi16(_mm256_slli_epi16(val, 6), _mm256_set1_epi16(32));
+    sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(x_w, _mm256_sub_epi16(l_v, val)));
+    sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(y_w, _mm256_sub_epi16(t_v, val)));
+
+    return _mm256_srli_epi16(sum, 6);
+}
+
+/* PDPC on 16 samples from left reference only */
+static inline __m256i
+pdpc_16_x(__m256i val, __m256i x_w, __m256i l_v)
+{
+    __m256i sum = _mm256_add_epi16(_mm256_slli_epi16(val, 6), _mm256_set1_epi16(32));
+    sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(x_w, _mm256_sub_epi16(l_v, val)));
+
+    return _mm256_srli_epi16(sum, 6);
+}
+
+static void
+intra_dc_pdpc_avx2(const uint16_t *const src_above,
+                   const uint16_t *const src_left,
+                   uint16_t *const dst, ptrdiff_t dst_stride,
+                   int log2_pb_w, int log2_pb_h)
+{
+    uint16_t *_dst = dst;
+    const int shift  = OVMAX(log2_pb_w, log2_pb_h) + (log2_pb_w == log2_pb_h);
+    const int offset = ((1 << shift) >> 1);
+    const int pdpc_scale = (log2_pb_w + log2_pb_h - 2) >> 2;
+    const uint8_t *pdpc_w = vvc_pdpc_w[pdpc_scale];
+    const int pb_w = 1 << log2_pb_w;
+    const int pb_h = 1 << log2_pb_h;
+    const int nb_pdpc_rows = OVMIN(vvc_pdpc_len[pdpc_scale], pb_h);
+    uint32_t dc_val = 0;
+    int x, y;
+
+    if (log2_pb_w >= log2_pb_h) {
+        dc_val += sum_ref_avx2(&src_above[1], pb_w);
+    }
+
+    if (log2_pb_w <= log2_pb_h) {
+        dc_val += sum_ref_avx2(&src_left[1], pb_h);
+    }
+
+    dc_val = (dc_val + offset) >> shift;
+
+    const __m256i dc_v  = _mm256_set1_epi16(dc_val);
+    const __m256i dc_64 = _mm256_set1_epi16((dc_val << 6) + 32);
+    const __m256i x_w   = load_pdpc_w(pdpc_scale);
+
+    /* (64 - x_w) * dc + 32 on first columns */
+    const __m256i x_base = _mm256_sub_epi16(dc_64, _mm256_mullo_epi16(x_w, dc_v));
+
+    for (y = 0; y < nb_pdpc_rows; ++y) {
+        __m256i l_v = _mm256_set1_epi16(src_left[y + 1]);
+        __m256i y_w = _mm256_set1_epi16(pdpc_w[y]);
+        __m256i t_v = _mm256_loadu_si256((__m256i *)&src_above[1]);
+        __m256i sum = _mm256_add_epi16(x_base, _mm256_mullo_epi16(x_w, l_v));
+
+        sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(y_w, _mm256_sub_epi16(t_v, dc_v)));
+
+        _mm256_storeu_si256((__m256i *)&_dst[0], _mm256_srli_epi16(sum, 6));
+
+        for (x = 16; x < pb_w; x += 16) {
+            t_v = _mm256_loadu_si256((__m256i *)&src_above[x + 1]);
+            sum = _mm256_add_epi16(dc_64, _mm256_mullo_epi16(y_w, _mm256_sub_epi16(t_v, dc_v)));
+            _mm256_storeu_si256((__m256i *)&_dst[x], _mm256_srli_epi16(sum, 6));
+        }
+        _dst += dst_stride;
+    }
+
+    for (; y < pb_h; ++y) {
+        __m256i l_v = _mm256_set1_epi16(src_left[y + 1]);
+        __m256i sum = _mm256_add_epi16(x_base, _mm256_mullo_epi16(x_w, l_v));
+
+        _mm256_storeu_si256((__m256i *)&_dst[0], _mm256_srli_epi16(sum, 6));
+
+        for (x = 16; x < pb_w; x += 16) {
+            _mm256_storeu_si256((__m256i *)&_dst[x], dc_v);
+        }
+        _dst += dst_stride;
+    }
+}
+
+/* Planar prediction is expressed as
+ *   ((W - 1 - x) * l + (x + 1) * tr) << log2_h
+ * + ((H * t) << log2_w) + (((y + 1) * (bl - t)) << log2_w)
+ * The horizontal term is obtained from a madd on (l, tr) pairs with
+ * per column weights while the vertical one is accumulated line by line.
+ * Blocks are processed by 16 columns wide strips so that the whole
+ * state of a strip stays in registers.
+ */
+static void
+intra_planar_pdpc_avx2(const uint16_t *const src_above,
+                       const uint16_t *const src_left,
+                       uint16_t *const dst, ptrdiff_t dst_stride,
+                       int log2_pb_w, int log2_pb_h)
+{
+    const int pb_w = 1 << log2_pb_w;
+    const int pb_h = 1 << log2_pb_h;
+    const int w_scale = OVMAX(1, log2_pb_w);
+    const int h_scale = OVMAX(1, log2_pb_h);
+    const int s_shift = w_scale + h_scale + 1;
+    const int pdpc_scale = (log2_pb_w + log2_pb_h - 2) >> 2;
+    const uint8_t *pdpc_w = vvc_pdpc_w[pdpc_scale];
+    const uint32_t bl_val = src_left[pb_h + 1];
+    const uint32_t tr_val = src_above[pb_w + 1];
+    const int nb_pdpc_rows = OVMIN(vvc_pdpc_len[pdpc_scale], pb_h);
+    const __m256i offset = _mm256_set1_epi32(1 << (w_scale + h_scale));
+    const __m256i bl_v = _mm256_set1_epi32(bl_val);
+    const __m256i z = _mm256_setzero_si256();
+    int x, y;
+
+    for (x = 0; x < pb_w; x += 16) {
+        uint16_t *_dst = &dst[x];
+        __m256i x_p1 = _mm256_setr_epi16(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+        __m256i w_m_x_m1, x_coeff_lo, x_coeff_hi;
+        __m256i t_v, t_lo, t_hi, ver_lo, ver_hi, d_lo, d_hi;
+        __m256i x_w = x ? z : load_pdpc_w(pdpc_scale);
+
+        x_p1 = _mm256_add_epi16(x_p1, _mm256_set1_epi16(x));
+        w_m_x_m1 = _mm256_sub_epi16(_mm256_set1_epi16(pb_w), x_p1);
+
+        /* Weights of (l, tr) pairs including the vertical scale */
+        x_p1     = _mm256_slli_epi16(x_p1, h_scale);
+        w_m_x_m1 = _mm256_slli_epi16(w_m_x_m1, h_scale);
+
+        x_coeff_lo = _mm256_unpacklo_epi16(w_m_x_m1, x_p1);
+        x_coeff_hi = _mm256_unpackhi_epi16(w_m_x_m1, x_p1);
+
+        t_v  = _mm256_loadu_si256((__m256i *)&src_above[x + 1]);
+        t_lo = _mm256_unpacklo_epi16(t_v, z);
+        t_hi = _mm256_unpackhi_epi16(t_v, z);
+
+        ver_lo = _mm256_add_epi32(_mm256_slli_epi32(t_lo, w_scale + h_scale), offset);
+        ver_hi = _mm256_add_epi32(_mm256_slli_epi32(t_hi, w_scale + h_scale), offset);
+
+        d_lo = _mm256_slli_epi32(_mm256_sub_epi32(bl_v, t_lo), w_scale);
+        d_hi = _mm256_slli_epi32(_mm256_sub_epi32(bl_v, t_hi), w_scale);
+
+        for (y = 0; y < pb_h; ++y) {
+            uint32_t l_val = src_left[y + 1];
+            __m256i l_tr = _mm256_set1_epi32(l_val | (tr_val << 16));
+            __m256i val_lo = _mm256_madd_epi16(x_coeff_lo, l_tr);
+            __m256i val_hi = _mm256_madd_epi16(x_coeff_hi, l_tr);
+            __m256i val;
+
+            ver_lo = _mm256_add_epi32(ver_lo, d_lo);
+            ver_hi = _mm256_add_epi32(ver_hi, d_hi);
+
+            val_lo = _mm256_srli_epi32(_mm256_add_epi32(val_lo, ver_lo), s_shift);
+            val_hi = _mm256_srli_epi32(_mm256_add_epi32(val_hi, ver_hi), s_shift);
+
+            val = _mm256_packus_epi32(val_lo, val_hi);
+
+            if (y < nb_pdpc_rows) {
+                __m256i y_w = _mm256_set1_epi16(pdpc_w[y]);
+                __m256i l_v = _mm256_set1_epi16(l_val);
+                val = pdpc_16(val, x_w, l_v, y_w, t_v);
+            } else if (!x) {
+                __m256i l_v = _mm256_set1_epi16(l_val);
+                val = pdpc_16_x(val, x_w, l_v);
+            }
+
+            _mm256_storeu_si256((__m256i *)_dst, val);
+            _dst += dst_stride;
+        }
+    }
+}
+
+void
+rcn_init_dc_planar_functions_avx2(struct RCNFunctions *const rcn_funcs)
+{
+    /* Widths from 16 to 64 */
+    for (int i = 2; i < 5; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            rcn_funcs->dc.pdpc[i][j]     = &intra_dc_pdpc_avx2;
+            rcn_funcs->planar.pdpc[i][j] = &intra_planar_pdpc_avx2;
+        }
+    }
+}
@@ -0,0 +1,272 @@
+/**
+ *
+ *   OpenVVC is open-source real time software decoder compliant with the 
+ *   ITU-T H.266- MPEG-I - Part 3 VVC standard. OpenVVC is developed from 
+ *   scratch in C as a library that provides consumers with real time and
+ *   energy-aware decoding capabilities under different OS including MAC OS,
+ *   Windows, Linux and Android targeting low energy real-time decoding of
+ *   4K VVC videos on Intel x86 and ARM platforms.
+ * 
+ *   Copyright (C) 2020-2022  IETR-INSA Rennes :
+ *   
+ *   Pierre-Loup CABARAT
+ *   Wassim HAMIDOUCHE
+ *   Guillaume GAUTIER
+ *   Thomas AMESTOY
+ *
+ *   This library is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   This library is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *   USA
+ * 
+ **/
+
+
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "ovutils.h"
+#include "rcn_structures.h"
+
+/* Scaled and rounded outputs of two accumulators of eight outputs
+ * First accumulator is returned in low lane, second in high lane
+ */
+static inline __m256i
+lfnst_round_pack(__m256i acc_lo, __m256i acc_hi)
+{
+    const __m256i rnd = _mm256_set1_epi32(64);
+    __m256i r;
+
+    acc_lo = _mm256_srai_epi32(_mm256_add_epi32(acc_lo, rnd), 7);
+    acc_hi = _mm256_srai_epi32(_mm256_add_epi32(acc_hi, rnd), 7);
+
+    r = _mm256_packs_epi32(acc_lo, acc_hi);
+
+    return _mm256_permute4x64_epi64(r, 0xD8);
+}
+
+/* Accumulate the contribution of two consecutive input coefficients
+ * on 16 outputs. Matrix rows are interleaved so that each 32-bit
+ * lane holds the pair of weights multiplied by the input pair.
+ */
+static inline void
+lfnst_madd_16(__m256i *acc, __m256i x, const int8_t *row0, const int8_t *row1)
+{
+    __m128i c0 = _mm_loadu_si128((__m128i *)row0);
+    __m128i c1 = _mm_loadu_si128((__m128i *)row1);
+    __m256i w_lo = _mm256_cvtepi8_epi16(_mm_unpacklo_epi8(c0, c1));
+    __m256i w_hi = _mm256_cvtepi8_epi16(_mm_unpackhi_epi8(c0, c1));
+
+    acc[0] = _mm256_add_epi32(acc[0], _mm256_madd_epi16(x, w_lo));
+    acc[1] = _mm256_add_epi32(acc[1], _mm256_madd_epi16(x, w_hi));
+}
+
+static inline void
+lfnst_load_input(const int16_t *const src, int16_t *tmp)
+{
+    uint64_t scan_map = 0xfbe7ad369c258140;
+
+    for (int i = 0; i < 16; ++i) {
+        tmp[i] = src[scan_map & 0xF];
+        scan_map >>= 4;
+    }
+}
+
+/* 16 outputs from 8 or 16 inputs */
+static inline __m256i
+lfnst_4x4(const int16_t *tmp, const int8_t *const lfnst_matrix, int nb_pairs)
+{
+    const int32_t *src_pairs = (const int32_t *)tmp;
+    __m256i acc[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+
+    for (int k = 0; k < nb_pairs; ++k) {
+        __m256i x = _mm256_set1_epi32(src_pairs[k]);
+        lfnst_madd_16(acc, x, &lfnst_matrix[(2 * k) * 16], &lfnst_matrix[(2 * k + 1) * 16]);
+    }
+
+    return lfnst_round_pack(acc[0], acc[1]);
+}
+
+/* 48 outputs from 16 inputs */
+static inline void
+lfnst_8x8(const int16_t *tmp, __m256i *r, const int8_t *const lfnst_matrix)
+{
+    const int32_t *src_pairs = (const int32_t *)tmp;
+    __m256i acc[6];
+
+    for (int i = 0; i < 6; ++i) {
+        acc[i] = _mm256_setzero_si256();
+    }
+
+    for (int k = 0; k < 8; ++k) {
+        __m256i x = _mm256_set1_epi32(src_pairs[k]);
+        const int8_t *row0 = &lfnst_matrix[(2 * k) * 48];
+        const int8_t *row1 = &lfnst_matrix[(2 * k + 1) * 48];
+
+        lfnst_madd_16(&acc[0], x, &row0[0],  &row1[0]);
+        lfnst_madd_16(&acc[2], x, &row0[16], &row1[16]);
+        lfnst_madd_16(&acc[4], x, &row0[32], &row1[32]);
+    }
+
+    r[0] = lfnst_round_pack(acc[0], acc[1]);
+    r[1] = lfnst_round_pack(acc[2], acc[3]);
+    r[2] = lfnst_round_pack(acc[4], acc[5]);
+}
+
+static void
+compute_lfnst_4x4_avx2(const int16_t* const src, int16_t* const dst,
+                       const int8_t* const lfnst_matrix, int log2_tb_w,
+                       int log2_tb_h)
+{
+    const __m128i z = _mm_setzero_si128();
+    int16_t tmp[16];
+    __m128i r[2];
+    __m256i x;
+
+    lfnst_load_input(src, tmp);
+
+    x = lfnst_4x4(tmp, lfnst_matrix, log2_tb_w == log2_tb_h ? 4 : 8);
+
+    r[0] = _mm256_castsi256_si128(x);
+    r[1] = _mm256_extracti128_si256(x, 1);
+
+    _mm_storeu_si128((__m128i*) &dst[0 << log2_tb_w], _mm_unpacklo_epi64(r[0], z));
+    _mm_storeu_si128((__m128i*) &dst[1 << log2_tb_w], _mm_bsrli_si128(r[0], 8));
+    _mm_storeu_si128((__m128i*) &dst[2 << log2_tb_w], _mm_unpacklo_epi64(r[1], z));
+    _mm_storeu_si128((__m128i*) &dst[3 << log2_tb_w], _mm_bsrli_si128(r[1], 8));
+}
+
+static void
+compute_lfnst_8x8_avx2(const int16_t* const src, int16_t* const dst,
+                       const int8_t* const lfnst_matrix, int log2_tb_w,
+                       int log2_tb_h)
+{
+    const __m128i z = _mm_setzero_si128();
+    int16_t tmp[16];
+    __m256i x[3];
+    __m128i r;
+
+    lfnst_load_input(src, tmp);
+
+    lfnst_8x8(tmp, x, lfnst_matrix);
+
+    _mm_store_si128((__m128i *) &dst[0 << log2_tb_w], _mm256_castsi256_si128(x[0]));
+    _mm_store_si128((__m128i *) &dst[1 << log2_tb_w], _mm256_extracti128_si256(x[0], 1));
+    _mm_store_si128((__m128i *) &dst[2 << log2_tb_w], _mm256_castsi256_si128(x[1]));
+    _mm_store_si128((__m128i *) &dst[3 << log2_tb_w], _mm256_extracti128_si256(x[1], 1));
+
+    r = _mm256_castsi256_si128(x[2]);
+    _mm_store_si128((__m128i*) &dst[4 << log2_tb_w], _mm_unpacklo_epi64(r, z));
+    _mm_store_si128((__m128i*) &dst[5 << log2_tb_w], _mm_bsrli_si128(r, 8));
+
+    r = _mm256_extracti128_si256(x[2], 1);
+    _mm_store_si128((__m128i*) &dst[6 << log2_tb_w], _mm_unpacklo_epi64(r, z));
+    _mm_store_si128((__m128i*) &dst[7 << log2_tb_w], _mm_bsrli_si128(r, 8));
+}
+
+static void
+compute_lfnst_4x4_tr_avx2(const int16_t* const src, int16_t* const dst,
+                          const int8_t* const lfnst_matrix, int log2_tb_w,
+                          int log2_tb_h)
+{
+    const __m128i z = _mm_setzero_si128();
+    int16_t tmp[16];
+    __m128i r[2], t[2];
+    __m256i x;
+
+    lfnst_load_input(src, tmp);
+
+    x = lfnst_4x4(tmp, lfnst_matrix, log2_tb_w == log2_tb_h ? 4 : 8);
+
+    r[0] = _mm256_castsi256_si128(x);
+    r[1] = _mm256_extracti128_si256(x, 1);
+
+    t[0] = _mm_unpacklo_epi16(r[0], r[1]);
+    t[1] = _mm_unpackhi_epi16(r[0], r[1]);
+
+    r[0] = _mm_unpacklo_epi32(t[0], t[1]);
+    r[1] = _mm_unpackhi_epi32(t[0], t[1]);
+
+    r[0] = _mm_shufflelo_epi16(r[0], 0xD8);
+    r[0] = _mm_shufflehi_epi16(r[0], 0xD8);
+    r[1] = _mm_shufflelo_epi16(r[1], 0xD8);
+    r[1] = _mm_shufflehi_epi16(r[1], 0xD8);
+
+    _mm_storeu_si128((__m128i*) &dst[0 << log2_tb_w], _mm_unpacklo_epi64(r[0], z));
+    _mm_storeu_si128((__m128i*) &dst[1 << log2_tb_w], _mm_bsrli_si128(r[0], 8));
+    _mm_storeu_si128((__m128i*) &dst[2 << log2_tb_w], _mm_unpacklo_epi64(r[1], z));
+    _mm_storeu_si128((__m128i*) &dst[3 << log2_tb_w], _mm_bsrli_si128(r[1], 8));
+}
+
+static void
+compute_lfnst_8x8_tr_avx2(const int16_t* const src, int16_t* const dst,
+                          const int8_t* const lfnst_matrix, int log2_tb_w,
+                          int log2_tb_h)
+{
+    const __m128i z = _mm_setzero_si128();
+    int16_t tmp[16];
+    __m128i r[6], t[4];
+    __m256i x[3];
+
+    lfnst_load_input(src, tmp);
+
+    lfnst_8x8(tmp, x, lfnst_matrix);
+
+    r[0] = _mm256_castsi256_si128(x[0]);
+    r[1] = _mm256_extracti128_si256(x[0], 1);
+    r[2] = _mm256_castsi256_si128(x[1]);
+    r[3] = _mm256_extracti128_si256(x[1], 1);
+    r[4] = _mm256_castsi256_si128(x[2]);
+    r[5] = _mm256_extracti128_si256(x[2], 1);
+
+    t[0] = _mm_unpacklo_epi16(r[0], r[1]);
+    t[1] = _mm_unpackhi_epi16(r[0], r[1]);
+    t[2] = _mm_unpacklo_epi16(r[2], r[3]);
+    t[3] = _mm_unpackhi_epi16(r[2], r[3]);
+
+    r[0] = _mm_unpacklo_epi32(t[0], t[2]);
+    r[1] = _mm_unpackhi_epi32(t[0], t[2]);
+    r[2] = _mm_unpacklo_epi32(t[1], t[3]);
+    r[3] = _mm_unpackhi_epi32(t[1], t[3]);
+
+    t[0] = _mm_unpacklo_epi16(r[4], r[5]);
+    t[1] = _mm_unpackhi_epi16(r[4], r[5]);
+
+    r[4] = _mm_unpacklo_epi32(t[0], t[1]);
+    r[5] = _mm_unpackhi_epi32(t[0], t[1]);
+
+    r[4] = _mm_shufflelo_epi16(r[4], 0xD8);
+    r[4] = _mm_shufflehi_epi16(r[4], 0xD8);
+    r[5] = _mm_shufflelo_epi16(r[5], 0xD8);
+    r[5] = _mm_shufflehi_epi16(r[5], 0xD8);
+
+    _mm_store_si128((__m128i*) &dst[(0 << log2_tb_w)], _mm_unpacklo_epi64(r[0], r[4]));
+    _mm_store_si128((__m128i*) &dst[(1 << log2_tb_w)], _mm_unpackhi_epi64(r[0], r[4]));
+    _mm_store_si128((__m128i*) &dst[(2 << log2_tb_w)], _mm_unpacklo_epi64(r[1], r[5]));
+    _mm_store_si128((__m128i*) &dst[(3 << log2_tb_w)], _mm_unpackhi_epi64(r[1], r[5]));
+
+    _mm_store_si128((__m128i*) &dst[4 << log2_tb_w], _mm_unpacklo_epi64(r[2], z));
+    _mm_store_si128((__m128i*) &dst[5 << log2_tb_w], _mm_bsrli_si128(r[2], 8));
+    _mm_store_si128((__m128i*) &dst[6 << log2_tb_w], _mm_unpacklo_epi64(r[3], z));
+    _mm_store_si128((__m128i*) &dst[7 << log2_tb_w], _mm_bsrli_si128(r[3], 8));
+}
+
+void
+rcn_init_lfnst_functions_avx2(struct RCNFunctions *rcn_func)
+{
+    rcn_func->lfnst.func[0][0] = &compute_lfnst_4x4_avx2;
+    rcn_func->lfnst.func[0][1] = &compute_lfnst_8x8_avx2;
+    rcn_func->lfnst.func[1][0] = &compute_lfnst_4x4_tr_avx2;
+    rcn_func->lfnst.func[1][1] = &compute_lfnst_8x8_tr_avx2;
+}
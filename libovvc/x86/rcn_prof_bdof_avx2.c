@@ -49,6 +49,8 @@
 #define BDOF_SHIFT   (14 + 1 - BITDEPTH)
 #define BDOF_OFFSET  ((1 << (BDOF_SHIFT - 1)))
 
+#define BDOF_WGT_LIMIT ((1 << 4) - 1)
+
 static void
 compute_prof_grad_4_avx2(const uint16_t* src, int src_stride, int sb_w, int sb_h,
                   int grad_stride, int16_t* grad_x, int16_t* grad_y)
@@ -160,6 +162,235 @@ compute_prof_grad_avx2(const int16_t* src, int src_stride, int sb_w, int sb_h,
     }
 }
 
+/* Horizontal and vertical gradients of a 16 samples line
+ * Note ((a - (1 << 13)) >> 6) - ((b - (1 << 13)) >> 6) == (a >> 6) - (b >> 6)
+ */
+static inline void
+bdof_grad_line_avx2(const int16_t *src, int src_stride, __m256i *grad_x, __m256i *grad_y)
+{
+    __m256i l = _mm256_loadu_si256((__m256i *)&src[-1]);
+    __m256i r = _mm256_loadu_si256((__m256i *)&src[ 1]);
+    __m256i u = _mm256_loadu_si256((__m256i *)&src[-src_stride]);
+    __m256i d = _mm256_loadu_si256((__m256i *)&src[ src_stride]);
+
+    *grad_x = _mm256_sub_epi16(_mm256_srai_epi16(r, GRAD_SHIFT), _mm256_srai_epi16(l, GRAD_SHIFT));
+    *grad_y = _mm256_sub_epi16(_mm256_srai_epi16(d, GRAD_SHIFT), _mm256_srai_epi16(u, GRAD_SHIFT));
+}
+
+/* Sum a column term over the 6 columns window of each 4x4 subblock
+ * Columns outside of the block are replaced by the block edge columns.
+ * Sums of subblocks 0, 1, 2, 3 are returned in 32 bits elements 0, 1, 4, 5
+ */
+static inline __m256i
+bdof_sb_sum_avx2(__m256i col_sum, __m256i edge_l, __m256i edge_r)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i sb_first = _mm256_setr_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+    const __m256i sb_last  = _mm256_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1);
+
+    __m256i lo_to_hi = _mm256_permute2x128_si256(col_sum, col_sum, 0x08);
+    __m256i hi_to_lo = _mm256_permute2x128_si256(col_sum, col_sum, 0x81);
+
+    /* Left and right neighbour columns */
+    __m256i left  = _mm256_alignr_epi8(col_sum, lo_to_hi, 14);
+    __m256i right = _mm256_alignr_epi8(hi_to_lo, col_sum, 2);
+    __m256i ext;
+    __m256i sum;
+
+    left  = _mm256_blendv_epi8(left,  col_sum, edge_l);
+    right = _mm256_blendv_epi8(right, col_sum, edge_r);
+
+    ext = _mm256_add_epi16(_mm256_and_si256(left,  sb_first),
+                           _mm256_and_si256(right, sb_last));
+
+    sum = _mm256_add_epi32(_mm256_madd_epi16(col_sum, one), _mm256_madd_epi16(ext, one));
+
+    return _mm256_hadd_epi32(sum, sum);
+}
+
+static inline int32_t
+bdof_weights(int sum_avg_x, int sum_avg_y, int sum_delta_x, int sum_delta_y,
+             int sum_avg_x_y_signs)
+{
+    int wgt_x = 0;
+    int wgt_y = 0;
+
+    if (sum_avg_x) {
+        int log2_renorm_x = floor_log2(sum_avg_x);
+
+        wgt_x = (sum_delta_x << 2) >> log2_renorm_x;
+        wgt_x = ov_clip(wgt_x, -BDOF_WGT_LIMIT, BDOF_WGT_LIMIT);
+    }
+
+    if (sum_avg_y) {
+        int log2_renorm_y = floor_log2(sum_avg_y);
+        int x_offset = 0;
+
+        if (wgt_x) {
+            int high = sum_avg_x_y_signs >> 12;
+            int low  = sum_avg_x_y_signs & ((1 << 12) - 1);
+            x_offset = (((wgt_x * high) << 12) + (wgt_x * low)) >> 1;
+        }
+
+        wgt_y = ((sum_delta_y << 2) - x_offset) >> log2_renorm_y;
+        wgt_y = ov_clip(wgt_y, -BDOF_WGT_LIMIT, BDOF_WGT_LIMIT);
+    }
+
+    /* Packed weights for multiply add on interleaved gradients */
+    return (uint16_t)wgt_x | ((uint32_t)(uint16_t)wgt_y << 16);
+}
+
+/* Derive weights of the 4x4 subblocks of the 4 lines starting at line y0
+ */
+static inline void
+bdof_band_weights_avx2(const int16_t *ref0, const int16_t *ref1, int ref_stride,
+                       int y0, int pb_h, __m256i edge_l, __m256i edge_r,
+                       int32_t *wgt)
+{
+    __m256i sum_avg_x   = _mm256_setzero_si256();
+    __m256i sum_avg_y   = _mm256_setzero_si256();
+    __m256i sum_delta_x = _mm256_setzero_si256();
+    __m256i sum_delta_y = _mm256_setzero_si256();
+    __m256i sum_avg_x_y_signs = _mm256_setzero_si256();
+
+    int32_t avg_x[8], avg_y[8], delta_x[8], delta_y[8], x_y_signs[8];
+    int y;
+
+    /* Lines outside of the block are replaced by the block edge lines */
+    for (y = y0 - 1; y <= y0 + SB_H; ++y) {
+        int y_clip = ov_clip(y, 0, pb_h - 1);
+        const int16_t *src0 = ref0 + y_clip * ref_stride;
+        const int16_t *src1 = ref1 + y_clip * ref_stride;
+        __m256i grad_x0, grad_y0, grad_x1, grad_y1;
+        __m256i avg_grad_x, avg_grad_y, delta_ref;
+
+        bdof_grad_line_avx2(src0, ref_stride, &grad_x0, &grad_y0);
+        bdof_grad_line_avx2(src1, ref_stride, &grad_x1, &grad_y1);
+
+        avg_grad_x = _mm256_srai_epi16(_mm256_add_epi16(grad_x0, grad_x1), 1);
+        avg_grad_y = _mm256_srai_epi16(_mm256_add_epi16(grad_y0, grad_y1), 1);
+
+        delta_ref = _mm256_sub_epi16(_mm256_srai_epi16(_mm256_loadu_si256((__m256i *)src1), 4),
+                                     _mm256_srai_epi16(_mm256_loadu_si256((__m256i *)src0), 4));
+
+        sum_avg_x   = _mm256_add_epi16(sum_avg_x, _mm256_abs_epi16(avg_grad_x));
+        sum_avg_y   = _mm256_add_epi16(sum_avg_y, _mm256_abs_epi16(avg_grad_y));
+        sum_delta_x = _mm256_add_epi16(sum_delta_x, _mm256_sign_epi16(delta_ref, avg_grad_x));
+        sum_delta_y = _mm256_add_epi16(sum_delta_y, _mm256_sign_epi16(delta_ref, avg_grad_y));
+        sum_avg_x_y_signs = _mm256_add_epi16(sum_avg_x_y_signs, _mm256_sign_epi16(avg_grad_x, avg_grad_y));
+    }
+
+    _mm256_storeu_si256((__m256i *)avg_x,     bdof_sb_sum_avx2(sum_avg_x,   edge_l, edge_r));
+    _mm256_storeu_si256((__m256i *)avg_y,     bdof_sb_sum_avx2(sum_avg_y,   edge_l, edge_r));
+    _mm256_storeu_si256((__m256i *)delta_x,   bdof_sb_sum_avx2(sum_delta_x, edge_l, edge_r));
+    _mm256_storeu_si256((__m256i *)delta_y,   bdof_sb_sum_avx2(sum_delta_y, edge_l, edge_r));
+    _mm256_storeu_si256((__m256i *)x_y_signs, bdof_sb_sum_avx2(sum_avg_x_y_signs, edge_l, edge_r));
+
+    wgt[0] = bdof_weights(avg_x[0], avg_y[0], delta_x[0], delta_y[0], x_y_signs[0]);
+    wgt[1] = bdof_weights(avg_x[1], avg_y[1], delta_x[1], delta_y[1], x_y_signs[1]);
+    wgt[2] = bdof_weights(avg_x[4], avg_y[4], delta_x[4], delta_y[4], x_y_signs[4]);
+    wgt[3] = bdof_weights(avg_x[5], avg_y[5], delta_x[5], delta_y[5], x_y_signs[5]);
+}
+
+/* BDOF offset added to the bi-prediction average of a 16 samples line
+ * Returns 16 bits samples before clipping
+ */
+static inline __m256i
+bdof_line_avx2(const int16_t *src0, const int16_t *src1, int ref_stride,
+               __m256i wgt_lo, __m256i wgt_hi, int shift)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i offset = _mm256_set1_epi32(1 << (shift - 1));
+    __m256i grad_x0, grad_y0, grad_x1, grad_y1;
+    __m256i ref0 = _mm256_loadu_si256((__m256i *)src0);
+    __m256i ref1 = _mm256_loadu_si256((__m256i *)src1);
+    __m256i d_grad_x, d_grad_y;
+    __m256i lo, hi;
+
+    bdof_grad_line_avx2(src0, ref_stride, &grad_x0, &grad_y0);
+    bdof_grad_line_avx2(src1, ref_stride, &grad_x1, &grad_y1);
+
+    d_grad_x = _mm256_sub_epi16(grad_x0, grad_x1);
+    d_grad_y = _mm256_sub_epi16(grad_y0, grad_y1);
+
+    lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(d_grad_x, d_grad_y), wgt_lo);
+    hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(d_grad_x, d_grad_y), wgt_hi);
+
+    lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(ref0, ref1), one));
+    hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(ref0, ref1), one));
+
+    lo = _mm256_srai_epi32(_mm256_add_epi32(lo, offset), shift);
+    hi = _mm256_srai_epi32(_mm256_add_epi32(hi, offset), shift);
+
+    return _mm256_packs_epi32(lo, hi);
+}
+
+/* BDOF on a whole 8 or 16 wide block computing gradients, weights and
+ * bi-prediction average line by line from the padded reference buffers
+ * without intermediate gradients buffers
+ */
+static inline void
+bdof_blk_avx2(void *dst, int dst_stride,
+              const int16_t *ref0, const int16_t *ref1, int ref_stride,
+              uint8_t pb_w, uint8_t pb_h, const int bitdepth)
+{
+    const int shift = 14 + 1 - bitdepth;
+    const __m256i idx = _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m256i edge_l = _mm256_cmpeq_epi16(idx, _mm256_setzero_si256());
+    const __m256i edge_r = _mm256_cmpeq_epi16(idx, _mm256_set1_epi16(pb_w - 1));
+    const __m256i max_val = _mm256_set1_epi16((1 << bitdepth) - 1);
+    int y0, y;
+
+    for (y0 = 0; y0 < pb_h; y0 += SB_H) {
+        int32_t wgt[4];
+        __m256i wgt_lo, wgt_hi;
+
+        bdof_band_weights_avx2(ref0, ref1, ref_stride, y0, pb_h, edge_l, edge_r, wgt);
+
+        /* Unpacked low and high halves hold subblocks 0, 2 and 1, 3 */
+        wgt_lo = _mm256_setr_epi32(wgt[0], wgt[0], wgt[0], wgt[0], wgt[2], wgt[2], wgt[2], wgt[2]);
+        wgt_hi = _mm256_setr_epi32(wgt[1], wgt[1], wgt[1], wgt[1], wgt[3], wgt[3], wgt[3], wgt[3]);
+
+        for (y = y0; y < y0 + SB_H; ++y) {
+            __m256i val = bdof_line_avx2(ref0 + y * ref_stride, ref1 + y * ref_stride,
+                                         ref_stride, wgt_lo, wgt_hi, shift);
+
+            if (bitdepth == 8) {
+                uint8_t *dst8 = (uint8_t *)dst + y * dst_stride;
+                __m128i val8 = _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi16(val, val), 0x08));
+                if (pb_w == 16) {
+                    _mm_storeu_si128((__m128i *)dst8, val8);
+                } else {
+                    _mm_storel_epi64((__m128i *)dst8, val8);
+                }
+            } else {
+                uint16_t *dst16 = (uint16_t *)dst + y * dst_stride;
+                val = _mm256_min_epi16(_mm256_max_epi16(val, _mm256_setzero_si256()), max_val);
+                if (pb_w == 16) {
+                    _mm256_storeu_si256((__m256i *)dst16, val);
+                } else {
+                    _mm_storeu_si128((__m128i *)dst16, _mm256_castsi256_si128(val));
+                }
+            }
+        }
+    }
+}
+
+static void
+rcn_bdof_blk_avx2(struct BDOFFunctions *const bdof, OVSample *dst, int dst_stride,
+                  int16_t *ref_bdof0, int16_t *ref_bdof1, int ref_stride,
+                  uint8_t pb_w, uint8_t pb_h)
+{
+    bdof_blk_avx2(dst, dst_stride, ref_bdof0, ref_bdof1, ref_stride, pb_w, pb_h, 10);
+}
+
+static void
+rcn_bdof_blk_8_avx2(struct BDOFFunctions *const bdof, OVSample *dst, int dst_stride,
+                    int16_t *ref_bdof0, int16_t *ref_bdof1, int ref_stride,
+                    uint8_t pb_w, uint8_t pb_h)
+{
+    bdof_blk_avx2((uint8_t *)dst, dst_stride, ref_bdof0, ref_bdof1, ref_stride, pb_w, pb_h, 8);
+}
 
 void
 rcn_init_prof_functions_avx2(struct RCNFunctions *const rcn_funcs)
@@ -171,4 +402,16 @@ void
 rcn_init_bdof_functions_avx2(struct RCNFunctions *const rcn_funcs)
 {
     rcn_funcs->bdof.grad = &compute_prof_grad_avx2;
+    rcn_funcs->bdof.rcn_bdof_blk = &rcn_bdof_blk_avx2;
+}
+
+/* Gradients only depend on the 14 bits intermediate precision and can be
+ * shared with 8 bits decoding. OVSample is 16 bits in this file so the
+ * 8 bits block function reinterprets its destination as 8 bits samples.
+ */
+void
+rcn_init_bdof_functions_8_avx2(struct RCNFunctions *const rcn_funcs)
+{
+    rcn_funcs->bdof.grad = &compute_prof_grad_avx2;
+    rcn_funcs->bdof.rcn_bdof_blk = &rcn_bdof_blk_8_avx2;
 }
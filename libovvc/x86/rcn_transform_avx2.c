@@ -0,0 +1,666 @@
+/**
+ *
+ *   OpenVVC is open-source real time software decoder compliant with the 
+ *   ITU-T H.266- MPEG-I - Part 3 VVC standard. OpenVVC is developed from 
+ *   scratch in C as a library that provides consumers with real time and
+ *   energy-aware decoding capabilities under different OS including MAC OS,
+ *   Windows, Linux and Android targeting low energy real-time decoding of
+ *   4K VVC videos on Intel x86 and ARM platforms.
+ * 
+ *   Copyright (C) 2020-2022  IETR-INSA Rennes :
+ *   
+ *   Pierre-Loup CABARAT
+ *   Wassim HAMIDOUCHE
+ *   Guillaume GAUTIER
+ *   Thomas AMESTOY
+ *
+ *   This library is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   This library is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *   USA
+ * 
+ **/
+
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "ovutils.h"
+#include "ovmem.h"
+#include "data_rcn_transform.h"
+#include "rcn_transform.h"
+#include "rcn_structures.h"
+#include "x86/rcn_avx2.h"
+
+/* Inverse transforms are computed as a product of the non zero part of
+ * the input columns by the transform matrix.
+ * Inputs are interleaved by pairs of coefficients (k, k + 1) so
+ * that _mm256_madd_epi16 accumulates two rows of the matrix at once.
+ * Only the num_columns first coefficients of each of the num_lines
+ * lines are read: rows beyond are known to be zero (last significant
+ * sub block, zero out of 64 and MTS transforms).
+ */
+
+#define MAX_TR_LINES 64
+#define MAX_TR_PAIRS 16
+
+#define CLIP_10 ((1 << 10) - 1)
+
+#define TR_SHIFT_V (6 + 1)
+#define TR_SHIFT_H ((6 + 15 - 1) - 10)
+
+/* Interleave rows (2 * kp) and (2 * kp + 1) of src into pairs
+ * of int16 for each line
+ */
+static void
+interleave_src(int32_t *pairs, const int16_t *src, ptrdiff_t src_stride,
+               int nb_pairs, int num_lines)
+{
+    int kp;
+
+    for (kp = 0; kp < nb_pairs; ++kp) {
+        const int16_t *row0 = src + 2 * kp * src_stride;
+        const int16_t *row1 = row0 + src_stride;
+        int32_t *dst = pairs + kp * MAX_TR_LINES;
+        int i;
+
+        for (i = 0; i + 8 <= num_lines; i += 8) {
+            __m128i r0 = _mm_loadu_si128((__m128i *)&row0[i]);
+            __m128i r1 = _mm_loadu_si128((__m128i *)&row1[i]);
+
+            _mm_storeu_si128((__m128i *)&dst[i    ], _mm_unpacklo_epi16(r0, r1));
+            _mm_storeu_si128((__m128i *)&dst[i + 4], _mm_unpackhi_epi16(r0, r1));
+        }
+
+        for (; i < num_lines; ++i) {
+            dst[i] = (uint16_t)row0[i] | ((uint32_t)(uint16_t)row1[i] << 16);
+        }
+    }
+}
+
+/* Interleave rows (2 * kp) and (2 * kp + 1) of a transform matrix
+ * on its nb_cols first columns.
+ * Each 16 columns give a low and a high vector matching the in lane
+ * behaviour of unpack and pack instructions.
+ */
+static inline void
+interleave_matrix(__m256i *coeffs, const int16_t *tr_mat, int row_stride,
+                  int nb_cols, int nb_pairs)
+{
+    int kp, j;
+
+    for (kp = 0; kp < nb_pairs; ++kp) {
+        const int16_t *row0 = tr_mat + 2 * kp * row_stride;
+        const int16_t *row1 = row0 + row_stride;
+
+        for (j = 0; j < nb_cols; j += 16) {
+            __m256i r0 = _mm256_loadu_si256((__m256i *)&row0[j]);
+            __m256i r1 = _mm256_loadu_si256((__m256i *)&row1[j]);
+
+            *coeffs++ = _mm256_unpacklo_epi16(r0, r1);
+            *coeffs++ = _mm256_unpackhi_epi16(r0, r1);
+        }
+    }
+}
+
+static inline __m256i
+round_pack(__m256i lo, __m256i hi, __m256i add, int shift)
+{
+    lo = _mm256_srai_epi32(_mm256_add_epi32(lo, add), shift);
+    hi = _mm256_srai_epi32(_mm256_add_epi32(hi, add), shift);
+
+    /* Saturation is equivalent to clipping to int16 range */
+    return _mm256_packs_epi32(lo, hi);
+}
+
+/* Store a vector of int16 residuals or add it to the reconstruction
+ * buffer with clipping to sample range
+ */
+static inline void
+store_or_add_16(int16_t *dst, uint16_t *px, __m256i out, const int add_px)
+{
+    if (add_px) {
+        __m256i d = _mm256_loadu_si256((__m256i *)px);
+
+        d = _mm256_adds_epi16(d, out);
+        d = _mm256_max_epi16(d, _mm256_setzero_si256());
+        d = _mm256_min_epi16(d, _mm256_set1_epi16(CLIP_10));
+
+        _mm256_storeu_si256((__m256i *)px, d);
+    } else {
+        _mm256_storeu_si256((__m256i *)dst, out);
+    }
+}
+
+static inline void
+load_tr_8_coeffs(__m256i (*coeffs)[2], const int16_t *tr_mat, int nb_pairs)
+{
+    int kp;
+
+    for (kp = 0; kp < nb_pairs; ++kp) {
+        __m128i r0 = _mm_loadu_si128((__m128i *)&tr_mat[(2 * kp    ) * 8]);
+        __m128i r1 = _mm_loadu_si128((__m128i *)&tr_mat[(2 * kp + 1) * 8]);
+        coeffs[kp][0] = _mm256_broadcastsi128_si256(_mm_unpacklo_epi16(r0, r1));
+        coeffs[kp][1] = _mm256_broadcastsi128_si256(_mm_unpackhi_epi16(r0, r1));
+    }
+}
+
+/* Two lines per vector, one per lane */
+static inline __attribute__((always_inline)) void
+tr_8_lines(const int32_t *pairs, __m256i (*coeffs)[2], int nb_pairs,
+           int16_t *dst, uint16_t *px, ptrdiff_t px_stride,
+           int num_lines, int shift, const int add_px)
+{
+    const __m256i add = _mm256_set1_epi32(1 << (shift - 1));
+    const __m256i lane_idx = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    int kp, i;
+
+    for (i = 0; i < num_lines; i += 2) {
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        __m256i out;
+
+        for (kp = 0; kp < nb_pairs; ++kp) {
+            const int32_t *p = &pairs[kp * MAX_TR_LINES + i];
+            __m256i x = _mm256_castsi128_si256(_mm_loadl_epi64((__m128i *)p));
+
+            x = _mm256_permutevar8x32_epi32(x, lane_idx);
+
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(x, coeffs[kp][0]));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(x, coeffs[kp][1]));
+        }
+
+        out = round_pack(acc0, acc1, add, shift);
+
+        if (add_px) {
+            uint16_t *px0 = px + i * px_stride;
+            __m256i d = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)px0));
+
+            d = _mm256_inserti128_si256(d, _mm_loadu_si128((__m128i *)(px0 + px_stride)), 1);
+            d = _mm256_adds_epi16(d, out);
+            d = _mm256_max_epi16(d, _mm256_setzero_si256());
+            d = _mm256_min_epi16(d, _mm256_set1_epi16(CLIP_10));
+
+            _mm_storeu_si128((__m128i *)px0, _mm256_castsi256_si128(d));
+            _mm_storeu_si128((__m128i *)(px0 + px_stride), _mm256_extracti128_si256(d, 1));
+        } else if (num_lines - i >= 2) {
+            _mm256_storeu_si256((__m256i *)&dst[i * 8], out);
+        } else {
+            _mm_storeu_si128((__m128i *)&dst[i * 8], _mm256_castsi256_si128(out));
+        }
+    }
+}
+
+static inline void
+inverse_tr_8(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+             const int16_t *tr_mat, int num_lines, int num_columns, int shift)
+{
+    int nb_pairs = (OVMIN(num_columns, 8) + 1) >> 1;
+    DECLARE_ALIGNED(32, int32_t, pairs)[4 * MAX_TR_LINES];
+    __m256i coeffs[4][2];
+
+    interleave_src(pairs, src, src_stride, nb_pairs, num_lines);
+    load_tr_8_coeffs(coeffs, tr_mat, nb_pairs);
+
+    tr_8_lines(pairs, coeffs, nb_pairs, dst, NULL, 0, num_lines, shift, 0);
+}
+
+/* One line per iteration, 16 outputs per pair of vectors */
+static inline __attribute__((always_inline)) void
+tr_n_lines(const int32_t *pairs, const __m256i *coeffs, int nb_pairs,
+           int16_t *dst, uint16_t *px, ptrdiff_t px_stride,
+           int num_lines, int shift, const int tr_size, const int add_px)
+{
+    const __m256i add = _mm256_set1_epi32(1 << (shift - 1));
+    const int nb_vec = tr_size >> 3;
+    int kp, i;
+
+    for (i = 0; i < num_lines; ++i) {
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        __m256i acc2 = _mm256_setzero_si256();
+        __m256i acc3 = _mm256_setzero_si256();
+
+        for (kp = 0; kp < nb_pairs; ++kp) {
+            __m256i x = _mm256_set1_epi32(pairs[kp * MAX_TR_LINES + i]);
+            const __m256i *c = &coeffs[kp * nb_vec];
+
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(x, c[0]));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(x, c[1]));
+            if (tr_size > 16) {
+                acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(x, c[2]));
+                acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(x, c[3]));
+            }
+        }
+
+        store_or_add_16(&dst[0], &px[0], round_pack(acc0, acc1, add, shift), add_px);
+        if (tr_size > 16) {
+            store_or_add_16(&dst[16], &px[16], round_pack(acc2, acc3, add, shift), add_px);
+        }
+
+        dst += tr_size;
+        px  += px_stride;
+    }
+}
+
+static inline __attribute__((always_inline)) void
+inverse_tr_n(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+             const int16_t *tr_mat, int num_lines, int num_columns, int shift,
+             const int tr_size)
+{
+    int nb_pairs = (OVMIN(num_columns, tr_size) + 1) >> 1;
+    DECLARE_ALIGNED(32, int32_t, pairs)[MAX_TR_PAIRS * MAX_TR_LINES];
+    __m256i coeffs[MAX_TR_PAIRS * 4];
+
+    interleave_src(pairs, src, src_stride, nb_pairs, num_lines);
+    interleave_matrix(coeffs, tr_mat, tr_size, tr_size, nb_pairs);
+
+    tr_n_lines(pairs, coeffs, nb_pairs, dst, NULL, 0, num_lines, shift, tr_size, 0);
+}
+
+static inline __m256i
+reverse_epi16(__m256i x)
+{
+    const __m256i rev = _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9,
+                                         6, 7, 4, 5, 2, 3, 0, 1,
+                                         14, 15, 12, 13, 10, 11, 8, 9,
+                                         6, 7, 4, 5, 2, 3, 0, 1);
+
+    x = _mm256_shuffle_epi8(x, rev);
+
+    return _mm256_permute4x64_epi64(x, 0x4E);
+}
+
+/* DCT II split into even and odd parts.
+ * Even inputs are transformed by the half size DCT II matrix and odd
+ * inputs by the first half of the odd basis functions, the second half
+ * of the outputs is then reconstructed from their symmetry.
+ */
+static inline __attribute__((always_inline)) void
+eo_lines(const int32_t *pairs_e, const int32_t *pairs_o,
+         const __m256i *coeffs_e, const __m256i *coeffs_o,
+         int nb_pairs_e, int nb_pairs_o,
+         int16_t *dst, uint16_t *px, ptrdiff_t px_stride,
+         int num_lines, int shift, const int tr_size, const int add_px)
+{
+    const __m256i add = _mm256_set1_epi32(1 << (shift - 1));
+    const int nb_vec = tr_size >> 4;
+    int kp, i;
+
+    for (i = 0; i < num_lines; ++i) {
+        __m256i e0 = _mm256_setzero_si256();
+        __m256i e1 = _mm256_setzero_si256();
+        __m256i e2 = _mm256_setzero_si256();
+        __m256i e3 = _mm256_setzero_si256();
+        __m256i o0 = _mm256_setzero_si256();
+        __m256i o1 = _mm256_setzero_si256();
+        __m256i o2 = _mm256_setzero_si256();
+        __m256i o3 = _mm256_setzero_si256();
+        __m256i out;
+
+        for (kp = 0; kp < nb_pairs_e; ++kp) {
+            __m256i x = _mm256_set1_epi32(pairs_e[kp * MAX_TR_LINES + i]);
+            const __m256i *c = &coeffs_e[kp * nb_vec];
+
+            e0 = _mm256_add_epi32(e0, _mm256_madd_epi16(x, c[0]));
+            e1 = _mm256_add_epi32(e1, _mm256_madd_epi16(x, c[1]));
+            if (tr_size > 32) {
+                e2 = _mm256_add_epi32(e2, _mm256_madd_epi16(x, c[2]));
+                e3 = _mm256_add_epi32(e3, _mm256_madd_epi16(x, c[3]));
+            }
+        }
+
+        for (kp = 0; kp < nb_pairs_o; ++kp) {
+            __m256i x = _mm256_set1_epi32(pairs_o[kp * MAX_TR_LINES + i]);
+            const __m256i *c = &coeffs_o[kp * nb_vec];
+
+            o0 = _mm256_add_epi32(o0, _mm256_madd_epi16(x, c[0]));
+            o1 = _mm256_add_epi32(o1, _mm256_madd_epi16(x, c[1]));
+            if (tr_size > 32) {
+                o2 = _mm256_add_epi32(o2, _mm256_madd_epi16(x, c[2]));
+                o3 = _mm256_add_epi32(o3, _mm256_madd_epi16(x, c[3]));
+            }
+        }
+
+        out = round_pack(_mm256_add_epi32(e0, o0), _mm256_add_epi32(e1, o1), add, shift);
+        store_or_add_16(&dst[0], &px[0], out, add_px);
+
+        out = round_pack(_mm256_sub_epi32(e0, o0), _mm256_sub_epi32(e1, o1), add, shift);
+        store_or_add_16(&dst[tr_size - 16], &px[tr_size - 16], reverse_epi16(out), add_px);
+
+        if (tr_size > 32) {
+            out = round_pack(_mm256_add_epi32(e2, o2), _mm256_add_epi32(e3, o3), add, shift);
+            store_or_add_16(&dst[16], &px[16], out, add_px);
+
+            out = round_pack(_mm256_sub_epi32(e2, o2), _mm256_sub_epi32(e3, o3), add, shift);
+            store_or_add_16(&dst[tr_size - 32], &px[tr_size - 32], reverse_epi16(out), add_px);
+        }
+
+        dst += tr_size;
+        px  += px_stride;
+    }
+}
+
+static inline __attribute__((always_inline)) void
+inverse_dct_ii_eo(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                  const int16_t *even_mat, const int16_t *odd_mat, int odd_stride,
+                  int num_lines, int num_columns, int shift, const int tr_size)
+{
+    const int half = tr_size >> 1;
+    int nb_cols = OVMIN(num_columns, OVMIN(tr_size, 32));
+    int nb_pairs_e = (nb_cols + 3) >> 2;
+    int nb_pairs_o = (nb_cols + 2) >> 2;
+    DECLARE_ALIGNED(32, int32_t, pairs_e)[8 * MAX_TR_LINES];
+    DECLARE_ALIGNED(32, int32_t, pairs_o)[8 * MAX_TR_LINES];
+    __m256i coeffs_e[8 * 4];
+    __m256i coeffs_o[8 * 4];
+
+    interleave_src(pairs_e, src             , src_stride << 1, nb_pairs_e, num_lines);
+    interleave_src(pairs_o, src + src_stride, src_stride << 1, nb_pairs_o, num_lines);
+
+    interleave_matrix(coeffs_e, even_mat, half, half, nb_pairs_e);
+    interleave_matrix(coeffs_o, odd_mat, odd_stride, half, nb_pairs_o);
+
+    eo_lines(pairs_e, pairs_o, coeffs_e, coeffs_o, nb_pairs_e, nb_pairs_o,
+             dst, NULL, 0, num_lines, shift, tr_size, 0);
+}
+
+static void
+inverse_dct_ii_8_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                      int num_lines, int num_columns, int shift)
+{
+    inverse_tr_8(src, dst, src_stride, DCT_II_8, num_lines, num_columns, shift);
+}
+
+static void
+inverse_dct_ii_16_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                       int num_lines, int num_columns, int shift)
+{
+    inverse_tr_n(src, dst, src_stride, DCT_II_16, num_lines, num_columns, shift, 16);
+}
+
+static void
+inverse_dct_ii_32_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                       int num_lines, int num_columns, int shift)
+{
+    inverse_dct_ii_eo(src, dst, src_stride, DCT_II_16, DCT_II_32 + 32, 64,
+                      num_lines, num_columns, shift, 32);
+}
+
+/* Only the 32 first coefficients of a 64 DCT II can be non zero */
+static void
+inverse_dct_ii_64_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                       int num_lines, int num_columns, int shift)
+{
+    inverse_dct_ii_eo(src, dst, src_stride, DCT_II_32, DCT_II_64_O, 32,
+                      num_lines, num_columns, shift, 64);
+}
+
+static void
+inverse_dst_vii_8_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                       int num_lines, int num_columns, int shift)
+{
+    inverse_tr_8(src, dst, src_stride, DST_VII_8, num_lines, num_columns, shift);
+}
+
+static void
+inverse_dst_vii_16_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                        int num_lines, int num_columns, int shift)
+{
+    inverse_tr_n(src, dst, src_stride, DST_VII_16, num_lines, num_columns, shift, 16);
+}
+
+static void
+inverse_dst_vii_32_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                        int num_lines, int num_columns, int shift)
+{
+    inverse_tr_n(src, dst, src_stride, DST_VII_32, num_lines, num_columns, shift, 32);
+}
+
+static void
+inverse_dct_viii_8_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                        int num_lines, int num_columns, int shift)
+{
+    inverse_tr_8(src, dst, src_stride, DCT_VIII_8, num_lines, num_columns, shift);
+}
+
+static void
+inverse_dct_viii_16_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                         int num_lines, int num_columns, int shift)
+{
+    inverse_tr_n(src, dst, src_stride, DCT_VIII_16, num_lines, num_columns, shift, 16);
+}
+
+static void
+inverse_dct_viii_32_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                         int num_lines, int num_columns, int shift)
+{
+    inverse_tr_n(src, dst, src_stride, DCT_VIII_32, num_lines, num_columns, shift, 32);
+}
+
+/* Fused dequantization, DCT II and residual add on square TBs.
+ * Coefficients are read in their 4x4 sub block order and dequantized
+ * straight into the interleaved pairs used by the vertical pass, the
+ * horizontal pass adds its output to the reconstruction buffer.
+ */
+static inline __m256i
+dequant_sb_4x4(const int16_t *src, __m256i scale, __m256i add, __m128i shift)
+{
+    __m256i c  = _mm256_loadu_si256((__m256i *)src);
+    __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(c));
+    __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(c, 1));
+
+    lo = _mm256_sra_epi32(_mm256_add_epi32(_mm256_mullo_epi32(lo, scale), add), shift);
+    hi = _mm256_sra_epi32(_mm256_add_epi32(_mm256_mullo_epi32(hi, scale), add), shift);
+
+    /* Saturate to [-32768, 32767] and restore raster order */
+    c = _mm256_packs_epi32(lo, hi);
+
+    return _mm256_permute4x64_epi64(c, 0xD8);
+}
+
+/* Dequantize the nb_sb_h x nb_sb_w top left sub blocks into pairs of
+ * rows (4 * sb_y + r, 4 * sb_y + r + step) where step is 1 for a plain
+ * matrix product and 2 for the even / odd split.
+ */
+static inline __attribute__((always_inline)) void
+dequant_pairs(int32_t *pairs_0, int32_t *pairs_1, const int16_t *src,
+              uint64_t sig_sb_map, int scale, int shift,
+              int log2_tb_s, int nb_sb_w, int nb_sb_h, const int eo)
+{
+    const __m256i v_scale = _mm256_set1_epi32(scale);
+    const __m256i v_add   = _mm256_set1_epi32((1 << shift) >> 1);
+    const __m128i v_shift = _mm_cvtsi32_si128(shift);
+    int sb_x, sb_y;
+
+    for (sb_y = 0; sb_y < nb_sb_h; ++sb_y) {
+        uint8_t sig_sb_row = sig_sb_map >> (sb_y << 3);
+        const int16_t *sb_src = src + ((sb_y << (log2_tb_s - 2)) << 4);
+        int32_t *dst_0 = eo ? pairs_0 + sb_y * MAX_TR_LINES : pairs_0 + 2 * sb_y * MAX_TR_LINES;
+        int32_t *dst_1 = eo ? pairs_1 + sb_y * MAX_TR_LINES : dst_0 + MAX_TR_LINES;
+
+        for (sb_x = 0; sb_x < nb_sb_w; ++sb_x) {
+            __m256i v = _mm256_setzero_si256();
+
+            if (sig_sb_row & 0x1) {
+                v = dequant_sb_4x4(sb_src + (sb_x << 4), v_scale, v_add, v_shift);
+            }
+
+            if (eo) {
+                v = _mm256_permute4x64_epi64(v, 0xD8);
+            }
+
+            v = _mm256_unpacklo_epi16(v, _mm256_srli_si256(v, 8));
+
+            _mm_storeu_si128((__m128i *)&dst_0[sb_x << 2], _mm256_castsi256_si128(v));
+            _mm_storeu_si128((__m128i *)&dst_1[sb_x << 2], _mm256_extracti128_si256(v, 1));
+
+            sig_sb_row >>= 1;
+        }
+    }
+}
+
+static inline __m256i
+tr_4x4_pass(__m256i v, __m256i c01, __m256i c23, __m256i add, int shift)
+{
+    const __m256i idx_01 = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const __m256i idx_23 = _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3);
+    __m128i r01 = _mm256_castsi256_si128(v);
+    __m128i r23 = _mm256_extracti128_si256(v, 1);
+    __m256i p01 = _mm256_castsi128_si256(_mm_unpacklo_epi16(r01, _mm_srli_si128(r01, 8)));
+    __m256i p23 = _mm256_castsi128_si256(_mm_unpacklo_epi16(r23, _mm_srli_si128(r23, 8)));
+    __m256i acc0, acc1;
+
+    acc0 = _mm256_add_epi32(_mm256_madd_epi16(_mm256_permutevar8x32_epi32(p01, idx_01), c01),
+                            _mm256_madd_epi16(_mm256_permutevar8x32_epi32(p23, idx_01), c23));
+
+    acc1 = _mm256_add_epi32(_mm256_madd_epi16(_mm256_permutevar8x32_epi32(p01, idx_23), c01),
+                            _mm256_madd_epi16(_mm256_permutevar8x32_epi32(p23, idx_23), c23));
+
+    return _mm256_permute4x64_epi64(round_pack(acc0, acc1, add, shift), 0xD8);
+}
+
+static void
+dct_ii_add_4x4_avx2(const int16_t *src, uint16_t *dst, ptrdiff_t dst_stride,
+                    uint64_t sig_sb_map, int scale, int shift,
+                    int num_lines, int num_columns)
+{
+    const __m256i v_scale = _mm256_set1_epi32(scale);
+    const __m256i v_add   = _mm256_set1_epi32((1 << shift) >> 1);
+    const __m128i v_shift = _mm_cvtsi32_si128(shift);
+    __m128i r0 = _mm_loadl_epi64((__m128i *)&DCT_II_4[0]);
+    __m128i r1 = _mm_loadl_epi64((__m128i *)&DCT_II_4[4]);
+    __m128i r2 = _mm_loadl_epi64((__m128i *)&DCT_II_4[8]);
+    __m128i r3 = _mm_loadl_epi64((__m128i *)&DCT_II_4[12]);
+    __m256i c01 = _mm256_broadcastsi128_si256(_mm_unpacklo_epi16(r0, r1));
+    __m256i c23 = _mm256_broadcastsi128_si256(_mm_unpacklo_epi16(r2, r3));
+    __m256i v, d;
+
+    v = dequant_sb_4x4(src, v_scale, v_add, v_shift);
+
+    v = tr_4x4_pass(v, c01, c23, _mm256_set1_epi32(1 << (TR_SHIFT_V - 1)), TR_SHIFT_V);
+    v = tr_4x4_pass(v, c01, c23, _mm256_set1_epi32(1 << (TR_SHIFT_H - 1)), TR_SHIFT_H);
+
+    d = _mm256_castsi128_si256(_mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)&dst[0 * dst_stride]),
+                                                  _mm_loadl_epi64((__m128i *)&dst[1 * dst_stride])));
+    d = _mm256_inserti128_si256(d, _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)&dst[2 * dst_stride]),
+                                                      _mm_loadl_epi64((__m128i *)&dst[3 * dst_stride])), 1);
+
+    d = _mm256_adds_epi16(d, v);
+    d = _mm256_max_epi16(d, _mm256_setzero_si256());
+    d = _mm256_min_epi16(d, _mm256_set1_epi16(CLIP_10));
+
+    _mm_storel_epi64((__m128i *)&dst[0 * dst_stride], _mm256_castsi256_si128(d));
+    _mm_storeh_pd((double *)&dst[1 * dst_stride], _mm_castsi128_pd(_mm256_castsi256_si128(d)));
+    _mm_storel_epi64((__m128i *)&dst[2 * dst_stride], _mm256_extracti128_si256(d, 1));
+    _mm_storeh_pd((double *)&dst[3 * dst_stride], _mm_castsi128_pd(_mm256_extracti128_si256(d, 1)));
+}
+
+static void
+dct_ii_add_8x8_avx2(const int16_t *src, uint16_t *dst, ptrdiff_t dst_stride,
+                    uint64_t sig_sb_map, int scale, int shift,
+                    int num_lines, int num_columns)
+{
+    int nb_pairs_v = num_columns >> 1;
+    int nb_pairs_h = (num_lines + 1) >> 1;
+    DECLARE_ALIGNED(32, int32_t, pairs)[4 * MAX_TR_LINES];
+    DECLARE_ALIGNED(32, int16_t, tmp)[8 * 8];
+    __m256i coeffs[4][2];
+
+    dequant_pairs(pairs, NULL, src, sig_sb_map, scale, shift, 3,
+                  (num_lines + 3) >> 2, num_columns >> 2, 0);
+
+    load_tr_8_coeffs(coeffs, DCT_II_8, 4);
+
+    tr_8_lines(pairs, coeffs, nb_pairs_v, tmp, NULL, 0, num_lines, TR_SHIFT_V, 0);
+
+    interleave_src(pairs, tmp, 8, nb_pairs_h, 8);
+
+    tr_8_lines(pairs, coeffs, nb_pairs_h, NULL, dst, dst_stride, 8, TR_SHIFT_H, 1);
+}
+
+static void
+dct_ii_add_16x16_avx2(const int16_t *src, uint16_t *dst, ptrdiff_t dst_stride,
+                      uint64_t sig_sb_map, int scale, int shift,
+                      int num_lines, int num_columns)
+{
+    int nb_pairs_v = num_columns >> 1;
+    int nb_pairs_h = (num_lines + 1) >> 1;
+    DECLARE_ALIGNED(32, int32_t, pairs)[8 * MAX_TR_LINES];
+    DECLARE_ALIGNED(32, int16_t, tmp)[16 * 16];
+    __m256i coeffs[8 * 2];
+
+    dequant_pairs(pairs, NULL, src, sig_sb_map, scale, shift, 4,
+                  (num_lines + 3) >> 2, num_columns >> 2, 0);
+
+    interleave_matrix(coeffs, DCT_II_16, 16, 16, 8);
+
+    tr_n_lines(pairs, coeffs, nb_pairs_v, tmp, NULL, 0, num_lines, TR_SHIFT_V, 16, 0);
+
+    interleave_src(pairs, tmp, 16, nb_pairs_h, 16);
+
+    tr_n_lines(pairs, coeffs, nb_pairs_h, NULL, dst, dst_stride, 16, TR_SHIFT_H, 16, 1);
+}
+
+static void
+dct_ii_add_32x32_avx2(const int16_t *src, uint16_t *dst, ptrdiff_t dst_stride,
+                      uint64_t sig_sb_map, int scale, int shift,
+                      int num_lines, int num_columns)
+{
+    int nb_pairs_v = num_columns >> 2;
+    int nb_pairs_e = (num_lines + 3) >> 2;
+    int nb_pairs_o = (num_lines + 2) >> 2;
+    DECLARE_ALIGNED(32, int32_t, pairs_e)[8 * MAX_TR_LINES];
+    DECLARE_ALIGNED(32, int32_t, pairs_o)[8 * MAX_TR_LINES];
+    DECLARE_ALIGNED(32, int16_t, tmp)[32 * 32];
+    __m256i coeffs_e[8 * 2];
+    __m256i coeffs_o[8 * 2];
+
+    dequant_pairs(pairs_e, pairs_o, src, sig_sb_map, scale, shift, 5,
+                  (num_lines + 3) >> 2, num_columns >> 2, 1);
+
+    interleave_matrix(coeffs_e, DCT_II_16, 16, 16, 8);
+    interleave_matrix(coeffs_o, DCT_II_32 + 32, 64, 16, 8);
+
+    eo_lines(pairs_e, pairs_o, coeffs_e, coeffs_o, nb_pairs_v, nb_pairs_v,
+             tmp, NULL, 0, num_lines, TR_SHIFT_V, 32, 0);
+
+    interleave_src(pairs_e, tmp     , 64, nb_pairs_e, 32);
+    interleave_src(pairs_o, tmp + 32, 64, nb_pairs_o, 32);
+
+    eo_lines(pairs_e, pairs_o, coeffs_e, coeffs_o, nb_pairs_e, nb_pairs_o,
+             NULL, dst, dst_stride, 32, TR_SHIFT_H, 32, 1);
+}
+
+void
+rcn_init_tr_functions_avx2(struct RCNFunctions *const rcn_funcs)
+{
+    rcn_funcs->tr.func[DST_VII][3] = &inverse_dst_vii_8_avx2;
+    rcn_funcs->tr.func[DST_VII][4] = &inverse_dst_vii_16_avx2;
+    rcn_funcs->tr.func[DST_VII][5] = &inverse_dst_vii_32_avx2;
+
+    rcn_funcs->tr.func[DCT_VIII][3] = &inverse_dct_viii_8_avx2;
+    rcn_funcs->tr.func[DCT_VIII][4] = &inverse_dct_viii_16_avx2;
+    rcn_funcs->tr.func[DCT_VIII][5] = &inverse_dct_viii_32_avx2;
+
+    rcn_funcs->tr.func[DCT_II][3] = &inverse_dct_ii_8_avx2;
+    rcn_funcs->tr.func[DCT_II][4] = &inverse_dct_ii_16_avx2;
+    rcn_funcs->tr.func[DCT_II][5] = &inverse_dct_ii_32_avx2;
+    rcn_funcs->tr.func[DCT_II][6] = &inverse_dct_ii_64_avx2;
+
+    rcn_funcs->tr.dct_ii_add[2] = &dct_ii_add_4x4_avx2;
+    rcn_funcs->tr.dct_ii_add[3] = &dct_ii_add_8x8_avx2;
+    rcn_funcs->tr.dct_ii_add[4] = &dct_ii_add_16x16_avx2;
+    rcn_funcs->tr.dct_ii_add[5] = &dct_ii_add_32x32_avx2;
+}